@@ -0,0 +1,77 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include "bmstu_list.h"
+
+// Узлы списка из malloc против собственного пула списка (bmstu::node_pool).
+// Churn: очередь постоянного размера, на каждом шаге удаляется голова и
+// добавляется хвост. Traversal: два списка заполняются вперемешку, как
+// бывает, когда в программе живёт несколько контейнеров; из malloc их узлы
+// чередуются в памяти, из пула каждый список занимает свои блоки.
+
+template <typename List>
+static void BM_Churn(benchmark::State& state)
+{
+	const auto count = static_cast<int>(state.range(0));
+	List list;
+	for (int i = 0; i < count; ++i)
+	{
+		list.push_back(i);
+	}
+	int next = count;
+	for (auto _ : state)
+	{
+		for (int i = 0; i < 1024; ++i)
+		{
+			list.pop_front();
+			list.push_back(next++);
+		}
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * 1024);
+}
+
+template <typename List>
+static void BM_Fill(benchmark::State& state)
+{
+	const auto count = static_cast<int>(state.range(0));
+	for (auto _ : state)
+	{
+		List list;
+		for (int i = 0; i < count; ++i)
+		{
+			list.push_back(i);
+		}
+		benchmark::DoNotOptimize(list.size());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename List>
+static void BM_Traversal(benchmark::State& state)
+{
+	const auto count = static_cast<int>(state.range(0));
+	List list;
+	List other;
+	for (int i = 0; i < count; ++i)
+	{
+		list.push_back(i);
+		other.push_back(i);
+	}
+	for (auto _ : state)
+	{
+		std::int64_t sum = 0;
+		for (int value : list)
+		{
+			sum += value;
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_Churn<bmstu::list<int>>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_Churn<bmstu::pooled::list<int>>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_Fill<bmstu::list<int>>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_Fill<bmstu::pooled::list<int>>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_Traversal<bmstu::list<int>>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_Traversal<bmstu::pooled::list<int>>)->Range(1 << 10, 1 << 20);
@@ -1,44 +1,96 @@
+#pragma once
+
+#include <compare>
 #include <cstddef>
+#include <initializer_list>
 #include <iterator>
+#include <memory>
+#include <memory_resource>
 #include <ostream>
+#include <stdexcept>
+#include <utility>
 #include "abstract_iterator.h"
+#include "bmstu_node_pool.h"
 
 namespace bmstu
 {
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class list
 {
-	struct node
+	// Граничные узлы head_ и tail_ не хранят значения и живут в самом
+	// списке, поэтому T не обязан иметь конструктор по умолчанию, а
+	// пустой список не выделяет память.
+	struct node_base
 	{
-		node() = default;
+		node_base* next_node_ = nullptr;
+		node_base* prev_node_ = nullptr;
+	};
 
-		node(node* prev, const T& value, node* next)
-			: next_node_(nullptr), prev_node_(nullptr)
+	// значение создаётся аллокатором списка (uses-allocator), чтобы
+	// элементы std::pmr попадали в тот же ресурс, что и узлы
+	struct node : node_base
+	{
+		template <typename... Args>
+		explicit node(std::allocator_arg_t,
+					  const Allocator& alloc,
+					  Args&&... args)
+			: value_(std::make_obj_using_allocator<T>(
+				  alloc, std::forward<Args>(args)...))
 		{
 		}
 
 		T value_;
-		node* next_node_ = nullptr;
-		node* prev_node_ = nullptr;
 	};
 
+	using node_allocator =
+		typename std::allocator_traits<Allocator>::template rebind_alloc<node>;
+	using node_traits = std::allocator_traits<node_allocator>;
+
    public:
+	using allocator_type = Allocator;
+
 	struct iterator
 		: public abstract_iterator<iterator, T, std::bidirectional_iterator_tag>
 	{
-		node* current;
+		node_base* current;
 		iterator() : current(nullptr) {}
-		iterator(node* node) : current(node) {}
-		iterator& operator++() override { return *this; }
-		iterator& operator--() override { return *this; }
-		iterator operator++(int) override { return nullptr; }
-		iterator operator--(int) override { return nullptr; }
+		iterator(node_base* node) : current(node) {}
+		iterator& operator++() override
+		{
+			current = current->next_node_;
+			return *this;
+		}
+		iterator& operator--() override
+		{
+			current = current->prev_node_;
+			return *this;
+		}
+		iterator operator++(int) override
+		{
+			iterator copy(*this);
+			++(*this);
+			return copy;
+		}
+		iterator operator--(int) override
+		{
+			iterator copy(*this);
+			--(*this);
+			return copy;
+		}
 		iterator& operator+=(
 			const typename abstract_iterator<
 				iterator,
 				T,
 				std::bidirectional_iterator_tag>::difference_type& n) override
 		{
+			if (n < 0)
+			{
+				return *this -= -n;
+			}
+			for (auto i = n; i > 0; --i)
+			{
+				++(*this);
+			}
 			return *this;
 		}
 		iterator& operator-=(
@@ -47,6 +99,14 @@ class list
 				T,
 				std::bidirectional_iterator_tag>::difference_type& n) override
 		{
+			if (n < 0)
+			{
+				return *this += -n;
+			}
+			for (auto i = n; i > 0; --i)
+			{
+				--(*this);
+			}
 			return *this;
 		}
 		iterator operator+(const typename abstract_iterator<
@@ -55,7 +115,8 @@ class list
 						   std::bidirectional_iterator_tag>::difference_type& n)
 			const override
 		{
-			return nullptr;
+			iterator copy(*this);
+			return copy += n;
 		}
 		iterator operator-(const typename abstract_iterator<
 						   iterator,
@@ -63,21 +124,22 @@ class list
 						   std::bidirectional_iterator_tag>::difference_type& n)
 			const override
 		{
-			return nullptr;
+			iterator copy(*this);
+			return copy -= n;
 		}
 		typename abstract_iterator<iterator,
 								   T,
 								   std::bidirectional_iterator_tag>::reference
 		operator*() const override
 		{
-			return current->value_;
+			return static_cast<node*>(current)->value_;
 		}
 		typename abstract_iterator<iterator,
 								   T,
 								   std::bidirectional_iterator_tag>::pointer
 		operator->() const override
 		{
-			return &(current->value_);
+			return &(static_cast<node*>(current)->value_);
 		}
 		bool operator==(const iterator& other) const override
 		{
@@ -88,29 +150,117 @@ class list
 			return current != other.current;
 		}
 		explicit operator bool() const override { return current != nullptr; }
+		// расстояние от other до this; other должен быть не правее this
 		typename abstract_iterator<
 			iterator,
 			T,
 			std::bidirectional_iterator_tag>::difference_type
 		operator-(const iterator& other) const override
 		{
-			return 0;
+			typename iterator::difference_type distance = 0;
+			for (node_base* it = other.current; it != current;
+				 it = it->next_node_)
+			{
+				++distance;
+			}
+			return distance;
 		}
 	};
 	using const_iterator = iterator;
 
-	list() {}
+	list() noexcept(noexcept(Allocator())) : list(Allocator()) {}
+
+	explicit list(const Allocator& alloc) noexcept : alloc_(alloc)
+	{
+		link_empty_();
+	}
 
 	template <typename it>
-	list(it begin, it end)
+	list(it begin, it end, const Allocator& alloc = Allocator()) : list(alloc)
+	{
+		for (; begin != end; ++begin)
+		{
+			push_back(*begin);
+		}
+	}
+
+	list(std::initializer_list<T> values, const Allocator& alloc = Allocator())
+		: list(values.begin(), values.end(), alloc)
+	{
+	}
+
+	list(const list& other)
+		: list(other.begin(),
+			   other.end(),
+			   node_traits::select_on_container_copy_construction(
+				   other.alloc_))
+	{
+	}
+
+	list(const list& other, const Allocator& alloc)
+		: list(other.begin(), other.end(), alloc)
 	{
 	}
 
-	list(std::initializer_list<T> values) {}
+	list(list&& other) noexcept : alloc_(std::move(other.alloc_))
+	{
+		link_empty_();
+		take_(other);
+	}
+
+	list& operator=(const list& other)
+	{
+		if (this != &other)
+		{
+			constexpr bool propagate =
+				node_traits::propagate_on_container_copy_assignment::value;
+			list copy(other, propagate ? other.alloc_ : alloc_);
+			clear();
+			if constexpr (propagate)
+			{
+				alloc_ = other.alloc_;
+			}
+			take_(copy);
+		}
+		return *this;
+	}
 
-	list(const list& other) {}
+	list& operator=(list&& other) noexcept(
+		node_traits::propagate_on_container_move_assignment::value ||
+		node_traits::is_always_equal::value)
+	{
+		if (this == &other)
+		{
+			return *this;
+		}
+		constexpr bool propagate =
+			node_traits::propagate_on_container_move_assignment::value;
+		clear();
+		if constexpr (propagate)
+		{
+			alloc_ = std::move(other.alloc_);
+			take_(other);
+		}
+		else if (alloc_ == other.alloc_)
+		{
+			take_(other);
+		}
+		else
+		{
+			// узлы other нельзя освободить нашим аллокатором
+			for (T& value : other)
+			{
+				push_back(std::move(value));
+			}
+			other.clear();
+		}
+		return *this;
+	}
 
-	list(list&& other) {}
+	allocator_type get_allocator() const noexcept
+	{
+		return allocator_type(alloc_);
+	}
 
 #pragma endregion
 #pragma region pushs
@@ -118,22 +268,27 @@ class list
 	template <typename Type>
 	void push_back(const Type& value)
 	{
-		node* last = tail_->prev_node_;
-		node* new_last = new node(tail_->prev_node_, value, tail_);
-		tail_->prev_node_ = new_last;
-		last->next_node_ = new_last;
-		++size_;
+		link_before_(&tail_, create_node_(value));
 	}
 
 	template <typename Type>
 	void push_front(const Type& value)
 	{
-		// адрес реального последнего элемента
-		node* first = head_->next_node_;
-		node* new_first = new node(head_, value, first);
-		head_->next_node_ = new_first;
-		first->prev_node_ = new_first;
-		++size_;
+		link_before_(head_.next_node_, create_node_(value));
+	}
+
+	template <typename... Args>
+	iterator emplace_back(Args&&... args)
+	{
+		return link_before_(&tail_,
+							create_node_(std::forward<Args>(args)...));
+	}
+
+	template <typename... Args>
+	iterator emplace_front(Args&&... args)
+	{
+		return link_before_(head_.next_node_,
+							create_node_(std::forward<Args>(args)...));
 	}
 
 #pragma endregion
@@ -145,16 +300,35 @@ class list
 		return (size_ == 0u);
 	}
 
-	~list() {}
+	~list() { clear(); }
 
-	void clear() {}
+	void clear() noexcept
+	{
+		node_base* current = head_.next_node_;
+		while (current != &tail_)
+		{
+			node_base* next = current->next_node_;
+			destroy_node_(static_cast<node*>(current));
+			current = next;
+		}
+		link_empty_();
+	}
 
-	size_t size() const { return 0; }
+	size_t size() const { return size_; }
 
+	// при неравных аллокаторах без propagate_on_container_swap обмен
+	// не определён, как и у std::list
 	void swap(list& other)
 
 		noexcept
 	{
+		if constexpr (node_traits::propagate_on_container_swap::value)
+		{
+			std::swap(alloc_, other.alloc_);
+		}
+		list tmp(std::move(*this));
+		take_(other);
+		other.take_(tmp);
 	}
 
 	friend void swap(list& l, list& r) { l.swap(r); }
@@ -165,74 +339,197 @@ class list
 
 		noexcept
 	{
-		return iterator{head_->next_node_};
+		return iterator{head_.next_node_};
 	}
 
 	iterator end()
 
 		noexcept
 	{
-		return iterator{tail_};
+		return iterator{&tail_};
 	}
 
 	const_iterator begin() const
 
 		noexcept
 	{
-		return const_iterator{head_->next_node_};
+		return const_iterator{head_.next_node_};
 	}
 
 	const_iterator end() const
 
 		noexcept
 	{
-		return const_iterator{tail_};
+		return const_iterator{const_cast<node_base*>(&tail_)};
 	}
 
 	const_iterator cbegin() const
 
 		noexcept
 	{
-		return const_iterator{head_->next_node_};
+		return const_iterator{head_.next_node_};
 	}
 
 	const_iterator cend() const
 
 		noexcept
 	{
-		return const_iterator{tail_};
+		return const_iterator{const_cast<node_base*>(&tail_)};
 	}
 
 #pragma endregion
 
-	T operator[](size_t pos) const {}
+	T operator[](size_t pos) const { return *(begin() + pos); }
 
-	T& operator[](size_t pos) { return *(static_cast<T*>((void*)&pos)); }
+	T& operator[](size_t pos) { return *(begin() + pos); }
 
-	friend bool operator==(const list& l, const list& r) { return true; }
+	friend bool operator==(const list& l, const list& r)
+	{
+		if (l.size_ != r.size_)
+		{
+			return false;
+		}
+		for (auto lit = l.begin(), rit = r.begin(); lit != l.end();
+			 ++lit, ++rit)
+		{
+			if (!(*lit == *rit))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
 
-	friend bool operator!=(const list& l, const list& r) { return false; }
+	friend bool operator!=(const list& l, const list& r) { return !(l == r); }
 
-	friend auto operator<=>(const list& lhs, const list& rhs) { return true; }
+	friend auto operator<=>(const list& lhs, const list& rhs)
+	{
+		return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(),
+													  rhs.begin(), rhs.end());
+	}
 
 	friend std::ostream& operator<<(std::ostream& os, const list& other)
 	{
-		return os;
+		os << "{";
+		for (auto it = other.begin(); it != other.end(); ++it)
+		{
+			if (it != other.begin())
+			{
+				os << ", ";
+			}
+			os << *it;
+		}
+		return os << "}";
 	}
 
 	iterator insert(const_iterator pos, const T& value)
 	{
-		return iterator{nullptr};
+		return link_before_(pos.current, create_node_(value));
+	}
+
+	iterator erase(const_iterator pos) noexcept
+	{
+		node_base* next = pos.current->next_node_;
+		pos.current->prev_node_->next_node_ = next;
+		next->prev_node_ = pos.current->prev_node_;
+		destroy_node_(static_cast<node*>(pos.current));
+		--size_;
+		return iterator{next};
+	}
+
+	void pop_back()
+	{
+		if (empty())
+		{
+			throw std::underflow_error("List is empty!");
+		}
+		erase(iterator{tail_.prev_node_});
+	}
+
+	void pop_front()
+	{
+		if (empty())
+		{
+			throw std::underflow_error("List is empty!");
+		}
+		erase(begin());
 	}
 
    private:
-	static bool lexicographical_compare_(const list<T>& l, const list<T>& r)
+	void link_empty_() noexcept
+	{
+		head_.next_node_ = &tail_;
+		head_.prev_node_ = nullptr;
+		tail_.prev_node_ = &head_;
+		tail_.next_node_ = nullptr;
+		size_ = 0;
+	}
+
+	// перевешивает узлы other в этот (пустой) список
+	void take_(list& other) noexcept
+	{
+		if (other.empty())
+		{
+			return;
+		}
+		head_.next_node_ = other.head_.next_node_;
+		tail_.prev_node_ = other.tail_.prev_node_;
+		head_.next_node_->prev_node_ = &head_;
+		tail_.prev_node_->next_node_ = &tail_;
+		size_ = other.size_;
+		other.link_empty_();
+	}
+
+	template <typename... Args>
+	node* create_node_(Args&&... args)
+	{
+		node* new_node = node_traits::allocate(alloc_, 1);
+		try
+		{
+			node_traits::construct(alloc_, new_node, std::allocator_arg,
+								   get_allocator(),
+								   std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			node_traits::deallocate(alloc_, new_node, 1);
+			throw;
+		}
+		return new_node;
+	}
+
+	void destroy_node_(node* old_node) noexcept
+	{
+		node_traits::destroy(alloc_, old_node);
+		node_traits::deallocate(alloc_, old_node, 1);
+	}
+
+	iterator link_before_(node_base* pos, node* new_node) noexcept
 	{
-		return "123";
+		new_node->next_node_ = pos;
+		new_node->prev_node_ = pos->prev_node_;
+		pos->prev_node_->next_node_ = new_node;
+		pos->prev_node_ = new_node;
+		++size_;
+		return iterator{new_node};
 	}
 
+	[[no_unique_address]] node_allocator alloc_;
 	size_t size_ = 0;
-	node* tail_ = nullptr;
-	node* head_ = nullptr;
+	node_base tail_;
+	node_base head_;
 };
-}  // namespace bmstu
\ No newline at end of file
+
+namespace pmr
+{
+template <typename T>
+using list = bmstu::list<T, std::pmr::polymorphic_allocator<T>>;
+}  // namespace pmr
+
+// узлы берутся из собственного пула списка, см. bmstu::node_pool
+namespace pooled
+{
+template <typename T>
+using list = bmstu::list<T, pool_allocator<T>>;
+}  // namespace pooled
+}  // namespace bmstu
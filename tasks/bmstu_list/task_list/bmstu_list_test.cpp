@@ -1,6 +1,8 @@
 #include "bmstu_list.h"
 
 #include <gtest/gtest.h>
+#include <string>
+#include <memory_resource>
 #include <algorithm>
 
 TEST(BidirectLinkedListTests, init)
@@ -535,4 +537,86 @@ TEST(BidirectLinkedListTests, from_vector)
 										"string4"s, "string5"s, "string6"s,
 										"string7"s, "end_string"s}),
 			  my_vec);
-}
\ No newline at end of file
+}
+
+TEST(BidirectLinkedListTests, pmr_monotonic_buffer)
+{
+	// вышестоящий ресурс запрещает выделения: всё должно уместиться в буфер
+	std::byte buffer[16 * 1024];
+	std::pmr::monotonic_buffer_resource arena(
+		buffer, sizeof(buffer), std::pmr::null_memory_resource());
+
+	bmstu::pmr::list<std::pmr::string> list(&arena);
+	for (int i = 0; i < 20; ++i)
+	{
+		list.push_back(std::pmr::string(40, static_cast<char>('a' + i)));
+	}
+	ASSERT_EQ(list.size(), 20u);
+	ASSERT_EQ(list.get_allocator().resource(), &arena);
+	ASSERT_EQ(list.begin()->get_allocator().resource(), &arena);
+	ASSERT_EQ(*list.begin(), std::pmr::string(40, 'a'));
+
+	bmstu::pmr::list<std::pmr::string> moved(std::move(list));
+	ASSERT_TRUE(list.empty());
+	ASSERT_EQ(moved.size(), 20u);
+	ASSERT_EQ(moved.get_allocator().resource(), &arena);
+}
+
+TEST(BidirectLinkedListTests, copy_and_move_assign)
+{
+	bmstu::list<std::string> list{"a", "b", "c"};
+	bmstu::list<std::string> copy;
+	copy = list;
+	ASSERT_EQ(copy, list);
+
+	bmstu::list<std::string> moved{"x"};
+	moved = std::move(copy);
+	ASSERT_EQ(moved, list);
+	ASSERT_TRUE(copy.empty());
+	moved.push_back("d");
+	ASSERT_EQ(moved.size(), 4u);
+	ASSERT_EQ(list.size(), 3u);
+}
+
+TEST(BidirectLinkedListTests, erase_and_pop)
+{
+	bmstu::list<int> list{1, 2, 3, 4, 5};
+	auto it = list.erase(list.begin() + 2);
+	ASSERT_EQ(*it, 4);
+	list.pop_front();
+	list.pop_back();
+	ASSERT_EQ(list, (bmstu::list<int>{2, 4}));
+	list.pop_back();
+	list.pop_back();
+	ASSERT_TRUE(list.empty());
+	ASSERT_THROW(list.pop_back(), std::underflow_error);
+	ASSERT_THROW(list.pop_front(), std::underflow_error);
+}
+
+TEST(BidirectLinkedListTests, pooled_nodes)
+{
+	bmstu::pool_allocator<std::string> alloc(64);
+	bmstu::pooled::list<std::string> list(alloc);
+	for (int i = 0; i < 1000; ++i)
+	{
+		list.push_back(std::to_string(i));
+		if (i % 3 == 0)
+		{
+			list.pop_front();
+		}
+	}
+	// узлы удалённых элементов переиспользуются
+	ASSERT_EQ(list.size(), 666u);
+	ASSERT_LE(alloc.block_count(), 11u);
+	ASSERT_EQ(*list.begin(), "334");
+
+	bmstu::pooled::list<std::string> copy(list);
+	ASSERT_EQ(copy, list);
+	ASSERT_FALSE(copy.get_allocator() == list.get_allocator());
+
+	bmstu::pooled::list<std::string> moved(std::move(list));
+	ASSERT_EQ(moved, copy);
+	list.push_back("still usable");
+	ASSERT_EQ(list.size(), 1u);
+}
+
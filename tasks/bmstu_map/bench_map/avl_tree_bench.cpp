@@ -0,0 +1,248 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory_resource>
+#include <random>
+#include <vector>
+#include "bmstu_map.h"
+
+// Основные операции bmstu::map (AVL-дерево) на 1e3 .. 1e6 ключей int -> int.
+//   Insert / InsertAscending — построение словаря из N ключей в случайном
+//     и в возрастающем порядке (во втором случае повороты на каждом шаге);
+//   Find — 4096 поисков случайных существующих ключей за итерацию;
+//   Erase — удаление всех ключей в случайном порядке;
+//   Destroy — разрушение словаря из N узлов;
+//   Iterate — обход всех пар по возрастанию ключей, от 10 до 1e7;
+//   LoadSorted / LoadShuffled — загрузка 1e5 .. 1e7 пар из
+//     отсортированного и перемешанного массива: по одному insert или
+//     map::from_sorted (второй аргумент 0 или 1);
+//   Footprint — вставка 1e7 случайных ключей в pmr::map поверх ресурса,
+//     считающего байты; bytes_per_key — память узлов на ключ.
+
+static std::vector<int> ascending_keys(size_t count)
+{
+	std::vector<int> keys(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		keys[i] = static_cast<int>(i);
+	}
+	return keys;
+}
+
+static std::vector<int> shuffled_keys(size_t count)
+{
+	std::vector<int> keys = ascending_keys(count);
+	std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+	return keys;
+}
+
+static bmstu::map<int, int> build(const std::vector<int>& keys)
+{
+	bmstu::map<int, int> map;
+	for (int key : keys)
+	{
+		map.insert(key, key);
+	}
+	return map;
+}
+
+static void insert_all(benchmark::State& state, const std::vector<int>& keys)
+{
+	for (auto _ : state)
+	{
+		bmstu::map<int, int> map = build(keys);
+		benchmark::DoNotOptimize(map);
+		state.PauseTiming();
+		map.clear();
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_Insert(benchmark::State& state)
+{
+	insert_all(state, shuffled_keys(static_cast<size_t>(state.range(0))));
+}
+
+static void BM_InsertAscending(benchmark::State& state)
+{
+	insert_all(state, ascending_keys(static_cast<size_t>(state.range(0))));
+}
+
+static void BM_Find(benchmark::State& state)
+{
+	const auto keys = shuffled_keys(static_cast<size_t>(state.range(0)));
+	const bmstu::map<int, int> map = build(keys);
+	std::vector<int> probes(4096);
+	std::mt19937 gen(7);
+	for (int& probe : probes)
+	{
+		probe = keys[gen() % keys.size()];
+	}
+	for (auto _ : state)
+	{
+		std::int64_t sum = 0;
+		for (int probe : probes)
+		{
+			sum += *map.find(probe);
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * probes.size());
+}
+
+static void BM_Erase(benchmark::State& state)
+{
+	const auto keys = shuffled_keys(static_cast<size_t>(state.range(0)));
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		bmstu::map<int, int> map = build(keys);
+		state.ResumeTiming();
+		for (int key : keys)
+		{
+			map.erase(key);
+		}
+		benchmark::DoNotOptimize(map);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_Destroy(benchmark::State& state)
+{
+	const auto keys = shuffled_keys(static_cast<size_t>(state.range(0)));
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		bmstu::map<int, int> map = build(keys);
+		state.ResumeTiming();
+		map.clear();
+		benchmark::DoNotOptimize(map);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_Iterate(benchmark::State& state)
+{
+	const bmstu::map<int, int> map =
+		build(shuffled_keys(static_cast<size_t>(state.range(0))));
+	for (auto _ : state)
+	{
+		std::int64_t sum = 0;
+		for (const auto& [key, value] : map)
+		{
+			sum += value;
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// считает выделенные байты и отдаёт запросы дальше в new/delete
+class counting_resource : public std::pmr::memory_resource
+{
+   public:
+	size_t bytes = 0;
+
+   private:
+	void* do_allocate(size_t size, size_t align) override
+	{
+		bytes += size;
+		return std::pmr::new_delete_resource()->allocate(size, align);
+	}
+
+	void do_deallocate(void* p, size_t size, size_t align) override
+	{
+		bytes -= size;
+		std::pmr::new_delete_resource()->deallocate(p, size, align);
+	}
+
+	bool do_is_equal(const memory_resource& other) const noexcept override
+	{
+		return this == &other;
+	}
+};
+
+static void BM_Footprint(benchmark::State& state)
+{
+	const auto keys = shuffled_keys(static_cast<size_t>(state.range(0)));
+	for (auto _ : state)
+	{
+		counting_resource resource;
+		bmstu::pmr::map<int, int> map(&resource);
+		for (int key : keys)
+		{
+			map.insert(key, key);
+		}
+		state.counters["bytes_per_key"] =
+			static_cast<double>(resource.bytes) / keys.size();
+		state.PauseTiming();
+		map.clear();
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static std::vector<std::pair<int, int>> pairs_of(const std::vector<int>& keys)
+{
+	std::vector<std::pair<int, int>> pairs;
+	pairs.reserve(keys.size());
+	for (int key : keys)
+	{
+		pairs.emplace_back(key, key);
+	}
+	return pairs;
+}
+
+static void load(benchmark::State& state, const std::vector<int>& keys)
+{
+	const auto pairs = pairs_of(keys);
+	for (auto _ : state)
+	{
+		bmstu::map<int, int> map;
+		if (state.range(1) == 0)
+		{
+			for (const auto& [key, value] : pairs)
+			{
+				map.insert(key, value);
+			}
+		}
+		else
+		{
+			map = bmstu::map<int, int>::from_sorted(pairs.begin(), pairs.end());
+		}
+		benchmark::DoNotOptimize(map);
+		state.PauseTiming();
+		map.clear();
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_LoadSorted(benchmark::State& state)
+{
+	load(state, ascending_keys(static_cast<size_t>(state.range(0))));
+}
+
+static void BM_LoadShuffled(benchmark::State& state)
+{
+	load(state, shuffled_keys(static_cast<size_t>(state.range(0))));
+}
+
+BENCHMARK(BM_Insert)->RangeMultiplier(10)->Range(1000, 1'000'000);
+BENCHMARK(BM_InsertAscending)->RangeMultiplier(10)->Range(1000, 1'000'000);
+BENCHMARK(BM_Find)->RangeMultiplier(10)->Range(1000, 1'000'000);
+BENCHMARK(BM_Erase)->RangeMultiplier(10)->Range(1000, 1'000'000);
+BENCHMARK(BM_Destroy)->RangeMultiplier(10)->Range(1000, 1'000'000);
+BENCHMARK(BM_Iterate)->RangeMultiplier(10)->Range(10, 10'000'000);
+// второй аргумент: 0 — insert по одному, 1 — from_sorted
+BENCHMARK(BM_LoadSorted)
+	->ArgsProduct({{100'000, 1'000'000, 10'000'000}, {0, 1}})
+	->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LoadShuffled)
+	->ArgsProduct({{100'000, 1'000'000, 10'000'000}, {0, 1}})
+	->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Footprint)
+	->Arg(10'000'000)
+	->Iterations(1)
+	->Unit(benchmark::kMillisecond);
@@ -0,0 +1,138 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+#include "bmstu_flat_map.h"
+#include "bmstu_map.h"
+
+// bmstu::flat_map (отсортированные массивы ключей и значений) против
+// bmstu::map (AVL-дерево) на 1e3 .. 1e7 ключей int -> int.
+//   Lookup  — 4096 поисков случайных существующих ключей за итерацию;
+//   Insert  — построение словаря из N случайных ключей: map по одному
+//             ключу, flat_map одной пачкой insert(first, last);
+//   InsertOneByOne — flat_map по одному ключу, каждая вставка сдвигает
+//             хвост массивов, поэтому только до 1e5;
+//   Iterate — обход всех пар по возрастанию ключей.
+
+static std::vector<int> random_keys(size_t count)
+{
+	std::vector<int> keys(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		keys[i] = static_cast<int>(i * 2);
+	}
+	std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+	return keys;
+}
+
+template <typename Map>
+static Map build(const std::vector<int>& keys)
+{
+	Map map;
+	if constexpr (std::is_same_v<Map, bmstu::flat_map<int, int>>)
+	{
+		std::vector<std::pair<int, int>> pairs;
+		pairs.reserve(keys.size());
+		for (int key : keys)
+		{
+			pairs.emplace_back(key, key);
+		}
+		map.insert(pairs.begin(), pairs.end());
+	}
+	else
+	{
+		for (int key : keys)
+		{
+			map.insert(key, key);
+		}
+	}
+	return map;
+}
+
+template <typename Map>
+static void BM_Lookup(benchmark::State& state)
+{
+	const auto keys = random_keys(static_cast<size_t>(state.range(0)));
+	const Map map = build<Map>(keys);
+	std::vector<int> probes(4096);
+	std::mt19937 gen(7);
+	for (int& probe : probes)
+	{
+		probe = keys[gen() % keys.size()];
+	}
+	for (auto _ : state)
+	{
+		std::int64_t sum = 0;
+		for (int probe : probes)
+		{
+			sum += *map.find(probe);
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * probes.size());
+}
+
+template <typename Map>
+static void BM_Insert(benchmark::State& state)
+{
+	const auto keys = random_keys(static_cast<size_t>(state.range(0)));
+	for (auto _ : state)
+	{
+		Map map = build<Map>(keys);
+		benchmark::DoNotOptimize(map);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_InsertOneByOne(benchmark::State& state)
+{
+	const auto keys = random_keys(static_cast<size_t>(state.range(0)));
+	for (auto _ : state)
+	{
+		bmstu::flat_map<int, int> map;
+		for (int key : keys)
+		{
+			map.insert(key, key);
+		}
+		benchmark::DoNotOptimize(map);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Map>
+static void BM_Iterate(benchmark::State& state)
+{
+	Map map = build<Map>(random_keys(static_cast<size_t>(state.range(0))));
+	for (auto _ : state)
+	{
+		std::int64_t sum = 0;
+		for (const auto& [key, value] : map)
+		{
+			sum += value;
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+using tree_map = bmstu::map<int, int>;
+using flat_map = bmstu::flat_map<int, int>;
+
+BENCHMARK(BM_Lookup<tree_map>)->RangeMultiplier(10)->Range(1000, 10'000'000);
+BENCHMARK(BM_Lookup<flat_map>)->RangeMultiplier(10)->Range(1000, 10'000'000);
+BENCHMARK(BM_Insert<tree_map>)
+	->RangeMultiplier(10)
+	->Range(1000, 10'000'000)
+	->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Insert<flat_map>)
+	->RangeMultiplier(10)
+	->Range(1000, 10'000'000)
+	->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_InsertOneByOne)
+	->RangeMultiplier(10)
+	->Range(1000, 100'000)
+	->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Iterate<tree_map>)->RangeMultiplier(10)->Range(1000, 10'000'000);
+BENCHMARK(BM_Iterate<flat_map>)->RangeMultiplier(10)->Range(1000, 10'000'000);
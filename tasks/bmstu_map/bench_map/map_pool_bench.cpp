@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "bmstu_map.h"
+
+// Узлы AVL-дерева из malloc против собственного пула словаря
+// (bmstu::node_pool). Churn: словарь постоянного размера, на каждом шаге
+// удаляется старый ключ и вставляется новый. Traversal: обход по
+// возрастанию ключей после того, как словарь пожил под такой нагрузкой.
+
+static std::vector<int> shuffled_keys(size_t count)
+{
+	std::vector<int> keys(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		keys[i] = static_cast<int>(i);
+	}
+	std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+	return keys;
+}
+
+template <typename Map>
+static void fill_with_churn(Map& map, const std::vector<int>& keys)
+{
+	for (int key : keys)
+	{
+		map.insert(key, key);
+	}
+	// половину ключей удаляем и возвращаем, чтобы узлы перемешались
+	for (size_t i = 0; i < keys.size(); i += 2)
+	{
+		map.erase(keys[i]);
+	}
+	for (size_t i = 0; i < keys.size(); i += 2)
+	{
+		map.insert(keys[i], keys[i]);
+	}
+}
+
+template <typename Map>
+static void BM_Churn(benchmark::State& state)
+{
+	const auto count = static_cast<size_t>(state.range(0));
+	const std::vector<int> keys = shuffled_keys(count);
+	Map map;
+	fill_with_churn(map, keys);
+	size_t oldest = 0;
+	int next = static_cast<int>(count);
+	std::vector<int> live = keys;
+	for (auto _ : state)
+	{
+		for (int i = 0; i < 1024; ++i)
+		{
+			map.erase(live[oldest]);
+			live[oldest] = next;
+			map.insert(next++, 0);
+			oldest = (oldest + 1) % count;
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * 1024);
+}
+
+template <typename Map>
+static void BM_Traversal(benchmark::State& state)
+{
+	const auto count = static_cast<size_t>(state.range(0));
+	Map map;
+	fill_with_churn(map, shuffled_keys(count));
+	for (auto _ : state)
+	{
+		std::int64_t sum = 0;
+		for (const auto& [key, value] : map)
+		{
+			sum += value;
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+using plain_map = bmstu::map<int, int>;
+using pooled_map = bmstu::pooled::map<int, int>;
+
+BENCHMARK(BM_Churn<plain_map>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_Churn<pooled_map>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_Traversal<plain_map>)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_Traversal<pooled_map>)->Range(1 << 10, 1 << 18);
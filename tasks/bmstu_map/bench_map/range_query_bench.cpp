@@ -0,0 +1,119 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+#include "bmstu_map.h"
+
+// Оконные запросы к bmstu::map на 1e7 ключей 0 .. 1e7 - 1, int -> int.
+// Аргумент — ширина окна [lo, hi): 10, 1e3, 1e5 ключей.
+//   Range — сумма значений в окне через map::range (lower_bound и обход
+//     только нужных пар, O(log N + k));
+//   Scan — то же проходом от begin(), как приходилось без lower_bound;
+//   LowerBound — 4096 запросов «первый ключ >= t» для случайных t.
+
+constexpr int key_count = 10'000'000;
+constexpr size_t window_count = 16;
+
+// один словарь на все бенчмарки: его сборка дороже самих запросов
+static const bmstu::map<int, int>& dictionary()
+{
+	static const bmstu::map<int, int> map = []
+	{
+		std::vector<std::pair<int, int>> pairs;
+		pairs.reserve(key_count);
+		for (int key = 0; key < key_count; ++key)
+		{
+			pairs.emplace_back(key, key);
+		}
+		return bmstu::map<int, int>::from_sorted(pairs.begin(), pairs.end());
+	}();
+	return map;
+}
+
+// случайные начала окон, окно целиком внутри словаря
+static std::vector<int> window_starts(int width)
+{
+	std::vector<int> starts(window_count);
+	std::mt19937 gen(11);
+	for (int& start : starts)
+	{
+		start = static_cast<int>(gen() %
+								 static_cast<unsigned>(key_count - width));
+	}
+	return starts;
+}
+
+static void BM_Range(benchmark::State& state)
+{
+	const auto& map = dictionary();
+	auto width = static_cast<int>(state.range(0));
+	const auto starts = window_starts(width);
+	for (auto _ : state)
+	{
+		std::int64_t sum = 0;
+		for (int lo : starts)
+		{
+			for (const auto& [key, value] : map.range(lo, lo + width))
+			{
+				sum += value;
+			}
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * window_count);
+}
+
+static void BM_Scan(benchmark::State& state)
+{
+	const auto& map = dictionary();
+	auto width = static_cast<int>(state.range(0));
+	const auto starts = window_starts(width);
+	for (auto _ : state)
+	{
+		std::int64_t sum = 0;
+		for (int lo : starts)
+		{
+			auto it = map.begin();
+			while (it != map.end() && it->first < lo)
+			{
+				++it;
+			}
+			for (; it != map.end() && it->first < lo + width; ++it)
+			{
+				sum += it->second;
+			}
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * window_count);
+}
+
+static void BM_LowerBound(benchmark::State& state)
+{
+	const auto& map = dictionary();
+	std::vector<int> targets(4096);
+	std::mt19937 gen(13);
+	for (int& target : targets)
+	{
+		target = static_cast<int>(gen() % key_count);
+	}
+	for (auto _ : state)
+	{
+		std::int64_t sum = 0;
+		for (int target : targets)
+		{
+			sum += map.lower_bound(target)->second;
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * targets.size());
+}
+
+BENCHMARK(BM_Range)->Arg(10)->Arg(1000)->Arg(100'000);
+BENCHMARK(BM_Scan)
+	->Arg(10)
+	->Arg(1000)
+	->Arg(100'000)
+	->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LowerBound);
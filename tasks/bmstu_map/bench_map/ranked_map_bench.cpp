@@ -0,0 +1,219 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <type_traits>
+#include <vector>
+#include "bmstu_map.h"
+
+// Порядковые статистики bmstu::ranked::map против линейного прохода по
+// обычному bmstu::map, 1e3 .. 1e6 чётных ключей int -> int. ranked_map
+// отвечает за O(log N) по счётчикам поддеревьев, plain_map — тем, что без
+// них остаётся пользователю: std::next и подсчёт шагами итератора.
+//   Nth — 64 запроса k-го ключа за итерацию;
+//   Rank — 64 запроса номера случайного ключа, половина мимо словаря;
+//   CountRange — 64 запроса числа ключей в случайном [lo, hi);
+//   Advance — 64 сдвига итератора от begin() на случайное k;
+//   Insert — построение словаря из N случайных ключей: цена поддержки
+//     счётчиков при вставке и поворотах.
+
+using plain_map = bmstu::map<int, int>;
+using ranked_map = bmstu::ranked::map<int, int>;
+
+constexpr size_t probe_count = 64;
+
+static std::vector<int> shuffled_keys(size_t count)
+{
+	std::vector<int> keys(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		keys[i] = static_cast<int>(i * 2);
+	}
+	std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+	return keys;
+}
+
+template <typename Map>
+static Map build(const std::vector<int>& keys)
+{
+	Map map;
+	for (int key : keys)
+	{
+		map.insert(key, key);
+	}
+	return map;
+}
+
+// случайные номера ключей для запросов
+static std::vector<size_t> probes(size_t count)
+{
+	std::vector<size_t> result(probe_count);
+	std::mt19937 gen(7);
+	for (size_t& probe : result)
+	{
+		probe = gen() % count;
+	}
+	return result;
+}
+
+static size_t scan_rank(const plain_map& map, int key)
+{
+	size_t rank = 0;
+	for (auto it = map.begin(); it != map.end() && it->first < key; ++it)
+	{
+		++rank;
+	}
+	return rank;
+}
+
+template <typename Map>
+static void BM_Nth(benchmark::State& state)
+{
+	auto count = static_cast<size_t>(state.range(0));
+	const Map map = build<Map>(shuffled_keys(count));
+	const auto ks = probes(count);
+	for (auto _ : state)
+	{
+		std::int64_t sum = 0;
+		for (size_t k : ks)
+		{
+			if constexpr (std::is_same_v<Map, ranked_map>)
+			{
+				sum += map.nth(k)->first;
+			}
+			else
+			{
+				sum += std::next(map.begin(), k)->first;
+			}
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * probe_count);
+}
+
+template <typename Map>
+static void BM_Rank(benchmark::State& state)
+{
+	auto count = static_cast<size_t>(state.range(0));
+	const Map map = build<Map>(shuffled_keys(count));
+	const auto ks = probes(count);
+	for (auto _ : state)
+	{
+		size_t sum = 0;
+		for (size_t k : ks)
+		{
+			int key = static_cast<int>(k) * 2 + static_cast<int>(k % 2);
+			if constexpr (std::is_same_v<Map, ranked_map>)
+			{
+				sum += map.rank(key);
+			}
+			else
+			{
+				sum += scan_rank(map, key);
+			}
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * probe_count);
+}
+
+template <typename Map>
+static void BM_CountRange(benchmark::State& state)
+{
+	auto count = static_cast<size_t>(state.range(0));
+	const Map map = build<Map>(shuffled_keys(count));
+	const auto ks = probes(count);
+	for (auto _ : state)
+	{
+		size_t sum = 0;
+		for (size_t k : ks)
+		{
+			// полуинтервал на четверть словаря, начиная с k-го ключа
+			int lo = static_cast<int>(k) * 2;
+			int hi = lo + static_cast<int>(count / 2);
+			if constexpr (std::is_same_v<Map, ranked_map>)
+			{
+				sum += map.count_range(lo, hi);
+			}
+			else
+			{
+				// без счётчиков: найти lo проходом и считать до hi
+				auto it = map.begin();
+				while (it != map.end() && it->first < lo)
+				{
+					++it;
+				}
+				for (; it != map.end() && it->first < hi; ++it)
+				{
+					++sum;
+				}
+			}
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * probe_count);
+}
+
+template <typename Map>
+static void BM_Advance(benchmark::State& state)
+{
+	auto count = static_cast<size_t>(state.range(0));
+	const Map map = build<Map>(shuffled_keys(count));
+	const auto ks = probes(count);
+	for (auto _ : state)
+	{
+		std::int64_t sum = 0;
+		for (size_t k : ks)
+		{
+			auto it = map.begin();
+			if constexpr (std::is_same_v<Map, ranked_map>)
+			{
+				it += static_cast<std::ptrdiff_t>(k);
+			}
+			else
+			{
+				std::advance(it, k);
+			}
+			sum += it->second;
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * probe_count);
+}
+
+template <typename Map>
+static void BM_Insert(benchmark::State& state)
+{
+	const auto keys = shuffled_keys(static_cast<size_t>(state.range(0)));
+	for (auto _ : state)
+	{
+		Map map = build<Map>(keys);
+		benchmark::DoNotOptimize(map);
+		state.PauseTiming();
+		map.clear();
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_Nth<ranked_map>)->RangeMultiplier(10)->Range(1000, 1'000'000);
+BENCHMARK(BM_Nth<plain_map>)->RangeMultiplier(10)->Range(1000, 1'000'000);
+BENCHMARK(BM_Rank<ranked_map>)->RangeMultiplier(10)->Range(1000, 1'000'000);
+BENCHMARK(BM_Rank<plain_map>)->RangeMultiplier(10)->Range(1000, 1'000'000);
+BENCHMARK(BM_CountRange<ranked_map>)
+	->RangeMultiplier(10)
+	->Range(1000, 1'000'000);
+BENCHMARK(BM_CountRange<plain_map>)
+	->RangeMultiplier(10)
+	->Range(1000, 1'000'000);
+BENCHMARK(BM_Advance<ranked_map>)->RangeMultiplier(10)->Range(1000, 1'000'000);
+BENCHMARK(BM_Advance<plain_map>)->RangeMultiplier(10)->Range(1000, 1'000'000);
+BENCHMARK(BM_Insert<ranked_map>)
+	->RangeMultiplier(10)
+	->Range(1000, 1'000'000)
+	->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Insert<plain_map>)
+	->RangeMultiplier(10)
+	->Range(1000, 1'000'000)
+	->Unit(benchmark::kMillisecond);
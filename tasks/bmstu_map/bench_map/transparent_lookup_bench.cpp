@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "bmstu_map.h"
+#include "bmstu_sso_string.h"
+
+// Поиск в bmstu::map<bmstu::string, int> по std::string_view, 4096
+// запросов за итерацию.
+//   Lookup<transparent_less> — Compare с is_transparent: string_view
+//     сравнивается с ключами напрямую;
+//   Lookup<key_less> — Compare только для bmstu::string: каждый поиск
+//     строит временный ключ.
+// Аргументы — число ключей (1e3, 1e5) и их длина: 8 символов помещаются
+// в SSO-буфер строки, 40 — нет, и временный ключ выделяет память в куче.
+
+static std::string_view view(std::string_view s) { return s; }
+
+static std::string_view view(const bmstu::string& s)
+{
+	return {s.c_str(), s.size()};
+}
+
+struct transparent_less
+{
+	using is_transparent = void;
+
+	template <typename L, typename R>
+	bool operator()(const L& lhs, const R& rhs) const
+	{
+		return view(lhs) < view(rhs);
+	}
+};
+
+struct key_less
+{
+	bool operator()(const bmstu::string& lhs, const bmstu::string& rhs) const
+	{
+		return view(lhs) < view(rhs);
+	}
+};
+
+// различные ключи заданной длины: номер в начале, дальше заполнитель
+static std::vector<std::string> make_keys(size_t count, size_t length)
+{
+	std::vector<std::string> keys(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		keys[i] = std::to_string(i);
+		keys[i].resize(length, 'x');
+	}
+	return keys;
+}
+
+template <typename Compare>
+static void BM_Lookup(benchmark::State& state)
+{
+	auto count = static_cast<size_t>(state.range(0));
+	const auto keys = make_keys(count, static_cast<size_t>(state.range(1)));
+	bmstu::map<bmstu::string, int, Compare> map;
+	for (size_t i = 0; i < count; ++i)
+	{
+		map.insert(bmstu::string(keys[i].c_str()), static_cast<int>(i));
+	}
+	// строки keys оканчиваются нулём, их view можно отдать конструктору
+	std::vector<std::string_view> probes(4096);
+	std::mt19937 gen(17);
+	for (std::string_view& probe : probes)
+	{
+		probe = keys[gen() % count];
+	}
+	for (auto _ : state)
+	{
+		std::int64_t sum = 0;
+		for (std::string_view probe : probes)
+		{
+			if constexpr (std::is_same_v<Compare, transparent_less>)
+			{
+				sum += *map.find(probe);
+			}
+			else
+			{
+				sum += *map.find(bmstu::string(probe.data()));
+			}
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * probes.size());
+}
+
+BENCHMARK(BM_Lookup<transparent_less>)
+	->ArgsProduct({{1000, 100'000}, {8, 40}});
+BENCHMARK(BM_Lookup<key_less>)->ArgsProduct({{1000, 100'000}, {8, 40}});
@@ -0,0 +1,126 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include "bmstu_map.h"
+#include "bmstu_unordered_map.h"
+
+// bmstu::unordered_map (Swiss table) против bmstu::map и
+// std::unordered_map, ключи int -> int.
+//   FindHit / FindMiss — 4096 поисков существующих / отсутствующих ключей
+//     в таблице на 2^20 слотов, заполненной на 25, 50, 75 и 87 процентов
+//     (аргумент). Остальные словари получают то же число ключей;
+//   Insert — построение словаря из N ключей через operator[].
+
+constexpr size_t slots = 1 << 20;
+
+// различные ключи в случайном порядке: i * нечётное — биекция на uint32
+static std::vector<int> distinct_keys(size_t count)
+{
+	std::vector<int> keys(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		keys[i] = static_cast<int>(static_cast<uint32_t>(i) * 2654435761u);
+	}
+	return keys;
+}
+
+template <typename Map>
+static const int* find_value(const Map& map, int key)
+{
+	if constexpr (std::is_pointer_v<decltype(map.find(key))>)
+	{
+		return map.find(key);
+	}
+	else
+	{
+		auto it = map.find(key);
+		return it == map.end() ? nullptr : &it->second;
+	}
+}
+
+template <typename Map>
+static void BM_Find(benchmark::State& state, bool hit)
+{
+	size_t count = slots * static_cast<size_t>(state.range(0)) / 100;
+	// вторая половина ключей в словарь не попадает
+	const auto keys = distinct_keys(count * 2);
+	Map map;
+	if constexpr (std::is_same_v<Map, bmstu::unordered_map<int, int>>)
+	{
+		map.reserve(slots - slots / 8);
+	}
+	for (size_t i = 0; i < count; ++i)
+	{
+		map[keys[i]] = static_cast<int>(i);
+	}
+	std::vector<int> probes(4096);
+	std::mt19937 gen(3);
+	for (int& probe : probes)
+	{
+		probe = keys[gen() % count + (hit ? 0 : count)];
+	}
+	for (auto _ : state)
+	{
+		size_t found = 0;
+		for (int probe : probes)
+		{
+			found += find_value(map, probe) != nullptr;
+		}
+		benchmark::DoNotOptimize(found);
+	}
+	state.SetItemsProcessed(state.iterations() * probes.size());
+}
+
+template <typename Map>
+static void BM_FindHit(benchmark::State& state)
+{
+	BM_Find<Map>(state, true);
+}
+
+template <typename Map>
+static void BM_FindMiss(benchmark::State& state)
+{
+	BM_Find<Map>(state, false);
+}
+
+template <typename Map>
+static void BM_Insert(benchmark::State& state)
+{
+	const auto keys = distinct_keys(static_cast<size_t>(state.range(0)));
+	for (auto _ : state)
+	{
+		Map map;
+		for (int key : keys)
+		{
+			map[key] = key;
+		}
+		benchmark::DoNotOptimize(map);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+using swiss_map = bmstu::unordered_map<int, int>;
+using tree_map = bmstu::map<int, int>;
+using std_map = std::unordered_map<int, int>;
+
+BENCHMARK(BM_FindHit<swiss_map>)->Arg(25)->Arg(50)->Arg(75)->Arg(87);
+BENCHMARK(BM_FindHit<tree_map>)->Arg(25)->Arg(50)->Arg(75)->Arg(87);
+BENCHMARK(BM_FindHit<std_map>)->Arg(25)->Arg(50)->Arg(75)->Arg(87);
+BENCHMARK(BM_FindMiss<swiss_map>)->Arg(25)->Arg(50)->Arg(75)->Arg(87);
+BENCHMARK(BM_FindMiss<tree_map>)->Arg(25)->Arg(50)->Arg(75)->Arg(87);
+BENCHMARK(BM_FindMiss<std_map>)->Arg(25)->Arg(50)->Arg(75)->Arg(87);
+BENCHMARK(BM_Insert<swiss_map>)
+	->RangeMultiplier(10)
+	->Range(1000, 1'000'000)
+	->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Insert<tree_map>)
+	->RangeMultiplier(10)
+	->Range(1000, 1'000'000)
+	->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Insert<std_map>)
+	->RangeMultiplier(10)
+	->Range(1000, 1'000'000)
+	->Unit(benchmark::kMillisecond);
@@ -0,0 +1,392 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "bmstu_simple_vector.h"
+
+namespace bmstu
+{
+// Словарь на двух отсортированных массивах: ключи отдельно от значений
+// (structure of arrays). Поиск — двоичный по плотному массиву ключей без
+// переходов по указателям, обход — линейный проход по памяти. Вставка и
+// удаление одного ключа сдвигают хвосты массивов (O(N)), поэтому много
+// ключей выгоднее добавлять одной пачкой insert(first, last): пачка
+// сортируется и сливается с массивами за O(N + M log M).
+//
+// Интерфейс повторяет bmstu::map: insert перезаписывает значение
+// существующего ключа, find возвращает указатель на значение. Итератор
+// произвольного доступа, разыменование даёт пару ссылок
+// std::pair<const K&, V&>; для концептов std::ranges такой паре нужен
+// common_reference из C++23, поэтому для ranges-алгоритмов удобнее keys()
+// и values(). Изменение набора ключей делает итераторы и указатели из find
+// недействительными.
+template <typename K,
+		  typename V,
+		  typename Allocator = std::allocator<std::pair<const K, V>>>
+class flat_map
+{
+	using key_allocator =
+		typename std::allocator_traits<Allocator>::template rebind_alloc<K>;
+	using mapped_allocator =
+		typename std::allocator_traits<Allocator>::template rebind_alloc<V>;
+
+   public:
+	using key_type = K;
+	using mapped_type = V;
+	using value_type = std::pair<const K, V>;
+	using allocator_type = Allocator;
+
+	template <bool Const>
+	class basic_iterator
+	{
+		using mapped = std::conditional_t<Const, const V, V>;
+
+	   public:
+		using iterator_category = std::random_access_iterator_tag;
+		using value_type = std::pair<K, V>;
+		using difference_type = std::ptrdiff_t;
+		using reference = std::pair<const K&, mapped&>;
+
+		// пара ссылок живёт внутри, чтобы it->first работал
+		struct pointer
+		{
+			reference pair;
+
+			const reference* operator->() const noexcept { return &pair; }
+		};
+
+		basic_iterator() = default;
+
+		operator basic_iterator<true>() const noexcept
+			requires(!Const)
+		{
+			return {key_, value_};
+		}
+
+		reference operator*() const noexcept { return {*key_, *value_}; }
+
+		pointer operator->() const noexcept { return {**this}; }
+
+		reference operator[](difference_type n) const noexcept
+		{
+			return {key_[n], value_[n]};
+		}
+
+		basic_iterator& operator++() noexcept { return *this += 1; }
+
+		basic_iterator operator++(int) noexcept
+		{
+			basic_iterator copy(*this);
+			++*this;
+			return copy;
+		}
+
+		basic_iterator& operator--() noexcept { return *this -= 1; }
+
+		basic_iterator operator--(int) noexcept
+		{
+			basic_iterator copy(*this);
+			--*this;
+			return copy;
+		}
+
+		basic_iterator& operator+=(difference_type n) noexcept
+		{
+			key_ += n;
+			value_ += n;
+			return *this;
+		}
+
+		basic_iterator& operator-=(difference_type n) noexcept
+		{
+			return *this += -n;
+		}
+
+		friend basic_iterator operator+(basic_iterator it,
+										difference_type n) noexcept
+		{
+			return it += n;
+		}
+
+		friend basic_iterator operator+(difference_type n,
+										basic_iterator it) noexcept
+		{
+			return it += n;
+		}
+
+		friend basic_iterator operator-(basic_iterator it,
+										difference_type n) noexcept
+		{
+			return it -= n;
+		}
+
+		friend difference_type operator-(const basic_iterator& lhs,
+										 const basic_iterator& rhs) noexcept
+		{
+			return lhs.key_ - rhs.key_;
+		}
+
+		friend bool operator==(const basic_iterator& lhs,
+							   const basic_iterator& rhs) noexcept
+		{
+			return lhs.key_ == rhs.key_;
+		}
+
+		friend auto operator<=>(const basic_iterator& lhs,
+								const basic_iterator& rhs) noexcept
+		{
+			return lhs.key_ <=> rhs.key_;
+		}
+
+	   private:
+		friend class flat_map;
+		friend class basic_iterator<!Const>;
+
+		basic_iterator(const K* key, mapped* value) noexcept
+			: key_(key), value_(value)
+		{
+		}
+
+		const K* key_ = nullptr;
+		mapped* value_ = nullptr;
+	};
+
+	using iterator = basic_iterator<false>;
+	using const_iterator = basic_iterator<true>;
+
+	flat_map() = default;
+
+	explicit flat_map(const Allocator& alloc)
+		: keys_(key_allocator(alloc)), values_(mapped_allocator(alloc))
+	{
+	}
+
+	template <std::input_iterator It>
+	flat_map(It first, It last, const Allocator& alloc = Allocator())
+		: flat_map(alloc)
+	{
+		insert(first, last);
+	}
+
+	flat_map(std::initializer_list<value_type> init,
+			 const Allocator& alloc = Allocator())
+		: flat_map(init.begin(), init.end(), alloc)
+	{
+	}
+
+	allocator_type get_allocator() const noexcept
+	{
+		return allocator_type(keys_.get_allocator());
+	}
+
+	void insert(const K& key, const V& value)
+	{
+		size_t pos = lower_bound_(key);
+		if (found_(pos, key))
+		{
+			values_[pos] = value;
+			return;
+		}
+		insert_at_(pos, key, value);
+	}
+
+	void insert(const value_type& pair) { insert(pair.first, pair.second); }
+
+	// Пачка пар: сортируется отдельно и сливается с массивами за один
+	// проход. Из равных ключей остаётся последний, как при вставке по
+	// одному. При исключении словарь не меняется, если перемещение K и V
+	// не бросает.
+	template <std::input_iterator It>
+	void insert(It first, It last)
+	{
+		simple_vector<std::pair<K, V>> batch(first, last);
+		std::stable_sort(batch.begin(), batch.end(),
+						 [](const auto& lhs, const auto& rhs) {
+							 return lhs.first < rhs.first;
+						 });
+		merge_(batch);
+	}
+
+	V& operator[](const K& key)
+	{
+		size_t pos = lower_bound_(key);
+		if (!found_(pos, key))
+		{
+			insert_at_(pos, key, V());
+		}
+		return values_[pos];
+	}
+
+	V* find(const K& key)
+	{
+		size_t pos = lower_bound_(key);
+		return found_(pos, key) ? &values_[pos] : nullptr;
+	}
+
+	const V* find(const K& key) const
+	{
+		size_t pos = lower_bound_(key);
+		return found_(pos, key) ? &values_[pos] : nullptr;
+	}
+
+	V& at(const K& key)
+	{
+		V* value = find(key);
+		if (value == nullptr)
+		{
+			throw std::out_of_range("Key not found in map");
+		}
+		return *value;
+	}
+
+	const V& at(const K& key) const
+	{
+		const V* value = find(key);
+		if (value == nullptr)
+		{
+			throw std::out_of_range("Key not found in map");
+		}
+		return *value;
+	}
+
+	void erase(const K& key)
+	{
+		size_t pos = lower_bound_(key);
+		if (found_(pos, key))
+		{
+			keys_.erase(keys_.cbegin() + pos);
+			values_.erase(values_.cbegin() + pos);
+		}
+	}
+
+	bool contains(const K& key) const { return find(key) != nullptr; }
+
+	size_t size() const noexcept { return keys_.size(); }
+
+	bool empty() const noexcept { return keys_.empty(); }
+
+	void clear() noexcept
+	{
+		keys_.clear();
+		values_.clear();
+	}
+
+	void reserve(size_t capacity)
+	{
+		keys_.reserve(capacity);
+		values_.reserve(capacity);
+	}
+
+	// ключи по возрастанию и значения в том же порядке
+	std::span<const K> keys() const noexcept
+	{
+		return {std::to_address(keys_.begin()), keys_.size()};
+	}
+
+	std::span<const V> values() const noexcept
+	{
+		return {std::to_address(values_.begin()), values_.size()};
+	}
+
+	iterator begin() noexcept
+	{
+		return {std::to_address(keys_.cbegin()),
+				std::to_address(values_.begin())};
+	}
+
+	iterator end() noexcept { return begin() + size(); }
+
+	const_iterator begin() const noexcept
+	{
+		return {std::to_address(keys_.begin()),
+				std::to_address(values_.begin())};
+	}
+
+	const_iterator end() const noexcept { return begin() + size(); }
+
+	const_iterator cbegin() const noexcept { return begin(); }
+
+	const_iterator cend() const noexcept { return end(); }
+
+   private:
+	size_t lower_bound_(const K& key) const
+	{
+		return static_cast<size_t>(
+			std::lower_bound(keys_.begin(), keys_.end(), key) - keys_.begin());
+	}
+
+	bool found_(size_t pos, const K& key) const
+	{
+		return pos < keys_.size() && !(key < keys_[pos]);
+	}
+
+	void insert_at_(size_t pos, const K& key, const V& value)
+	{
+		keys_.insert(keys_.cbegin() + pos, key);
+		try
+		{
+			values_.insert(values_.cbegin() + pos, value);
+		}
+		catch (...)
+		{
+			keys_.erase(keys_.cbegin() + pos);
+			throw;
+		}
+	}
+
+	// batch отсортирован устойчиво; из серии равных ключей берётся
+	// последний, и он же заменяет значение существующего ключа
+	void merge_(simple_vector<std::pair<K, V>>& batch)
+	{
+		simple_vector<K, key_allocator> keys(keys_.get_allocator());
+		simple_vector<V, mapped_allocator> values(values_.get_allocator());
+		keys.reserve(keys_.size() + batch.size());
+		values.reserve(values_.size() + batch.size());
+		size_t old = 0;
+		for (size_t i = 0; i < batch.size(); ++i)
+		{
+			if (i + 1 < batch.size() && !(batch[i].first < batch[i + 1].first))
+			{
+				continue;
+			}
+			for (; old < keys_.size() && keys_[old] < batch[i].first; ++old)
+			{
+				keys.push_back(std::move_if_noexcept(keys_[old]));
+				values.push_back(std::move_if_noexcept(values_[old]));
+			}
+			if (old < keys_.size() && !(batch[i].first < keys_[old]))
+			{
+				++old;
+			}
+			keys.push_back(std::move(batch[i].first));
+			values.push_back(std::move(batch[i].second));
+		}
+		for (; old < keys_.size(); ++old)
+		{
+			keys.push_back(std::move_if_noexcept(keys_[old]));
+			values.push_back(std::move_if_noexcept(values_[old]));
+		}
+		keys_ = std::move(keys);
+		values_ = std::move(values);
+	}
+
+	simple_vector<K, key_allocator> keys_;
+	simple_vector<V, mapped_allocator> values_;
+};
+
+namespace pmr
+{
+template <typename K, typename V>
+using flat_map = bmstu::
+	flat_map<K, V, std::pmr::polymorphic_allocator<std::pair<const K, V>>>;
+}  // namespace pmr
+}  // namespace bmstu
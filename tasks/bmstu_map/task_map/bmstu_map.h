@@ -1,3 +1,5 @@
+#pragma once
+
 /*
  * ЗАДАНИЕ: Реализация std::map на основе AVL-дерева
  *
@@ -10,16 +12,16 @@
  *    - insert() - вставка пары ключ-значение с балансировкой
  *    - remove() - удаление по ключу с балансировкой
  *    - find() - поиск узла по ключу
- *    - balance() - балансировка дерева (проверка высот и вызов поворотов)
+ *    - balance() - балансировка дерева (показатель баланса и повороты)
  *    - Повороты: rotateWithLeftChild, rotateWithRightChild,
  *                doubleWithLeftChild, doubleWithRightChild
- *    - Вспомогательные: heightOfTree(), findMinPtr()
+ *    - Вспомогательные: findMinPtr()
  *
  * 2. Iterator (map::iterator):
  *    - Конструктор для инициализации (найти самый левый узел для begin)
  *    - operator*() - разыменование (вернуть std::pair<const K, V>)
  *    - operator++() - переход к следующему элементу в in-order обходе
- *    - Использовать std::stack для обхода дерева
+ *    - Для обхода использовать ссылки узлов на родителя
  *
  * 3. Map (map):
  *    - Все публичные методы уже реализованы и используют AVL дерево
@@ -35,199 +37,1094 @@
  * - Все 18 тестов должны пройти успешно после полной реализации
  */
 
+#include <algorithm>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <iostream>
 #include <iterator>
-#include <stack>
+#include <memory>
+#include <memory_resource>
+#include <ranges>
 #include <stdexcept>
+#include <tuple>
+#include <type_traits>
 #include <utility>
-#include "abstract_iterator.h"
+#include "bmstu_node_pool.h"
+#include "bmstu_simple_vector.h"
 
 namespace bmstu
 {
 // ==================== AVL Tree Node ====================
-template <typename K, typename V>
+// Связи узла отдельно от данных: повороты, балансировка и обход работают
+// только с ними. Заголовок дерева — такой же tree_node_base без ключа и
+// значения, его левый ребёнок — корень, а сам он служит end().
+struct tree_node_base
+{
+	// соседи в порядке возрастания ключей, амортизированно O(1)
+	tree_node_base* next() noexcept
+	{
+		tree_node_base* node = this;
+		if (node->right != nullptr)
+		{
+			node = node->right;
+			while (node->left != nullptr)
+			{
+				node = node->left;
+			}
+			return node;
+		}
+		while (node == node->parent()->right)
+		{
+			node = node->parent();
+		}
+		return node->parent();
+	}
+
+	tree_node_base* prev() noexcept
+	{
+		tree_node_base* node = this;
+		if (node->left != nullptr)
+		{
+			node = node->left;
+			while (node->right != nullptr)
+			{
+				node = node->right;
+			}
+			return node;
+		}
+		while (node == node->parent()->left)
+		{
+			node = node->parent();
+		}
+		return node->parent();
+	}
+
+	tree_node_base* parent() const noexcept
+	{
+		return reinterpret_cast<tree_node_base*>(parent_ & ~balance_mask_);
+	}
+
+	void set_parent(tree_node_base* node) noexcept
+	{
+		parent_ = reinterpret_cast<std::uintptr_t>(node) |
+				  (parent_ & balance_mask_);
+	}
+
+	// высота правого поддерева минус высота левого: -1, 0 или 1
+	int balance() const noexcept
+	{
+		return static_cast<int>(parent_ & balance_mask_) - 1;
+	}
+
+	void set_balance(int balance) noexcept
+	{
+		parent_ = (parent_ & ~balance_mask_) |
+				  static_cast<std::uintptr_t>(balance + 1);
+	}
+
+	tree_node_base* left = nullptr;
+	tree_node_base* right = nullptr;
+
+   private:
+	// Показатель баланса хранится в двух младших битах указателя на
+	// родителя, они всегда нулевые из-за выравнивания узла. Отдельное поле
+	// высоты добавило бы к узлу целое слово выравнивания.
+	static constexpr std::uintptr_t balance_mask_ = 3;
+
+	std::uintptr_t parent_ = 1;
+};
+
+static_assert(alignof(tree_node_base) > 3);
+static_assert(sizeof(tree_node_base) == 3 * sizeof(void*));
+
+// Узел дерева с порядковыми статистиками: число узлов в поддереве
+// позволяет за O(log N) найти k-й ключ и номер ключа. Счётчик стоит слово
+// на узел, поэтому его держат только деревья с Ranked = true.
+struct ranked_node_base : tree_node_base
+{
+	size_t count = 1;
+};
+
+static_assert(sizeof(ranked_node_base) == 4 * sizeof(void*));
+
+// Пара хранится в узле целиком, итератор отдаёт ссылку прямо на неё
+template <typename K, typename V, bool Ranked = false>
 struct tree_node
+	: std::conditional_t<Ranked, ranked_node_base, tree_node_base>
 {
-	tree_node(const K& k, const V& v)
-		: key(k), value(v), left(nullptr), right(nullptr), height(1)
+	tree_node(const K& k, const V& v) : data(k, v) {}
+
+	// ключ и значение создаются аллокатором дерева (uses-allocator), чтобы
+	// элементы std::pmr попадали в тот же ресурс, что и узлы
+	template <typename Allocator>
+	tree_node(std::allocator_arg_t,
+			  const Allocator& alloc,
+			  const K& k,
+			  const V& v)
+		: data(std::make_obj_using_allocator<std::pair<const K, V>>(alloc,
+																	 k,
+																	 v))
 	{
 	}
 
-	K key;
-	V value;
-	uint8_t height;
-	tree_node* left;
-	tree_node* right;
+	std::pair<const K, V> data;
 };
 
+// за связями сразу идёт пара, без дыр выравнивания
+static_assert(sizeof(tree_node<int, int>) ==
+			  sizeof(tree_node_base) + 2 * sizeof(int));
+
 // ==================== AVL Balanced Tree ====================
 // ЗАДАНИЕ ДЛЯ СТУДЕНТОВ:
 // Реализуйте самобалансирующееся AVL-дерево с поддержкой вставки, удаления и
 // поиска по ключам. Дерево должно автоматически балансироваться после каждой
 // операции.
-template <typename K, typename V>
+template <typename K,
+		  typename V,
+		  typename Compare = std::less<K>,
+		  typename Allocator = std::allocator<std::pair<const K, V>>,
+		  bool Ranked = false>
 class avl_balanced_tree
 {
+	// заголовок того же типа, что и связи узлов, чтобы у него тоже был
+	// счётчик: по нему итератор end() узнаёт размер дерева
+	using link_type =
+		std::conditional_t<Ranked, ranked_node_base, tree_node_base>;
+
+   public:
+	using node_type = tree_node<K, V, Ranked>;
+
+   private:
+	using node_allocator = typename std::allocator_traits<
+		Allocator>::template rebind_alloc<node_type>;
+	using node_traits = std::allocator_traits<node_allocator>;
+
    public:
-	avl_balanced_tree() : root_(nullptr), size_(0) {}
-	~avl_balanced_tree() { clear(root_); }
+	avl_balanced_tree() = default;
+
+	explicit avl_balanced_tree(const Allocator& alloc)
+		: alloc_(alloc)
+	{
+	}
+
+	avl_balanced_tree(const Compare& compare, const Allocator& alloc)
+		: alloc_(alloc), compare_(compare)
+	{
+	}
 
+	avl_balanced_tree(const avl_balanced_tree& other)
+		: avl_balanced_tree(other,
+							node_traits::select_on_container_copy_construction(
+								other.alloc_))
+	{
+	}
+
+	avl_balanced_tree(const avl_balanced_tree& other, const Allocator& alloc)
+		: alloc_(alloc), compare_(other.compare_)
+	{
+		header_.left = clone(other.header_.left, &header_);
+		size_ = other.size_;
+	}
+
+	avl_balanced_tree(avl_balanced_tree&& other) noexcept
+		: alloc_(std::move(other.alloc_)), compare_(other.compare_)
+	{
+		adopt_(other);
+	}
+
+	avl_balanced_tree& operator=(const avl_balanced_tree& other)
+	{
+		if (this != &other)
+		{
+			constexpr bool propagate =
+				node_traits::propagate_on_container_copy_assignment::value;
+			avl_balanced_tree copy(other, propagate ? other.alloc_ : alloc_);
+			clear();
+			if constexpr (propagate)
+			{
+				alloc_ = other.alloc_;
+			}
+			compare_ = other.compare_;
+			adopt_(copy);
+		}
+		return *this;
+	}
+
+	avl_balanced_tree& operator=(avl_balanced_tree&& other) noexcept(
+		node_traits::propagate_on_container_move_assignment::value ||
+		node_traits::is_always_equal::value)
+	{
+		if (this == &other)
+		{
+			return *this;
+		}
+		constexpr bool propagate =
+			node_traits::propagate_on_container_move_assignment::value;
+		clear();
+		compare_ = other.compare_;
+		if constexpr (!propagate)
+		{
+			if (alloc_ != other.alloc_)
+			{
+				// узлы other нельзя освободить нашим аллокатором
+				header_.left = clone(other.header_.left, &header_);
+				size_ = other.size_;
+				other.clear();
+				return *this;
+			}
+		}
+		else
+		{
+			alloc_ = std::move(other.alloc_);
+		}
+		adopt_(other);
+		return *this;
+	}
+
+	~avl_balanced_tree() { clear(header_.left); }
+
+	Allocator get_allocator() const noexcept { return Allocator(alloc_); }
+
+	const Compare& key_comp() const noexcept { return compare_; }
+
+	// Вставка, удаление и поиск без рекурсии: спуск запоминает адреса
+	// ссылок на пройденные узлы в массиве path, а балансировка идёт по нему
+	// обратно к корню и останавливается, как только высота поддерева
+	// перестаёт меняться.
 	void insert(const K& key, const V& value)
 	{
-		this->insert(key, value, root_);
+		tree_node_base** path[max_depth_];
+		size_t depth = 0;
+		tree_node_base** link = &header_.left;
+		while (*link != nullptr)
+		{
+			tree_node_base* node = *link;
+			if (compare_(key, key_of_(node)))
+			{
+				path[depth++] = link;
+				link = &node->left;
+			}
+			else if (compare_(key_of_(node), key))
+			{
+				path[depth++] = link;
+				link = &node->right;
+			}
+			else
+			{
+				as_node_(node)->data.second = value;
+				return;
+			}
+		}
+		node_type* node = create_node(key, value);
+		node->set_parent(depth > 0 ? *path[depth - 1] : &header_);
+		*link = node;
+		++size_;
+		recount_path_(path, depth, true);
+		rebalance_(path, depth, link, true);
 	}
 
-	void remove(const K& key) { this->remove(key, root_); }
+	void remove(const K& key)
+	{
+		tree_node_base** path[max_depth_];
+		size_t depth = 0;
+		tree_node_base** link = &header_.left;
+		while (*link != nullptr)
+		{
+			tree_node_base* node = *link;
+			if (compare_(key, key_of_(node)))
+			{
+				path[depth++] = link;
+				link = &node->left;
+			}
+			else if (compare_(key_of_(node), key))
+			{
+				path[depth++] = link;
+				link = &node->right;
+			}
+			else
+			{
+				tree_node_base** shrunk = unlink_(link, path, depth);
+				destroy_node(as_node_(node));
+				--size_;
+				recount_path_(path, depth, false);
+				rebalance_(path, depth, shrunk, false);
+				return;
+			}
+		}
+	}
 
-	tree_node<K, V>* find(const K& key) { return this->find(key, root_); }
+	// Вставка пар, упорядоченных по неубыванию ключа, за O(N + M). Узлы
+	// новых ключей создаются подряд в порядке ключей, так что аллокатор
+	// (пул, monotonic_buffer_resource, свежая куча) кладёт их рядом. Затем
+	// старые и новые узлы сливаются в один список, из которого собирается
+	// идеально сбалансированное дерево. Из равных ключей побеждает
+	// последний, как при вставке по одному. Если новых пар мало, быстрее
+	// M вставок за O(log N). Гарантия при исключении базовая, как у вставки
+	// диапазона в std::map: дерево остаётся целым и сбалансированным, но
+	// значения части имеющихся ключей могут быть уже заменены, а при
+	// вставке по одной в дереве остаются пары, вставленные до исключения.
+	template <std::forward_iterator It, std::sentinel_for<It> S>
+	void insert_sorted(It first, S last)
+	{
+		auto count = static_cast<size_t>(std::ranges::distance(first, last));
+		if (count * std::bit_width(size_) < size_)
+		{
+			for (; first != last; ++first)
+			{
+				const auto& [key, value] = *first;
+				insert(key, value);
+			}
+			return;
+		}
+		tree_node_base* fresh = nullptr;
+		tree_node_base** tail = &fresh;
+		size_t added = 0;
+		tree_node_base* old = begin_node();
+		try
+		{
+			while (first != last)
+			{
+				// из серии равных ключей берётся последний
+				It run = first;
+				while (++first != last &&
+					   !compare_((*run).first, (*first).first))
+				{
+					run = first;
+				}
+				const auto& [key, value] = *run;
+				while (old != &header_ && compare_(key_of_(old), key))
+				{
+					old = old->next();
+				}
+				if (old != &header_ && !(compare_(key, key_of_(old))))
+				{
+					as_node_(old)->data.second = value;
+					continue;
+				}
+				node_type* node = create_node(key, value);
+				*tail = node;
+				tail = &node->right;
+				++added;
+			}
+		}
+		catch (...)
+		{
+			while (fresh != nullptr)
+			{
+				tree_node_base* next = fresh->right;
+				destroy_node(as_node_(fresh));
+				fresh = next;
+			}
+			throw;
+		}
+		tree_node_base* list = merge_(flatten_(), fresh);
+		size_ += added;
+		header_.left = build_(list, size_);
+		if (header_.left != nullptr)
+		{
+			header_.left->set_parent(&header_);
+		}
+	}
 
-	const tree_node<K, V>* find(const K& key) const
+	// Поиск принимает любой тип Q, который Compare умеет сравнивать с K;
+	// какие Q допустимы, решает map (Compare::is_transparent).
+	template <typename Q>
+	node_type* find(const Q& key)
 	{
-		return this->find(key, root_);
+		return find_(key);
 	}
 
-	bool contains(const K& key) const { return find(key) != nullptr; }
+	template <typename Q>
+	const node_type* find(const Q& key) const
+	{
+		return find_(key);
+	}
+
+	template <typename Q>
+	bool contains(const Q& key) const
+	{
+		return find(key) != nullptr;
+	}
 
 	size_t size() const { return size_; }
 
 	bool empty() const { return size_ == 0; }
 
-	tree_node<K, V>* get_root() { return root_; }
+	void clear() noexcept
+	{
+		clear(header_.left);
+		header_.left = nullptr;
+		size_ = 0;
+	}
+
+	node_type* get_root() { return as_node_(header_.left); }
+
+	const node_type* get_root() const
+	{
+		return as_node_(header_.left);
+	}
+
+	// узлы для итераторов: наименьший ключ и заголовок (end)
+	tree_node_base* begin_node() noexcept
+	{
+		return header_.left != nullptr ? findMinPtr(header_.left) : &header_;
+	}
+
+	tree_node_base* end_node() noexcept { return &header_; }
+
+	// первый узел с ключом не меньше key или end_node(), O(log N)
+	template <typename Q>
+	tree_node_base* lower_bound(const Q& key)
+	{
+		return bound_<false>(key);
+	}
+
+	// первый узел с ключом больше key или end_node(), O(log N)
+	template <typename Q>
+	tree_node_base* upper_bound(const Q& key)
+	{
+		return bound_<true>(key);
+	}
+
+	// ==================== Порядковые статистики ====================
+	// Только для Ranked = true, каждая операция за O(log N).
+
+	// узел k-го по возрастанию ключа (с нуля) или end_node()
+	tree_node_base* select(size_t k) noexcept
+		requires Ranked
+	{
+		return select_(&header_, k);
+	}
+
+	// число ключей меньше key; key может и не быть в дереве
+	template <typename Q>
+	size_t rank(const Q& key) const
+		requires Ranked
+	{
+		size_t rank = 0;
+		const tree_node_base* node = header_.left;
+		while (node != nullptr)
+		{
+			if (compare_(key, key_of_(node)))
+			{
+				node = node->left;
+			}
+			else if (compare_(key_of_(node), key))
+			{
+				rank += count_of_(node->left) + 1;
+				node = node->right;
+			}
+			else
+			{
+				return rank + count_of_(node->left);
+			}
+		}
+		return rank;
+	}
+
+	// номер узла итератора; у end_node() — размер дерева
+	static size_t rank_of(tree_node_base* node) noexcept
+		requires Ranked
+	{
+		return climb_(node);
+	}
 
-	const tree_node<K, V>* get_root() const { return root_; }
+	// сдвиг итератора на n позиций: подъём к заголовку и спуск к номеру
+	static tree_node_base* advance(tree_node_base* node,
+								   std::ptrdiff_t n) noexcept
+		requires Ranked
+	{
+		size_t rank = climb_(node);
+		return select_(node, rank + static_cast<size_t>(n));
+	}
 
-	void print() { print_tree_(root_, 1); }
+	void print() { print_tree_(header_.left, 1); }
 
 	void inorder_print()
 	{
-		inorder_print(root_);
+		inorder_print(header_.left);
 		std::cout << "\n";
 	}
 
    private:
-	tree_node<K, V>* insert(const K& key,
-							const V& value,
-							tree_node<K, V>*& node)
+	// Высота AVL-дерева не больше 1.44 log2(N + 2): 64 уровням нужно больше
+	// 10^13 узлов, столько не поместится в память. Путь от корня до листа
+	// хранится на стеке, поэтому операции не выделяют памяти.
+	static constexpr size_t max_depth_ = 64;
+
+	static node_type* as_node_(tree_node_base* node) noexcept
+	{
+		return static_cast<node_type*>(node);
+	}
+
+	static const node_type* as_node_(const tree_node_base* node) noexcept
+	{
+		return static_cast<const node_type*>(node);
+	}
+
+	static const K& key_of_(const tree_node_base* node) noexcept
+	{
+		return as_node_(node)->data.first;
+	}
+
+	// Спуск к первому ключу больше key (Upper) или не меньше key: каждый
+	// подходящий узел запоминается, и поиск продолжается левее него.
+	template <bool Upper, typename Q>
+	tree_node_base* bound_(const Q& key)
+	{
+		tree_node_base* bound = &header_;
+		tree_node_base* node = header_.left;
+		while (node != nullptr)
+		{
+			if (Upper ? compare_(key, key_of_(node))
+					  : !compare_(key_of_(node), key))
+			{
+				bound = node;
+				node = node->left;
+			}
+			else
+			{
+				node = node->right;
+			}
+		}
+		return bound;
+	}
+
+	// Счётчики узлов есть только при Ranked: без него recount_* ничего не
+	// делают, а остальные функции не вызываются.
+	static ranked_node_base* ranked_(tree_node_base* node) noexcept
+	{
+		return static_cast<ranked_node_base*>(node);
+	}
+
+	static size_t count_of_(const tree_node_base* node) noexcept
+	{
+		return node != nullptr
+				   ? static_cast<const ranked_node_base*>(node)->count
+				   : 0;
+	}
+
+	// вставка или удаление меняет на единицу каждое поддерево на пути
+	static void recount_path_(tree_node_base** path[],
+							  size_t depth,
+							  bool grew) noexcept
+	{
+		if constexpr (Ranked)
+		{
+			for (size_t i = 0; i < depth; ++i)
+			{
+				size_t& count = ranked_(*path[i])->count;
+				count = grew ? count + 1 : count - 1;
+			}
+		}
+	}
+
+	// поворот: top занял место down и получил всё его поддерево
+	static void recount_rotated_(tree_node_base* top,
+								 tree_node_base* down) noexcept
+	{
+		if constexpr (Ranked)
+		{
+			ranked_(top)->count = ranked_(down)->count;
+			ranked_(down)->count =
+				count_of_(down->left) + count_of_(down->right) + 1;
+		}
+	}
+
+	// Номер node среди ключей по возрастанию: слева от него его левое
+	// поддерево и все предки, в чьё правое поддерево он входит (вместе с
+	// их левыми поддеревьями). Подъём останавливается на заголовке, у
+	// которого нет родителя, и оставляет его в node. Для самого заголовка
+	// номер равен размеру дерева: его левое поддерево — всё дерево.
+	static size_t climb_(tree_node_base*& node) noexcept
+	{
+		size_t rank = count_of_(node->left);
+		for (tree_node_base* parent = node->parent(); parent != nullptr;
+			 node = parent, parent = parent->parent())
+		{
+			if (node == parent->right)
+			{
+				rank += count_of_(parent->left) + 1;
+			}
+		}
+		return rank;
+	}
+
+	// узел с номером k или заголовок, если k не меньше размера дерева
+	static tree_node_base* select_(tree_node_base* header, size_t k) noexcept
+	{
+		tree_node_base* node = header->left;
+		if (k >= count_of_(node))
+		{
+			return header;
+		}
+		while (true)
+		{
+			size_t left = count_of_(node->left);
+			if (k == left)
+			{
+				return node;
+			}
+			if (k < left)
+			{
+				node = node->left;
+			}
+			else
+			{
+				k -= left + 1;
+				node = node->right;
+			}
+		}
+	}
+
+	// забирает узлы other; родителем корня становится свой заголовок
+	void adopt_(avl_balanced_tree& other) noexcept
+	{
+		header_.left = std::exchange(other.header_.left, nullptr);
+		size_ = std::exchange(other.size_, 0);
+		if (header_.left != nullptr)
+		{
+			header_.left->set_parent(&header_);
+		}
+	}
+
+	template <typename Q>
+	node_type* find_(const Q& key) const
+	{
+		tree_node_base* node = header_.left;
+		while (node != nullptr)
+		{
+			if (compare_(key, key_of_(node)))
+			{
+				node = node->left;
+			}
+			else if (compare_(key_of_(node), key))
+			{
+				node = node->right;
+			}
+			else
+			{
+				break;
+			}
+		}
+		return as_node_(node);
+	}
+
+	// Вынимает узел *link из дерева. Узел с двумя детьми заменяется
+	// минимумом правого поддерева: тот переезжает на его место целиком,
+	// ключи и значения не копируются. Путь до родителя минимума дописывается
+	// в path, балансировать нужно начиная с него. Возвращает ссылку, под
+	// которой поддерево стало на уровень ниже.
+	tree_node_base** unlink_(tree_node_base** link,
+				 tree_node_base** path[],
+				 size_t& depth)
+	{
+		tree_node_base* node = *link;
+		if (node->left == nullptr || node->right == nullptr)
+		{
+			tree_node_base* child =
+				node->left != nullptr ? node->left : node->right;
+			if (child != nullptr)
+			{
+				child->set_parent(node->parent());
+			}
+			*link = child;
+			return link;
+		}
+		size_t slot = depth;
+		path[depth++] = link;
+		tree_node_base** min_link = &node->right;
+		while ((*min_link)->left != nullptr)
+		{
+			path[depth++] = min_link;
+			min_link = &(*min_link)->left;
+		}
+		tree_node_base* min = *min_link;
+		*min_link = min->right;
+		if (min->right != nullptr)
+		{
+			min->right->set_parent(min->parent());
+		}
+		min->left = node->left;
+		min->right = node->right;
+		min->left->set_parent(min);
+		if (min->right != nullptr)
+		{
+			min->right->set_parent(min);
+		}
+		min->set_parent(node->parent());
+		min->set_balance(node->balance());
+		if constexpr (Ranked)
+		{
+			ranked_(min)->count = ranked_(node)->count;
+		}
+		*link = min;
+		// минимум был правым ребёнком node: укоротилось его правое поддерево
+		if (slot + 1 == depth)
+		{
+			return &min->right;
+		}
+		// ссылка node->right из пути теперь живёт в min
+		path[slot + 1] = &min->right;
+		return min_link;
+	}
+
+	// Поддерево под ссылкой child стало на уровень выше (grew) или ниже.
+	// Показатели баланса правятся снизу вверх по пути спуска за O(1) на
+	// узел; выше поддерева, чья высота не изменилась, балансы прежние.
+	void rebalance_(tree_node_base** path[],
+					size_t depth,
+					tree_node_base** child,
+					bool grew)
+	{
+		while (depth > 0)
+		{
+			tree_node_base*& node = *path[--depth];
+			bool from_left = child == &node->left;
+			int factor = node->balance() + (from_left == grew ? -1 : 1);
+			child = path[depth];
+			if (factor == 2 || factor == -2)
+			{
+				// после вставки поворот всегда возвращает прежнюю высоту
+				if (!balance(node, factor) || grew)
+				{
+					return;
+				}
+				continue;
+			}
+			node->set_balance(factor);
+			if ((factor == 0) == grew)
+			{
+				return;
+			}
+		}
+	}
+
+	// Разворачивает дерево в список по возрастанию ключей, связанный через
+	// right: правыми поворотами левые поддеревья переезжают на правую
+	// ветвь. Каждый узел поворачивается не больше раза, O(N) без памяти.
+	tree_node_base* flatten_() noexcept
 	{
-		// TODO: Реализовать вставку узла в AVL дерево
-		// 1. Если node == nullptr, создать новый узел
-		// 2. Рекурсивно вставить в левое или правое поддерево в зависимости от
-		// ключа
-		// 3. Обновить значение, если ключ уже существует
-		// 4. Вызвать balance(node) для балансировки
-		return nullptr;
+		tree_node_base** tail = &header_.left;
+		while (*tail != nullptr)
+		{
+			tree_node_base* node = *tail;
+			if (node->left != nullptr)
+			{
+				tree_node_base* left = node->left;
+				node->left = left->right;
+				left->right = node;
+				*tail = left;
+			}
+			else
+			{
+				tail = &node->right;
+			}
+		}
+		return std::exchange(header_.left, nullptr);
 	}
 
-	void remove(const K& key, tree_node<K, V>*& node)
+	// слияние двух списков через right с различными ключами
+	tree_node_base* merge_(tree_node_base* lhs,
+						   tree_node_base* rhs) const
 	{
-		// TODO: Реализовать удаление узла из AVL дерева
-		// 1. Найти узел с заданным ключом
-		// 2. Обработать 4 случая:
-		//    - Узел без детей (лист)
-		//    - Узел с одним ребенком (левым или правым)
-		//    - Узел с двумя детьми (заменить на минимальный из правого
-		//    поддерева)
-		// 3. Декрементировать size_
-		// 4. Вызвать balance(node) для балансировки
+		tree_node_base* head = nullptr;
+		tree_node_base** tail = &head;
+		while (lhs != nullptr && rhs != nullptr)
+		{
+			tree_node_base*& less =
+				compare_(key_of_(rhs), key_of_(lhs)) ? rhs : lhs;
+			*tail = less;
+			tail = &less->right;
+			less = less->right;
+		}
+		*tail = lhs != nullptr ? lhs : rhs;
+		return head;
 	}
 
-	tree_node<K, V>* find(const K& key, tree_node<K, V>* node) const
+	// Собирает из первых count узлов списка дерево, в котором корень
+	// каждого отрезка — его середина. Высота такого дерева из n узлов
+	// равна bit_width(n), отсюда показатели баланса. Стек отрезков не
+	// глубже высоты.
+	tree_node_base* build_(tree_node_base*& list, size_t count) noexcept
 	{
-		// TODO: Реализовать поиск узла по ключу
-		// Рекурсивно искать в левом или правом поддереве
-		return nullptr;
+		struct segment
+		{
+			size_t lo;
+			size_t hi;
+			// 0 — строится левая половина, 1 — правая, 2 — обе готовы
+			int stage;
+			tree_node_base* node;
+		};
+		segment stack[max_depth_];
+		size_t top = 0;
+		tree_node_base* done = nullptr;
+		if (count > 0)
+		{
+			stack[top++] = {0, count, 0, nullptr};
+		}
+		while (top > 0)
+		{
+			segment& s = stack[top - 1];
+			size_t mid = s.lo + (s.hi - s.lo) / 2;
+			if (s.stage == 0)
+			{
+				s.stage = 1;
+				done = nullptr;
+				if (s.lo < mid)
+				{
+					stack[top++] = {s.lo, mid, 0, nullptr};
+				}
+			}
+			else if (s.stage == 1)
+			{
+				s.stage = 2;
+				s.node = list;
+				list = list->right;
+				s.node->left = done;
+				if (done != nullptr)
+				{
+					done->set_parent(s.node);
+				}
+				done = nullptr;
+				if (mid + 1 < s.hi)
+				{
+					stack[top++] = {mid + 1, s.hi, 0, nullptr};
+				}
+			}
+			else
+			{
+				s.node->right = done;
+				if (done != nullptr)
+				{
+					done->set_parent(s.node);
+				}
+				s.node->set_balance(
+					static_cast<int>(std::bit_width(s.hi - mid - 1)) -
+					static_cast<int>(std::bit_width(mid - s.lo)));
+				if constexpr (Ranked)
+				{
+					ranked_(s.node)->count = s.hi - s.lo;
+				}
+				done = s.node;
+				--top;
+			}
+		}
+		return done;
 	}
 
-	tree_node<K, V>* findMinPtr(tree_node<K, V>* node)
+	tree_node_base* findMinPtr(tree_node_base* node)
 	{
-		// TODO: Найти узел с минимальным ключом в поддереве
-		// Подсказка: идти влево, пока возможно
-		return nullptr;
+		while (node != nullptr && node->left != nullptr)
+		{
+			node = node->left;
+		}
+		return node;
+	}
+
+	void rotateWithLeftChild(tree_node_base*& k2)
+	{
+		tree_node_base* k1 = k2->left;
+		k2->left = k1->right;
+		if (k2->left != nullptr)
+		{
+			k2->left->set_parent(k2);
+		}
+		k1->right = k2;
+		k1->set_parent(k2->parent());
+		k2->set_parent(k1);
+		recount_rotated_(k1, k2);
+		k2 = k1;
 	}
 
-	uint8_t heightOfTree(tree_node<K, V>* t)
+	void rotateWithRightChild(tree_node_base*& k1)
 	{
-		// TODO: Вычислить высоту дерева
-		// Высота пустого дерева = 0
-		// Высота дерева = 1 + max(высота левого, высота правого)
-		return 0;
+		tree_node_base* k2 = k1->right;
+		k1->right = k2->left;
+		if (k1->right != nullptr)
+		{
+			k1->right->set_parent(k1);
+		}
+		k2->left = k1;
+		k2->set_parent(k1->parent());
+		k1->set_parent(k2);
+		recount_rotated_(k2, k1);
+		k1 = k2;
 	}
 
-	void rotateWithLeftChild(tree_node<K, V>*& k2)
+	void doubleWithLeftChild(tree_node_base*& k3)
 	{
-		// TODO: Реализовать правый поворот (rotation with left child)
-		// Используется для балансировки Left-Left случая
+		rotateWithRightChild(k3->left);
+		rotateWithLeftChild(k3);
 	}
 
-	void rotateWithRightChild(tree_node<K, V>*& k1)
+	void doubleWithRightChild(tree_node_base*& k1)
 	{
-		// TODO: Реализовать левый поворот (rotation with right child)
-		// Используется для балансировки Right-Right случая
+		rotateWithLeftChild(k1->right);
+		rotateWithRightChild(k1);
 	}
 
-	void doubleWithLeftChild(tree_node<K, V>*& k3)
+	// Поддерево t перекошено на два уровня (factor = ±2, в узел ещё не
+	// записан). Повороты восстанавливают баланс, новые показатели
+	// вычисляются из старых без обхода поддеревьев. Возвращает true, если
+	// высота поддерева стала на единицу меньше, чем с перекосом.
+	bool balance(tree_node_base*& t, int factor)
 	{
-		// TODO: Реализовать двойной поворот Left-Right
-		// Сначала левый поворот на левом ребенке, затем правый поворот на узле
+		if (factor > 0 && t->right->balance() >= 0)
+		{
+			int child = t->right->balance();
+			rotateWithRightChild(t);
+			t->left->set_balance(1 - child);
+			t->set_balance(child - 1);
+			return child != 0;
+		}
+		if (factor < 0 && t->left->balance() <= 0)
+		{
+			int child = t->left->balance();
+			rotateWithLeftChild(t);
+			t->right->set_balance(-1 - child);
+			t->set_balance(child + 1);
+			return child != 0;
+		}
+		// двойной поворот: наверх поднимается внук
+		int grandchild = factor > 0 ? t->right->left->balance()
+									: t->left->right->balance();
+		if (factor > 0)
+		{
+			doubleWithRightChild(t);
+		}
+		else
+		{
+			doubleWithLeftChild(t);
+		}
+		t->left->set_balance(grandchild > 0 ? -1 : 0);
+		t->right->set_balance(grandchild < 0 ? 1 : 0);
+		t->set_balance(0);
+		return true;
 	}
 
-	void doubleWithRightChild(tree_node<K, V>*& k1)
+	node_type* create_node(const K& key, const V& value)
 	{
-		// TODO: Реализовать двойной поворот Right-Left
-		// Сначала правый поворот на правом ребенке, затем левый поворот на узле
+		node_type* node = node_traits::allocate(alloc_, 1);
+		try
+		{
+			node_traits::construct(alloc_, node, std::allocator_arg,
+								   get_allocator(), key, value);
+		}
+		catch (...)
+		{
+			node_traits::deallocate(alloc_, node, 1);
+			throw;
+		}
+		return node;
 	}
 
-	void balance(tree_node<K, V>*& t)
+	void destroy_node(node_type* node) noexcept
 	{
-		// TODO: Реализовать балансировку AVL дерева
-		// 1. Вычислить разность высот левого и правого поддеревьев
-		// 2. Если разность > 1, выполнить соответствующие повороты:
-		//    - Left-Left: rotateWithLeftChild
-		//    - Left-Right: doubleWithLeftChild
-		//    - Right-Right: rotateWithRightChild
-		//    - Right-Left: doubleWithRightChild
+		node_traits::destroy(alloc_, node);
+		node_traits::deallocate(alloc_, node, 1);
 	}
 
-	void inorder_print(tree_node<K, V>* node)
+	tree_node_base* clone(const tree_node_base* node, tree_node_base* parent)
 	{
 		if (node == nullptr)
 		{
-			return;
+			return nullptr;
+		}
+		const auto& [key, value] = as_node_(node)->data;
+		node_type* copy = create_node(key, value);
+		copy->set_parent(parent);
+		copy->set_balance(node->balance());
+		if constexpr (Ranked)
+		{
+			ranked_(copy)->count = count_of_(node);
+		}
+		try
+		{
+			copy->left = clone(node->left, copy);
+			copy->right = clone(node->right, copy);
 		}
-		inorder_print(node->left);
-		std::cout << "[" << node->key << ":" << node->value << "] ";
-		inorder_print(node->right);
+		catch (...)
+		{
+			clear(copy);
+			throw;
+		}
+		return copy;
 	}
 
-	void clear(tree_node<K, V>* node)
+	void inorder_print(tree_node_base* node)
 	{
-		if (node != nullptr)
+		tree_node_base* stack[max_depth_];
+		size_t top = 0;
+		while (node != nullptr || top > 0)
 		{
-			clear(node->left);
-			clear(node->right);
-			delete node;
+			for (; node != nullptr; node = node->left)
+			{
+				stack[top++] = node;
+			}
+			node = stack[--top];
+			const auto& [key, value] = as_node_(node)->data;
+			std::cout << "[" << key << ":" << value << "] ";
+			node = node->right;
 		}
 	}
 
-	void print_tree_(tree_node<K, V>* node, int space)
+	// Разрушение без рекурсии: узел освобождается сразу после того, как
+	// его дети отложены в стек. На каждом уровне ждёт не больше одного
+	// брата, поэтому стеку хватает высоты дерева плюс одного места.
+	void clear(tree_node_base* node) noexcept
 	{
 		if (node == nullptr)
 		{
 			return;
 		}
-		space += 5;
-		this->print_tree_(node->right, space);
-		for (int i = 0; i < space; ++i)
+		tree_node_base* stack[max_depth_ + 1];
+		size_t top = 0;
+		stack[top++] = node;
+		while (top > 0)
+		{
+			node = stack[--top];
+			if (node->right != nullptr)
+			{
+				stack[top++] = node->right;
+			}
+			if (node->left != nullptr)
+			{
+				stack[top++] = node->left;
+			}
+			destroy_node(as_node_(node));
+		}
+	}
+
+	// обратный симметричный обход (правое поддерево выше левого), в стеке
+	// рядом с узлом хранится его отступ
+	void print_tree_(tree_node_base* node, int space)
+	{
+		std::pair<tree_node_base*, int> stack[max_depth_];
+		size_t top = 0;
+		while (node != nullptr || top > 0)
 		{
-			std::cout << " ";
+			for (; node != nullptr; node = node->right)
+			{
+				space += 5;
+				stack[top++] = {node, space};
+			}
+			std::tie(node, space) = stack[--top];
+			for (int i = 0; i < space; ++i)
+			{
+				std::cout << " ";
+			}
+			const auto& [key, value] = as_node_(node)->data;
+			std::cout << key << ":" << value << "\n";
+			node = node->left;
 		}
-		std::cout << node->key << ":" << node->value << "\n";
-		this->print_tree_(node->left, space);
 	}
 
-	tree_node<K, V>* root_ = nullptr;
+	[[no_unique_address]] node_allocator alloc_;
+	[[no_unique_address]] Compare compare_;
+	link_type header_;
 	size_t size_ = 0;
 };
 
@@ -236,127 +1133,179 @@ class avl_balanced_tree
 // Используя реализованное AVL-дерево, создайте полноценный аналог std::map
 // с поддержкой вставки, удаления, поиска и итерации по элементам в порядке
 // возрастания ключей.
-template <typename K, typename V>
+template <typename K,
+		  typename V,
+		  typename Compare = std::less<K>,
+		  typename Allocator = std::allocator<std::pair<const K, V>>,
+		  bool Ranked = false>
 class map
 {
+	using tree_type = avl_balanced_tree<K, V, Compare, Allocator, Ranked>;
+
+	// Compare сравнивает K с другими типами (std::less<> и подобные)
+	static constexpr bool transparent_ =
+		requires { typename Compare::is_transparent; };
+
    public:
 	using key_type = K;
 	using mapped_type = V;
 	using value_type = std::pair<const K, V>;
+	using key_compare = Compare;
+	using allocator_type = Allocator;
 
 	// ==================== Iterator ====================
-	// ЗАДАНИЕ ДЛЯ СТУДЕНТОВ:
-	// Реализуйте итератор для обхода элементов map в порядке возрастания ключей
-	// (in-order обход AVL дерева). Итератор должен поддерживать операции
-	// инкремента и разыменования.
-	struct iterator : public abstract_iterator<iterator,
-											   std::pair<const K, V>,
-											   std::bidirectional_iterator_tag>
+	// Итератор — один указатель на узел. ++ и -- идут по ссылкам на
+	// родителя (амортизированно O(1)), end() — заголовок дерева, поэтому
+	// --end() даёт наибольший ключ. Разыменование возвращает ссылку на пару
+	// в узле; итератор остаётся действительным, пока его узел не удалён.
+	template <bool Const>
+	class basic_iterator
 	{
-		tree_node<K, V>* current_;
-		std::stack<tree_node<K, V>*> stack_;
-		mutable typename iterator::value_type pair_cache_;
-
-		iterator() : current_(nullptr), pair_cache_(K{}, V{}) {}
-
-		explicit iterator(tree_node<K, V>* root, bool is_end = false)
-			: current_(nullptr), pair_cache_(K{}, V{})
+		using node_type =
+			std::conditional_t<Const,
+							   const typename tree_type::node_type,
+							   typename tree_type::node_type>;
+
+	   public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = std::pair<const K, V>;
+		using difference_type = std::ptrdiff_t;
+		using pointer =
+			std::conditional_t<Const, const value_type*, value_type*>;
+		using reference =
+			std::conditional_t<Const, const value_type&, value_type&>;
+
+		basic_iterator() = default;
+
+		operator basic_iterator<true>() const noexcept
+			requires(!Const)
 		{
-			// TODO: Реализовать инициализацию итератора
-			// Для begin(): нужно найти самый левый узел
-			// Для end(): current_ должен остаться nullptr
+			return basic_iterator<true>(node_);
 		}
 
-		typename iterator::reference operator*() const override
+		reference operator*() const noexcept
 		{
-			// TODO: Реализовать разыменование
-			// Нужно вернуть std::pair<const K, V> с текущим ключом и значением
-			return pair_cache_;
+			return static_cast<node_type*>(node_)->data;
 		}
 
-		typename iterator::pointer operator->() const override
-		{
-			// TODO: Реализовать оператор стрелки
-			return &pair_cache_;
-		}
+		pointer operator->() const noexcept { return &**this; }
 
-		iterator& operator++() override
+		basic_iterator& operator++() noexcept
 		{
-			// TODO: Реализовать переход к следующему элементу (in-order)
-			// Подсказка: используйте стек для обхода дерева
+			node_ = node_->next();
 			return *this;
 		}
 
-		iterator operator++(int) override
+		basic_iterator operator++(int) noexcept
 		{
-			iterator temp = *this;
-			++(*this);
-			return temp;
+			basic_iterator copy(*this);
+			++*this;
+			return copy;
 		}
 
-		iterator& operator--() override
+		basic_iterator& operator--() noexcept
 		{
-			// Необязательно для bidirectional_iterator в этой реализации
+			node_ = node_->prev();
 			return *this;
 		}
 
-		iterator operator--(int) override
+		basic_iterator operator--(int) noexcept
 		{
-			// Необязательно для bidirectional_iterator в этой реализации
-			return *this;
+			basic_iterator copy(*this);
+			--*this;
+			return copy;
 		}
 
-		iterator& operator+=(
-			const typename iterator::difference_type& n) override
+		friend bool operator==(const basic_iterator& lhs,
+							   const basic_iterator& rhs) noexcept
 		{
-			// Не требуется для bidirectional_iterator
-			return *this;
+			return lhs.node_ == rhs.node_;
 		}
 
-		iterator& operator-=(
-			const typename iterator::difference_type& n) override
+		// Сдвиг и расстояние за O(log N) по счётчикам поддеревьев, только
+		// в ranked::map. Категория остаётся двунаправленной: std::advance
+		// и std::distance о них не знают, пользуйтесь += и - напрямую.
+		basic_iterator& operator+=(difference_type n) noexcept
+			requires Ranked
 		{
-			// Не требуется для bidirectional_iterator
+			node_ = tree_type::advance(node_, n);
 			return *this;
 		}
 
-		iterator operator+(
-			const typename iterator::difference_type& n) const override
+		basic_iterator& operator-=(difference_type n) noexcept
+			requires Ranked
 		{
-			// Не требуется для bidirectional_iterator
-			return *this;
+			return *this += -n;
 		}
 
-		iterator operator-(
-			const typename iterator::difference_type& n) const override
+		friend basic_iterator operator+(basic_iterator it,
+										difference_type n) noexcept
+			requires Ranked
 		{
-			// Не требуется для bidirectional_iterator
-			return *this;
+			return it += n;
 		}
 
-		bool operator==(const iterator& other) const override
+		friend basic_iterator operator+(difference_type n,
+										basic_iterator it) noexcept
+			requires Ranked
 		{
-			return current_ == other.current_;
+			return it += n;
 		}
 
-		bool operator!=(const iterator& other) const override
+		friend basic_iterator operator-(basic_iterator it,
+										difference_type n) noexcept
+			requires Ranked
 		{
-			return current_ != other.current_;
+			return it -= n;
 		}
 
-		explicit operator bool() const override { return current_ != nullptr; }
-
-		typename iterator::difference_type operator-(
-			const iterator& other) const override
+		friend difference_type operator-(const basic_iterator& lhs,
+										 const basic_iterator& rhs) noexcept
+			requires Ranked
 		{
-			// Не требуется точное вычисление для bidirectional_iterator
-			return 0;
+			return static_cast<difference_type>(
+					   tree_type::rank_of(lhs.node_)) -
+				   static_cast<difference_type>(tree_type::rank_of(rhs.node_));
 		}
+
+	   private:
+		friend class map;
+		friend class basic_iterator<!Const>;
+
+		explicit basic_iterator(tree_node_base* node) noexcept : node_(node) {}
+
+		tree_node_base* node_ = nullptr;
 	};
 
+	using iterator = basic_iterator<false>;
+	using const_iterator = basic_iterator<true>;
+
 	map() = default;
+
+	explicit map(const Allocator& alloc) : tree_(alloc) {}
+
+	explicit map(const Compare& compare, const Allocator& alloc = Allocator())
+		: tree_(compare, alloc)
+	{
+	}
+
+	map(const map& other) = default;
+
+	map(map&& other) noexcept = default;
+
+	map& operator=(const map& other) = default;
+
+	map& operator=(map&& other) = default;
+
 	~map() = default;
 
+	allocator_type get_allocator() const noexcept
+	{
+		return tree_.get_allocator();
+	}
+
+	key_compare key_comp() const { return tree_.key_comp(); }
+
 	void insert(const K& key, const V& value) { tree_.insert(key, value); }
 
 	void insert(const value_type& pair)
@@ -364,6 +1313,48 @@ class map
 		tree_.insert(pair.first, pair.second);
 	}
 
+	// Пары с ключами по неубыванию вставляются за O(N + M) сборкой
+	// сбалансированного дерева, см. avl_balanced_tree::insert_sorted.
+	// Неупорядоченный или однопроходный диапазон сначала копируется и
+	// устойчиво сортируется (O(M log M)). Из равных ключей остаётся
+	// последний.
+	template <std::ranges::input_range R>
+	void insert_sorted(R&& range)
+	{
+		auto first = std::ranges::begin(range);
+		auto last = std::ranges::end(range);
+		if constexpr (std::ranges::forward_range<R>)
+		{
+			if (sorted_by_key_(first, last))
+			{
+				tree_.insert_sorted(first, last);
+				return;
+			}
+		}
+		simple_vector<std::pair<K, V>> buffer(first, last);
+		const Compare& compare = tree_.key_comp();
+		std::stable_sort(buffer.begin(), buffer.end(),
+						 [&compare](const auto& lhs, const auto& rhs) {
+							 return compare(lhs.first, rhs.first);
+						 });
+		tree_.insert_sorted(buffer.begin(), buffer.end());
+	}
+
+	template <std::input_iterator It, std::sentinel_for<It> S>
+	static map from_sorted(It first,
+						   S last,
+						   const Allocator& alloc = Allocator())
+	{
+		map result(alloc);
+		result.insert_sorted(std::ranges::subrange(first, last));
+		return result;
+	}
+
+	// Поиск. Если в Compare объявлен is_transparent (например, std::less<>),
+	// operator[], find, at, contains и границы принимают кроме K любой
+	// сравнимый с ним тип Q: строковый ключ ищется по const char* или
+	// string_view без временного K и его выделений памяти. operator[]
+	// строит ключ из Q только для вставки нового.
 	V& operator[](const K& key)
 	{
 		auto node = tree_.find(key);
@@ -372,39 +1363,56 @@ class map
 			tree_.insert(key, V());
 			node = tree_.find(key);
 		}
-		return node->value;
+		return node->data.second;
 	}
 
-	V* find(const K& key)
+	template <typename Q>
+		requires transparent_ && std::constructible_from<K, const Q&>
+	V& operator[](const Q& key)
 	{
 		auto node = tree_.find(key);
-		return node ? &node->value : nullptr;
+		if (node == nullptr)
+		{
+			tree_.insert(K(key), V());
+			node = tree_.find(key);
+		}
+		return node->data.second;
 	}
 
-	const V* find(const K& key) const
+	V* find(const K& key) { return value_of_(tree_.find(key)); }
+
+	const V* find(const K& key) const { return value_of_(tree_.find(key)); }
+
+	template <typename Q>
+		requires transparent_
+	V* find(const Q& key)
 	{
-		auto node = tree_.find(key);
-		return node ? &node->value : nullptr;
+		return value_of_(tree_.find(key));
 	}
 
-	V& at(const K& key)
+	template <typename Q>
+		requires transparent_
+	const V* find(const Q& key) const
 	{
-		auto node = tree_.find(key);
-		if (node == nullptr)
-		{
-			throw std::out_of_range("Key not found in map");
-		}
-		return node->value;
+		return value_of_(tree_.find(key));
 	}
 
-	const V& at(const K& key) const
+	V& at(const K& key) { return at_(key); }
+
+	const V& at(const K& key) const { return const_cast<map*>(this)->at_(key); }
+
+	template <typename Q>
+		requires transparent_
+	V& at(const Q& key)
 	{
-		auto node = tree_.find(key);
-		if (node == nullptr)
-		{
-			throw std::out_of_range("Key not found in map");
-		}
-		return node->value;
+		return at_(key);
+	}
+
+	template <typename Q>
+		requires transparent_
+	const V& at(const Q& key) const
+	{
+		return const_cast<map*>(this)->at_(key);
 	}
 
 	// Удаление
@@ -413,29 +1421,245 @@ class map
 	// Проверка наличия ключа
 	bool contains(const K& key) const { return tree_.contains(key); }
 
+	template <typename Q>
+		requires transparent_
+	bool contains(const Q& key) const
+	{
+		return tree_.contains(key);
+	}
+
 	// Размер и проверка на пустоту
 	size_t size() const { return tree_.size(); }
 
 	bool empty() const { return tree_.empty(); }
 
 	// Очистка
-	void clear()
-	{
-		tree_.~avl_balanced_tree();
-		new (&tree_) avl_balanced_tree<K, V>();
-	}
+	void clear() { tree_.clear(); }
 
 	void print() { tree_.print(); }
 
 	void inorder_print() { tree_.inorder_print(); }
 
 	// Итераторы
-	iterator begin() { return iterator(tree_.get_root(), false); }
+	iterator begin() noexcept { return iterator(tree_.begin_node()); }
+
+	iterator end() noexcept { return iterator(tree_.end_node()); }
+
+	// дерево не меняется, константность пары задаёт const_iterator
+	const_iterator begin() const noexcept
+	{
+		return const_cast<map*>(this)->begin();
+	}
+
+	const_iterator end() const noexcept
+	{
+		return const_cast<map*>(this)->end();
+	}
+
+	const_iterator cbegin() const noexcept { return begin(); }
+
+	const_iterator cend() const noexcept { return end(); }
+
+	// ==================== Поиск по границам ====================
+	// Спуск от корня за O(log N), дальше обход по итератору: просмотр k
+	// пар стоит O(log N + k) и не трогает остальное дерево.
+
+	// первый ключ не меньше key или end()
+	iterator lower_bound(const K& key)
+	{
+		return iterator(tree_.lower_bound(key));
+	}
+
+	const_iterator lower_bound(const K& key) const
+	{
+		return const_cast<map*>(this)->lower_bound(key);
+	}
+
+	template <typename Q>
+		requires transparent_
+	iterator lower_bound(const Q& key)
+	{
+		return iterator(tree_.lower_bound(key));
+	}
 
-	iterator end() { return iterator(tree_.get_root(), true); }
+	template <typename Q>
+		requires transparent_
+	const_iterator lower_bound(const Q& key) const
+	{
+		return const_cast<map*>(this)->lower_bound(key);
+	}
+
+	// первый ключ больше key или end()
+	iterator upper_bound(const K& key)
+	{
+		return iterator(tree_.upper_bound(key));
+	}
+
+	const_iterator upper_bound(const K& key) const
+	{
+		return const_cast<map*>(this)->upper_bound(key);
+	}
+
+	template <typename Q>
+		requires transparent_
+	iterator upper_bound(const Q& key)
+	{
+		return iterator(tree_.upper_bound(key));
+	}
+
+	template <typename Q>
+		requires transparent_
+	const_iterator upper_bound(const Q& key) const
+	{
+		return const_cast<map*>(this)->upper_bound(key);
+	}
+
+	// Пара с ключом key в виде полуинтервала итераторов: ключи уникальны,
+	// поэтому хватает одного спуска и шага вперёд, если ключ найден.
+	std::pair<iterator, iterator> equal_range(const K& key)
+	{
+		return equal_range_(key);
+	}
+
+	std::pair<const_iterator, const_iterator> equal_range(const K& key) const
+	{
+		return const_cast<map*>(this)->equal_range_(key);
+	}
+
+	template <typename Q>
+		requires transparent_
+	std::pair<iterator, iterator> equal_range(const Q& key)
+	{
+		return equal_range_(key);
+	}
+
+	template <typename Q>
+		requires transparent_
+	std::pair<const_iterator, const_iterator> equal_range(const Q& key) const
+	{
+		return const_cast<map*>(this)->equal_range_(key);
+	}
+
+	// Пары с ключами из [lo, hi) как диапазон для range-for и алгоритмов
+	// std::ranges. При hi <= lo диапазон пуст. В ranked::map у него есть
+	// size() за O(log N).
+	std::ranges::subrange<iterator> range(const K& lo, const K& hi)
+	{
+		iterator first = lower_bound(lo);
+		return {first, key_comp()(lo, hi) ? lower_bound(hi) : first};
+	}
+
+	std::ranges::subrange<const_iterator> range(const K& lo,
+												const K& hi) const
+	{
+		return const_cast<map*>(this)->range(lo, hi);
+	}
+
+	// ==================== Порядковые статистики ====================
+	// Только в ranked::map (Ranked = true), каждая операция за O(log N).
+
+	// итератор на k-й по возрастанию ключ (с нуля), end() при k >= size()
+	iterator nth(size_t k) noexcept
+		requires Ranked
+	{
+		return iterator(tree_.select(k));
+	}
+
+	const_iterator nth(size_t k) const noexcept
+		requires Ranked
+	{
+		return const_cast<map*>(this)->nth(k);
+	}
+
+	// число ключей меньше key, то есть номер key, если он есть в словаре
+	size_t rank(const K& key) const
+		requires Ranked
+	{
+		return tree_.rank(key);
+	}
+
+	// число ключей в полуинтервале [lo, hi)
+	size_t count_range(const K& lo, const K& hi) const
+		requires Ranked
+	{
+		return key_comp()(lo, hi) ? tree_.rank(hi) - tree_.rank(lo) : 0;
+	}
 
    private:
-	avl_balanced_tree<K, V> tree_;
+	template <typename Node>
+	static auto value_of_(Node* node) noexcept
+	{
+		return node != nullptr ? &node->data.second : nullptr;
+	}
+
+	template <typename Q>
+	V& at_(const Q& key)
+	{
+		auto node = tree_.find(key);
+		if (node == nullptr)
+		{
+			throw std::out_of_range("Key not found in map");
+		}
+		return node->data.second;
+	}
+
+	template <typename Q>
+	std::pair<iterator, iterator> equal_range_(const Q& key)
+	{
+		iterator first = lower_bound(key);
+		iterator last = first;
+		if (last != end() && !tree_.key_comp()(key, last->first))
+		{
+			++last;
+		}
+		return {first, last};
+	}
+
+	template <typename It, typename S>
+	bool sorted_by_key_(It first, S last) const
+	{
+		if (first == last)
+		{
+			return true;
+		}
+		const Compare& compare = tree_.key_comp();
+		for (It next = std::next(first); next != last; first = next++)
+		{
+			if (compare((*next).first, (*first).first))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	tree_type tree_;
 };
 
+namespace pmr
+{
+template <typename K, typename V, typename Compare = std::less<K>>
+using map = bmstu::map<K,
+					   V,
+					   Compare,
+					   std::pmr::polymorphic_allocator<std::pair<const K, V>>>;
+}  // namespace pmr
+
+// узлы дерева берутся из собственного пула словаря, см. bmstu::node_pool
+namespace pooled
+{
+template <typename K, typename V, typename Compare = std::less<K>>
+using map = bmstu::map<K, V, Compare, pool_allocator<std::pair<const K, V>>>;
+}  // namespace pooled
+
+// словарь с порядковыми статистиками: nth, rank, count_range и сдвиг
+// итераторов за O(log N) ценой слова на узел
+namespace ranked
+{
+template <typename K,
+		  typename V,
+		  typename Compare = std::less<K>,
+		  typename Allocator = std::allocator<std::pair<const K, V>>>
+using map = bmstu::map<K, V, Compare, Allocator, true>;
+}  // namespace ranked
 }  // namespace bmstu
\ No newline at end of file
@@ -1,9 +1,18 @@
 #include "bmstu_map.h"
 
 #include <gtest/gtest.h>
+#include <memory_resource>
 #include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <map>
+#include <random>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
+#include "bmstu_sso_string.h"
 
 TEST(MapTest, BasicInsertAndAccess)
 {
@@ -348,4 +357,608 @@ TEST(MapTest, RangeBasedForDemo)
 
 	EXPECT_EQ(catalog.size(), 5);
 	EXPECT_EQ(catalog["apple"], "fruit");
-}
\ No newline at end of file
+}
+
+TEST(MapTest, PmrMonotonicBuffer)
+{
+	// вышестоящий ресурс запрещает выделения: всё должно уместиться в буфер
+	std::byte buffer[32 * 1024];
+	std::pmr::monotonic_buffer_resource arena(
+		buffer, sizeof(buffer), std::pmr::null_memory_resource());
+
+	bmstu::pmr::map<int, std::pmr::string> map(&arena);
+	for (int i = 0; i < 100; ++i)
+	{
+		map[i] = std::pmr::string(40, static_cast<char>('a' + i % 26));
+	}
+	ASSERT_EQ(map.size(), 100u);
+	ASSERT_EQ(map.get_allocator().resource(), &arena);
+	ASSERT_EQ(map.at(27), std::pmr::string(40, 'b'));
+	ASSERT_EQ(map.at(27).get_allocator().resource(), &arena);
+	map.erase(27);
+	ASSERT_FALSE(map.contains(27));
+	ASSERT_EQ(map.size(), 99u);
+}
+
+TEST(MapTest, CopyIsDeep)
+{
+	bmstu::map<int, std::string> map;
+	for (int i = 0; i < 50; ++i)
+	{
+		map[i] = std::to_string(i);
+	}
+
+	bmstu::map<int, std::string> copy(map);
+	map.erase(10);
+	map[20] = "changed";
+	ASSERT_EQ(copy.size(), 50u);
+	ASSERT_EQ(copy.at(10), "10");
+	ASSERT_EQ(copy.at(20), "20");
+
+	bmstu::map<int, std::string> moved(std::move(copy));
+	ASSERT_EQ(moved.size(), 50u);
+	ASSERT_TRUE(copy.empty());
+}
+
+TEST(MapTest, PooledNodes)
+{
+	bmstu::pool_allocator<std::pair<const int, int>> alloc(128);
+	bmstu::pooled::map<int, int> map(alloc);
+	for (int round = 0; round < 10; ++round)
+	{
+		for (int i = 0; i < 100; ++i)
+		{
+			map[round * 100 + i] = i;
+		}
+		for (int i = 0; i < 100; ++i)
+		{
+			map.erase(round * 100 + i);
+		}
+	}
+	// каждый раунд заново занимает освобождённые узлы
+	ASSERT_TRUE(map.empty());
+	ASSERT_EQ(alloc.block_count(), 1u);
+
+	map[1] = 10;
+	map[2] = 20;
+	bmstu::pooled::map<int, int> copy(map);
+	map.erase(1);
+	ASSERT_EQ(copy.at(1), 10);
+	ASSERT_EQ(copy.size(), 2u);
+}
+
+
+// высота поддерева, если оно упорядочено, сбалансировано, а показатели
+// баланса и ссылки на родителя верны, иначе -1
+static int checked_height(const bmstu::tree_node_base* node,
+						  const bmstu::tree_node_base* parent,
+						  const int* low,
+						  const int* high)
+{
+	if (node == nullptr)
+	{
+		return 0;
+	}
+	const int& key = static_cast<const bmstu::tree_node<int, int>*>(node)
+						 ->data.first;
+	if (node->parent() != parent || (low && !(*low < key)) ||
+		(high && !(key < *high)))
+	{
+		return -1;
+	}
+	int left = checked_height(node->left, node, low, &key);
+	int right = checked_height(node->right, node, &key, high);
+	if (left < 0 || right < 0 || std::abs(left - right) > 1 ||
+		node->balance() != right - left)
+	{
+		return -1;
+	}
+	return std::max(left, right) + 1;
+}
+
+// у корня родитель — заголовок дерева, его адрес даёт end()
+template <typename Tree>
+static bool is_valid(Tree& tree)
+{
+	return checked_height(tree.get_root(), tree.end_node(), nullptr,
+						  nullptr) >= 0;
+}
+
+TEST(MapTest, TreeStaysBalancedUnderChurn)
+{
+	bmstu::avl_balanced_tree<int, int> tree;
+	std::map<int, int> expected;
+	std::mt19937 gen(11);
+	for (int step = 0; step < 20000; ++step)
+	{
+		int key = static_cast<int>(gen() % 2000);
+		if (gen() % 3 == 0)
+		{
+			tree.remove(key);
+			expected.erase(key);
+		}
+		else
+		{
+			tree.insert(key, step);
+			expected[key] = step;
+		}
+		if (step % 500 == 0)
+		{
+			ASSERT_TRUE(is_valid(tree));
+		}
+	}
+	ASSERT_TRUE(is_valid(tree));
+	ASSERT_EQ(tree.size(), expected.size());
+	for (const auto& [key, value] : expected)
+	{
+		const auto* node = tree.find(key);
+		ASSERT_NE(node, nullptr);
+		ASSERT_EQ(node->data.second, value);
+	}
+	ASSERT_EQ(tree.find(-1), nullptr);
+}
+
+TEST(MapTest, IteratorPointsIntoNode)
+{
+	using map_type = bmstu::map<int, int>;
+	static_assert(sizeof(map_type::iterator) == sizeof(void*));
+	static_assert(std::is_trivially_copyable_v<map_type::iterator>);
+	static_assert(std::bidirectional_iterator<map_type::iterator>);
+	static_assert(std::bidirectional_iterator<map_type::const_iterator>);
+
+	map_type map;
+	std::vector<int> keys(200);
+	for (int i = 0; i < 200; ++i)
+	{
+		keys[i] = i;
+	}
+	std::shuffle(keys.begin(), keys.end(), std::mt19937(5));
+	for (int key : keys)
+	{
+		map[key] = key * 10;
+	}
+
+	// изменения через итератор попадают в словарь
+	auto it = map.begin();
+	it->second = -1;
+	ASSERT_EQ(&it->second, map.find(0));
+	ASSERT_EQ(map.at(0), -1);
+
+	// удаление других ключей не трогает узел итератора
+	auto kept = std::next(map.begin(), 100);
+	for (int key = 0; key < 200; key += 3)
+	{
+		map.erase(key);
+	}
+	ASSERT_EQ(kept->first, 100);
+	ASSERT_EQ(&kept->second, map.find(100));
+
+	std::vector<int> forward;
+	for (auto i = map.cbegin(); i != map.cend(); ++i)
+	{
+		forward.push_back(i->first);
+	}
+	std::vector<int> backward;
+	for (auto i = map.end(); i != map.begin();)
+	{
+		backward.push_back((--i)->first);
+	}
+	std::reverse(backward.begin(), backward.end());
+	ASSERT_EQ(forward.size(), map.size());
+	ASSERT_TRUE(std::is_sorted(forward.begin(), forward.end()));
+	ASSERT_EQ(forward, backward);
+
+	map_type::const_iterator first = map.begin();
+	ASSERT_EQ(first, map.cbegin());
+	ASSERT_EQ(std::prev(map.cend())->first, 199);
+}
+
+TEST(MapTest, InsertSortedBuildsBalancedTree)
+{
+	for (int count : {0, 1, 2, 3, 7, 8, 100, 1000})
+	{
+		std::vector<std::pair<int, int>> pairs;
+		for (int i = 0; i < count; ++i)
+		{
+			pairs.emplace_back(i * 2, i);
+		}
+		bmstu::avl_balanced_tree<int, int> tree;
+		tree.insert_sorted(pairs.begin(), pairs.end());
+		ASSERT_TRUE(is_valid(tree)) << count;
+		ASSERT_EQ(tree.size(), static_cast<size_t>(count));
+
+		// слияние с имеющимися ключами: чётные совпадают, нечётные новые
+		std::vector<std::pair<int, int>> more;
+		for (int i = 0; i < count; ++i)
+		{
+			more.emplace_back(i, -i);
+		}
+		tree.insert_sorted(more.begin(), more.end());
+		ASSERT_TRUE(is_valid(tree)) << count;
+		for (int key = 0; key < 2 * count; ++key)
+		{
+			const auto* node = tree.find(key);
+			if (key < count)
+			{
+				ASSERT_EQ(node->data.second, -key);
+			}
+			else if (key % 2 == 0)
+			{
+				ASSERT_EQ(node->data.second, key / 2);
+			}
+			else
+			{
+				ASSERT_EQ(node, nullptr);
+			}
+		}
+		ASSERT_EQ(tree.size(), static_cast<size_t>(count + count / 2));
+
+		// несколько пар в большое дерево вставляются по одной
+		std::vector<std::pair<int, int>> few = {{-1, 1}, {0, 7}};
+		tree.insert_sorted(few.begin(), few.end());
+		ASSERT_TRUE(is_valid(tree)) << count;
+		ASSERT_EQ(tree.find(0)->data.second, 7);
+	}
+}
+
+// сравнение, которое бросает после заданного числа вызовов
+struct limited_less
+{
+	inline static int budget = -1;
+
+	bool operator()(int left, int right) const
+	{
+		if (budget == 0)
+		{
+			throw std::runtime_error("compare");
+		}
+		if (budget > 0)
+		{
+			--budget;
+		}
+		return left < right;
+	}
+};
+
+TEST(MapTest, InsertSortedLeavesValidTreeOnThrow)
+{
+	std::vector<std::pair<int, int>> few = {{1, -1}, {2, -2}, {3, -3}};
+	std::vector<std::pair<int, int>> many;
+	for (int i = 0; i < 300; ++i)
+	{
+		many.emplace_back(i, -i);
+	}
+	for (const auto* pairs : {&few, &many})
+	{
+		for (int budget = 0; budget < 1000; budget += 7)
+		{
+			bmstu::avl_balanced_tree<int, int, limited_less> tree;
+			for (int key = 0; key < 400; key += 2)
+			{
+				tree.insert(key, key);
+			}
+			limited_less::budget = budget;
+			try
+			{
+				tree.insert_sorted(pairs->begin(), pairs->end());
+			}
+			catch (const std::runtime_error&)
+			{
+			}
+			limited_less::budget = -1;
+
+			ASSERT_TRUE(is_valid(tree)) << budget;
+			size_t walked = 0;
+			for (auto* node = tree.begin_node(); node != tree.end_node();
+				 node = node->next())
+			{
+				++walked;
+			}
+			ASSERT_EQ(walked, tree.size()) << budget;
+			for (int key = 0; key < 400; key += 2)
+			{
+				ASSERT_TRUE(tree.contains(key)) << key;
+			}
+		}
+	}
+}
+
+TEST(MapTest, FromSortedSortsAndKeepsLastDuplicate)
+{
+	std::vector<std::pair<int, std::string>> pairs = {
+		{5, "five"}, {1, "one"}, {3, "three"}, {1, "uno"}, {4, "four"}};
+	auto map = bmstu::map<int, std::string>::from_sorted(pairs.begin(),
+														  pairs.end());
+	ASSERT_EQ(map.size(), 4u);
+	ASSERT_EQ(map.at(1), "uno");
+	std::vector<int> keys;
+	for (const auto& [key, value] : map)
+	{
+		keys.push_back(key);
+	}
+	ASSERT_EQ(keys, (std::vector<int>{1, 3, 4, 5}));
+
+	// уже упорядоченный вход с повтором и вставка в непустой словарь
+	std::vector<std::pair<int, std::string>> sorted = {
+		{0, "zero"}, {3, "drei"}, {3, "tres"}, {9, "nine"}};
+	map.insert_sorted(sorted);
+	ASSERT_EQ(map.size(), 6u);
+	ASSERT_EQ(map.at(3), "tres");
+	ASSERT_EQ(map.at(9), "nine");
+	ASSERT_EQ(map.begin()->first, 0);
+	ASSERT_EQ(std::prev(map.end())->first, 9);
+}
+
+TEST(MapTest, RankedMapAnswersOrderStatistics)
+{
+	using ranked_map = bmstu::ranked::map<int, int>;
+	static_assert(sizeof(bmstu::tree_node<int, int, true>) ==
+				  sizeof(bmstu::tree_node<int, int>) + sizeof(size_t));
+
+	// каждая выборка сверяется с отсортированными ключами эталона
+	auto check = [](ranked_map& map, const std::map<int, int>& expected)
+	{
+		ASSERT_EQ(map.size(), expected.size());
+		auto it = map.begin();
+		size_t k = 0;
+		for (const auto& [key, value] : expected)
+		{
+			ASSERT_EQ(map.nth(k)->first, key);
+			ASSERT_EQ(map.rank(key), k);
+			ASSERT_EQ(map.rank(key + 1), k + 1);
+			ASSERT_EQ(it - map.begin(), static_cast<std::ptrdiff_t>(k));
+			ASSERT_EQ(map.begin() + static_cast<std::ptrdiff_t>(k), it);
+			++it;
+			++k;
+		}
+		ASSERT_EQ(it, map.end());
+		ASSERT_EQ(map.nth(k), map.end());
+		ASSERT_EQ(map.end() - map.begin(),
+				  static_cast<std::ptrdiff_t>(map.size()));
+	};
+
+	ranked_map map;
+	std::map<int, int> expected;
+	std::mt19937 gen(23);
+	for (int round = 0; round < 20; ++round)
+	{
+		for (int i = 0; i < 200; ++i)
+		{
+			int key = static_cast<int>(gen() % 1000);
+			if (gen() % 3 == 0)
+			{
+				map.erase(key);
+				expected.erase(key);
+			}
+			else
+			{
+				map[key] = key;
+				expected[key] = key;
+			}
+		}
+		check(map, expected);
+	}
+
+	// сборка из упорядоченных пар и копия тоже знают размеры поддеревьев
+	std::vector<std::pair<int, int>> pairs;
+	for (int key = 1000; key < 1500; key += 2)
+	{
+		pairs.emplace_back(key, key);
+		expected[key] = key;
+	}
+	map.insert_sorted(pairs);
+	check(map, expected);
+	ranked_map copy(map);
+	check(copy, expected);
+
+	ASSERT_EQ(map.count_range(1000, 1100), 50u);
+	ASSERT_EQ(map.count_range(1100, 1000), 0u);
+	ASSERT_EQ(map.count_range(-5, 5000), map.size());
+
+	// сдвиг в обе стороны от середины и от end()
+	auto middle = map.nth(map.size() / 2);
+	ASSERT_EQ((middle + 7)->first, std::next(middle, 7)->first);
+	ASSERT_EQ((middle - 7)->first, std::prev(middle, 7)->first);
+	ASSERT_EQ((map.end() - 1)->first, 1498);
+	ranked_map::const_iterator first = map.cbegin();
+	ASSERT_EQ(first += 3, std::next(map.cbegin(), 3));
+	ASSERT_EQ(map.cend() - first, static_cast<std::ptrdiff_t>(map.size() - 3));
+}
+
+TEST(MapTest, BoundsAndRangeMatchStdMap)
+{
+	bmstu::map<int, int> map;
+	std::map<int, int> expected;
+	std::mt19937 gen(24);
+	for (int i = 0; i < 500; ++i)
+	{
+		int key = static_cast<int>(gen() % 2000);
+		map[key] = i;
+		expected[key] = i;
+	}
+
+	const auto& cmap = map;
+	for (int key = -1; key <= 2001; ++key)
+	{
+		auto lower = expected.lower_bound(key);
+		auto upper = expected.upper_bound(key);
+		if (lower == expected.end())
+		{
+			ASSERT_EQ(map.lower_bound(key), map.end());
+		}
+		else
+		{
+			ASSERT_EQ(map.lower_bound(key)->first, lower->first);
+		}
+		if (upper == expected.end())
+		{
+			ASSERT_EQ(cmap.upper_bound(key), cmap.end());
+		}
+		else
+		{
+			ASSERT_EQ(cmap.upper_bound(key)->first, upper->first);
+		}
+		auto [first, last] = map.equal_range(key);
+		ASSERT_EQ(std::distance(first, last), expected.count(key) ? 1 : 0);
+		ASSERT_EQ(first, map.lower_bound(key));
+		ASSERT_EQ(last, map.upper_bound(key));
+	}
+
+	// окно [lo, hi) даёт те же пары, что и эталон
+	for (auto [lo, hi] : {std::pair{0, 2000}, {100, 350}, {-50, 7},
+						  {1999, 5000}, {700, 700}, {900, 300}})
+	{
+		std::vector<std::pair<int, int>> window;
+		for (const auto& [key, value] : cmap.range(lo, hi))
+		{
+			window.emplace_back(key, value);
+		}
+		std::vector<std::pair<int, int>> reference;
+		if (lo < hi)
+		{
+			reference.assign(expected.lower_bound(lo),
+							 expected.lower_bound(hi));
+		}
+		ASSERT_EQ(window, reference) << lo << " " << hi;
+	}
+
+	// через изменяемый диапазон правятся значения словаря
+	for (auto& [key, value] : map.range(100, 200))
+	{
+		value = -key;
+	}
+	ASSERT_TRUE(std::ranges::all_of(map.range(100, 200),
+									[](const auto& pair)
+									{ return pair.second == -pair.first; }));
+
+	bmstu::map<int, int> empty;
+	ASSERT_EQ(empty.lower_bound(0), empty.end());
+	ASSERT_TRUE(empty.range(0, 10).empty());
+
+	// у окна ranked::map размер считается без обхода
+	bmstu::ranked::map<int, int> ranked;
+	for (int key = 0; key < 100; ++key)
+	{
+		ranked[key] = key;
+	}
+	static_assert(std::ranges::sized_range<decltype(ranked.range(0, 1))>);
+	ASSERT_EQ(ranked.range(10, 30).size(), 20u);
+}
+
+// bmstu::string не умеет сравниваться, поэтому порядок задаётся по
+// символам через string_view; is_transparent разрешает искать по
+// const char* и string_view без построения ключа
+struct chars_less
+{
+	using is_transparent = void;
+
+	static std::string_view view(std::string_view s) { return s; }
+
+	static std::string_view view(const char* s) { return s; }
+
+	template <typename Allocator>
+	static std::string_view view(const bmstu::basic_string<char, Allocator>& s)
+	{
+		return {s.c_str(), s.size()};
+	}
+
+	template <typename L, typename R>
+	bool operator()(const L& lhs, const R& rhs) const
+	{
+		return view(lhs) < view(rhs);
+	}
+};
+
+// тот же порядок, но только между ключами: аргумент поиска приводится к K
+struct key_less
+{
+	bool operator()(const bmstu::pmr::string& lhs,
+					const bmstu::pmr::string& rhs) const
+	{
+		return chars_less{}(lhs, rhs);
+	}
+};
+
+// считает выделения; на время теста ставится ресурсом по умолчанию, чтобы
+// учесть и временные строки, созданные без явного аллокатора
+class counting_resource : public std::pmr::memory_resource
+{
+   public:
+	counting_resource()
+		: previous_(std::pmr::set_default_resource(this))
+	{
+	}
+
+	~counting_resource() override { std::pmr::set_default_resource(previous_); }
+
+	size_t allocations = 0;
+
+   private:
+	void* do_allocate(size_t size, size_t align) override
+	{
+		++allocations;
+		return previous_->allocate(size, align);
+	}
+
+	void do_deallocate(void* p, size_t size, size_t align) override
+	{
+		previous_->deallocate(p, size, align);
+	}
+
+	bool do_is_equal(const memory_resource& other) const noexcept override
+	{
+		return this == &other;
+	}
+
+	std::pmr::memory_resource* previous_;
+};
+
+TEST(MapTest, TransparentLookupDoesNotAllocate)
+{
+	counting_resource resource;
+	// ключи длиннее SSO: временная строка выделила бы буфер в куче
+	const char* keys[] = {"alpha-long-key-outside-of-sso-buffer",
+						  "bravo-long-key-outside-of-sso-buffer",
+						  "charlie-long-key-outside-of-sso-buffer"};
+
+	bmstu::pmr::map<bmstu::pmr::string, int, chars_less> map;
+	for (int i = 0; i < 3; ++i)
+	{
+		map[keys[i]] = i;
+	}
+	ASSERT_FALSE(map.begin()->first.is_using_sso());
+
+	size_t before = resource.allocations;
+	std::string_view view = keys[1];
+	for (int round = 0; round < 100; ++round)
+	{
+		ASSERT_EQ(*map.find(keys[0]), 0);
+		ASSERT_EQ(*map.find(view), 1);
+		ASSERT_EQ(map.find("missing-long-key-outside-of-sso-buffer"),
+				  nullptr);
+		ASSERT_TRUE(map.contains(keys[2]));
+		ASSERT_EQ(map.at(view), 1);
+		ASSERT_EQ(map[keys[2]], 2);
+		ASSERT_EQ(map.lower_bound("b")->second, 1);
+		ASSERT_EQ(map.upper_bound(view)->second, 2);
+		auto [first, last] = map.equal_range(keys[0]);
+		ASSERT_EQ(std::distance(first, last), 1);
+	}
+	ASSERT_EQ(resource.allocations, before);
+	ASSERT_THROW(map.at("missing"), std::out_of_range);
+
+	// новый ключ строится из const char* только при вставке
+	map["delta-long-key-outside-of-sso-buffer"] = 3;
+	ASSERT_GT(resource.allocations, before);
+	ASSERT_EQ(map.size(), 4u);
+
+	// без is_transparent каждый поиск строит временный ключ
+	bmstu::pmr::map<bmstu::pmr::string, int, key_less> plain;
+	plain[keys[0]] = 0;
+	before = resource.allocations;
+	for (int round = 0; round < 10; ++round)
+	{
+		ASSERT_EQ(*plain.find(keys[0]), 0);
+	}
+	ASSERT_EQ(resource.allocations, before + 10);
+}
@@ -0,0 +1,665 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace bmstu
+{
+// Хеш-таблица с открытой адресацией в стиле Swiss table. Кроме массива
+// слотов есть массив управляющих байт, по байту на слот: пусто, удалён
+// или младшие 7 бит хеша ключа (h2). Слоты разбиты на группы по 16;
+// поиск читает управляющие байты группы одной SSE2-загрузкой и одним
+// сравнением находит все слоты, h2 которых совпал, так что ключи
+// сравниваются почти только у нужного слота. Старшие биты хеша (h1)
+// выбирают первую группу, следующие группы перебираются с шагом 1, 2,
+// 3, ... Поиск останавливается на группе, где есть пустой слот. Таблица
+// заполняется не больше чем на 7/8 и растёт вдвое.
+//
+// Интерфейс доступа повторяет bmstu::map (operator[], find, возвращающий
+// V*, at, insert с перезаписью, erase, contains), поэтому заменить один
+// словарь другим можно одним typedef, если не нужен порядок обхода.
+// Итератор однонаправленный, обходит слоты по порядку в памяти и отдаёт
+// std::pair<const K&, V&>. Вставка может переложить все элементы, поэтому
+// делает итераторы и указатели из find недействительными; erase не трогает
+// другие элементы.
+template <typename K,
+		  typename V,
+		  typename Hash = std::hash<K>,
+		  typename Allocator = std::allocator<std::pair<const K, V>>>
+class unordered_map
+{
+	using ctrl_t = int8_t;
+	using slot_type = std::pair<K, V>;
+	using slot_allocator = typename std::allocator_traits<
+		Allocator>::template rebind_alloc<slot_type>;
+	using slot_traits = std::allocator_traits<slot_allocator>;
+	using ctrl_allocator = typename std::allocator_traits<
+		Allocator>::template rebind_alloc<ctrl_t>;
+	using ctrl_traits = std::allocator_traits<ctrl_allocator>;
+
+	// занятый слот хранит h2 от 0 до 127; остальные значения отрицательны
+	static constexpr ctrl_t empty_ctrl = -128;
+	static constexpr ctrl_t deleted_ctrl = -2;
+	// байт после последнего слота останавливает итератор
+	static constexpr ctrl_t sentinel_ctrl = -1;
+	static constexpr size_t group_width = 16;
+	static constexpr size_t npos = static_cast<size_t>(-1);
+	static constexpr ctrl_t empty_table_[1] = {sentinel_ctrl};
+
+   public:
+	using key_type = K;
+	using mapped_type = V;
+	using value_type = std::pair<const K, V>;
+	using hasher = Hash;
+	using allocator_type = Allocator;
+
+	template <bool Const>
+	class basic_iterator
+	{
+		using slot = std::conditional_t<Const, const slot_type, slot_type>;
+		using mapped = std::conditional_t<Const, const V, V>;
+
+	   public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = std::pair<K, V>;
+		using difference_type = std::ptrdiff_t;
+		using reference = std::pair<const K&, mapped&>;
+
+		struct pointer
+		{
+			reference pair;
+
+			const reference* operator->() const noexcept { return &pair; }
+		};
+
+		basic_iterator() = default;
+
+		operator basic_iterator<true>() const noexcept
+			requires(!Const)
+		{
+			return {ctrl_, slot_};
+		}
+
+		reference operator*() const noexcept
+		{
+			return {slot_->first, slot_->second};
+		}
+
+		pointer operator->() const noexcept { return {**this}; }
+
+		basic_iterator& operator++() noexcept
+		{
+			++ctrl_;
+			++slot_;
+			skip_free_();
+			return *this;
+		}
+
+		basic_iterator operator++(int) noexcept
+		{
+			basic_iterator copy(*this);
+			++*this;
+			return copy;
+		}
+
+		friend bool operator==(const basic_iterator& lhs,
+							   const basic_iterator& rhs) noexcept
+		{
+			return lhs.ctrl_ == rhs.ctrl_;
+		}
+
+	   private:
+		friend class unordered_map;
+		friend class basic_iterator<!Const>;
+
+		basic_iterator(const ctrl_t* ctrl, slot* slot) noexcept
+			: ctrl_(ctrl), slot_(slot)
+		{
+		}
+
+		// пустые и удалённые слоты меньше стража, занятые — больше
+		void skip_free_() noexcept
+		{
+			while (*ctrl_ < sentinel_ctrl)
+			{
+				++ctrl_;
+				++slot_;
+			}
+		}
+
+		const ctrl_t* ctrl_ = nullptr;
+		slot* slot_ = nullptr;
+	};
+
+	using iterator = basic_iterator<false>;
+	using const_iterator = basic_iterator<true>;
+
+	unordered_map() = default;
+
+	explicit unordered_map(const Allocator& alloc) : alloc_(alloc) {}
+
+	unordered_map(const unordered_map& other)
+		: unordered_map(other,
+						std::allocator_traits<Allocator>::
+							select_on_container_copy_construction(
+								other.get_allocator()))
+	{
+	}
+
+	unordered_map(const unordered_map& other, const Allocator& alloc)
+		: hash_(other.hash_), alloc_(alloc)
+	{
+		reserve(other.size_);
+		for (auto [key, value] : other)
+		{
+			emplace_new_(hash_of_(key), key, value);
+		}
+	}
+
+	unordered_map(unordered_map&& other) noexcept
+		: hash_(std::move(other.hash_)), alloc_(std::move(other.alloc_))
+	{
+		take_(other);
+	}
+
+	unordered_map& operator=(const unordered_map& other)
+	{
+		if (this != &other)
+		{
+			constexpr bool propagate =
+				slot_traits::propagate_on_container_copy_assignment::value;
+			unordered_map copy(
+				other, propagate ? other.get_allocator() : get_allocator());
+			swap_storage_(copy);
+			std::swap(hash_, copy.hash_);
+			if constexpr (propagate)
+			{
+				std::swap(alloc_, copy.alloc_);
+			}
+		}
+		return *this;
+	}
+
+	unordered_map& operator=(unordered_map&& other) noexcept(
+		slot_traits::propagate_on_container_move_assignment::value ||
+		slot_traits::is_always_equal::value)
+	{
+		if (this == &other)
+		{
+			return *this;
+		}
+		if constexpr (slot_traits::propagate_on_container_move_assignment::
+						  value)
+		{
+			release_();
+			alloc_ = std::move(other.alloc_);
+		}
+		else if (alloc_ != other.alloc_)
+		{
+			// память другого ресурса забрать нельзя, элементы копируются
+			*this = static_cast<const unordered_map&>(other);
+			return *this;
+		}
+		else
+		{
+			release_();
+		}
+		hash_ = std::move(other.hash_);
+		take_(other);
+		return *this;
+	}
+
+	~unordered_map() { release_(); }
+
+	allocator_type get_allocator() const noexcept
+	{
+		return allocator_type(alloc_);
+	}
+
+	void insert(const K& key, const V& value)
+	{
+		size_t hash = hash_of_(key);
+		size_t index = find_(key, hash);
+		if (index != npos)
+		{
+			slots_[index].second = value;
+			return;
+		}
+		emplace_new_(hash, key, value);
+	}
+
+	void insert(const value_type& pair) { insert(pair.first, pair.second); }
+
+	V& operator[](const K& key)
+	{
+		size_t hash = hash_of_(key);
+		size_t index = find_(key, hash);
+		if (index == npos)
+		{
+			index = emplace_new_(hash, key, V());
+		}
+		return slots_[index].second;
+	}
+
+	V* find(const K& key)
+	{
+		size_t index = find_(key, hash_of_(key));
+		return index != npos ? &slots_[index].second : nullptr;
+	}
+
+	const V* find(const K& key) const
+	{
+		size_t index = find_(key, hash_of_(key));
+		return index != npos ? &slots_[index].second : nullptr;
+	}
+
+	V& at(const K& key)
+	{
+		V* value = find(key);
+		if (value == nullptr)
+		{
+			throw std::out_of_range("Key not found in map");
+		}
+		return *value;
+	}
+
+	const V& at(const K& key) const
+	{
+		const V* value = find(key);
+		if (value == nullptr)
+		{
+			throw std::out_of_range("Key not found in map");
+		}
+		return *value;
+	}
+
+	// Слот становится пустым, если в его группе уже есть пустой: тогда ни
+	// один поиск не проходил эту группу насквозь. Иначе он помечается
+	// удалённым, чтобы не обрывать поиск ключей из следующих групп.
+	void erase(const K& key)
+	{
+		size_t index = find_(key, hash_of_(key));
+		if (index == npos)
+		{
+			return;
+		}
+		slot_traits::destroy(alloc_, slots_ + index);
+		--size_;
+		group_ g(ctrl_ + index / group_width * group_width);
+		if (g.match(empty_ctrl) != 0)
+		{
+			ctrl_[index] = empty_ctrl;
+			++growth_left_;
+		}
+		else
+		{
+			ctrl_[index] = deleted_ctrl;
+		}
+	}
+
+	bool contains(const K& key) const { return find(key) != nullptr; }
+
+	size_t size() const noexcept { return size_; }
+
+	bool empty() const noexcept { return size_ == 0; }
+
+	// число слотов; занято не больше 7/8 из них
+	size_t capacity() const noexcept { return capacity_; }
+
+	double load_factor() const noexcept
+	{
+		return capacity_ == 0 ? 0.0
+							  : static_cast<double>(size_) /
+									static_cast<double>(capacity_);
+	}
+
+	void clear() noexcept
+	{
+		destroy_slots_();
+		if (capacity_ > 0)
+		{
+			std::memset(ctrl_, empty_ctrl, capacity_);
+		}
+		size_ = 0;
+		growth_left_ = max_load_(capacity_);
+	}
+
+	// после reserve(n) вставка до n ключей не перестраивает таблицу
+	void reserve(size_t count)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+		size_t capacity = group_width;
+		while (max_load_(capacity) < count)
+		{
+			capacity *= 2;
+		}
+		if (capacity > capacity_)
+		{
+			rehash_(capacity);
+		}
+	}
+
+	void swap(unordered_map& other) noexcept
+	{
+		using std::swap;
+		swap(hash_, other.hash_);
+		if constexpr (slot_traits::propagate_on_container_swap::value)
+		{
+			swap(alloc_, other.alloc_);
+		}
+		swap_storage_(other);
+	}
+
+	friend void swap(unordered_map& lhs, unordered_map& rhs) noexcept
+	{
+		lhs.swap(rhs);
+	}
+
+	iterator begin() noexcept
+	{
+		iterator it(ctrl_begin_(), slots_);
+		it.skip_free_();
+		return it;
+	}
+
+	iterator end() noexcept
+	{
+		return iterator(ctrl_begin_() + capacity_, slots_ + capacity_);
+	}
+
+	const_iterator begin() const noexcept
+	{
+		const_iterator it(ctrl_begin_(), slots_);
+		it.skip_free_();
+		return it;
+	}
+
+	const_iterator end() const noexcept
+	{
+		return const_iterator(ctrl_begin_() + capacity_, slots_ + capacity_);
+	}
+
+   private:
+	// управляющие байты одной группы и маски слотов с заданным байтом
+	struct group_
+	{
+#if defined(__SSE2__)
+		explicit group_(const ctrl_t* ctrl) noexcept
+			: bytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl)))
+		{
+		}
+
+		uint32_t match(ctrl_t value) const noexcept
+		{
+			return static_cast<uint32_t>(
+				_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(value), bytes)));
+		}
+
+		// пустые и удалённые слоты
+		uint32_t match_free() const noexcept
+		{
+			return static_cast<uint32_t>(_mm_movemask_epi8(
+				_mm_cmpgt_epi8(_mm_set1_epi8(sentinel_ctrl), bytes)));
+		}
+
+		__m128i bytes;
+#else
+		explicit group_(const ctrl_t* ctrl) noexcept
+		{
+			std::memcpy(bytes, ctrl, group_width);
+		}
+
+		uint32_t match(ctrl_t value) const noexcept
+		{
+			uint32_t mask = 0;
+			for (size_t i = 0; i < group_width; ++i)
+			{
+				mask |= static_cast<uint32_t>(bytes[i] == value) << i;
+			}
+			return mask;
+		}
+
+		uint32_t match_free() const noexcept
+		{
+			uint32_t mask = 0;
+			for (size_t i = 0; i < group_width; ++i)
+			{
+				mask |= static_cast<uint32_t>(bytes[i] < sentinel_ctrl) << i;
+			}
+			return mask;
+		}
+
+		ctrl_t bytes[group_width];
+#endif
+	};
+
+	static size_t max_load_(size_t capacity) noexcept
+	{
+		return capacity - capacity / 8;
+	}
+
+	// std::hash для целых — тождественная функция; перемешивание нужно,
+	// чтобы и h1, и h2 зависели от всех бит ключа
+	size_t hash_of_(const K& key) const
+	{
+		uint64_t h = static_cast<uint64_t>(hash_(key));
+		h *= 0x9E3779B97F4A7C15ull;
+		return static_cast<size_t>(h ^ (h >> 32));
+	}
+
+	static ctrl_t h2_(size_t hash) noexcept
+	{
+		return static_cast<ctrl_t>(hash & 0x7F);
+	}
+
+	const ctrl_t* ctrl_begin_() const noexcept
+	{
+		return capacity_ == 0 ? empty_table_ : ctrl_;
+	}
+
+	size_t find_(const K& key, size_t hash) const
+	{
+		if (capacity_ == 0)
+		{
+			return npos;
+		}
+		size_t group_mask = capacity_ / group_width - 1;
+		size_t first = (hash >> 7) & group_mask;
+		for (size_t step = 1;; ++step)
+		{
+			group_ g(ctrl_ + first * group_width);
+			for (uint32_t m = g.match(h2_(hash)); m != 0; m &= m - 1)
+			{
+				size_t index = first * group_width +
+							   static_cast<size_t>(std::countr_zero(m));
+				if (slots_[index].first == key)
+				{
+					return index;
+				}
+			}
+			if (g.match(empty_ctrl) != 0)
+			{
+				return npos;
+			}
+			first = (first + step) & group_mask;
+		}
+	}
+
+	// первый пустой или удалённый слот на пути поиска ключа с этим хешем
+	size_t find_free_(size_t hash) const noexcept
+	{
+		size_t group_mask = capacity_ / group_width - 1;
+		size_t first = (hash >> 7) & group_mask;
+		for (size_t step = 1;; ++step)
+		{
+			uint32_t m = group_(ctrl_ + first * group_width).match_free();
+			if (m != 0)
+			{
+				return first * group_width +
+					   static_cast<size_t>(std::countr_zero(m));
+			}
+			first = (first + step) & group_mask;
+		}
+	}
+
+	// ключа в таблице нет; при исключении из конструктора таблица не
+	// меняется
+	template <typename... Args>
+	size_t emplace_new_(size_t hash, Args&&... args)
+	{
+		if (growth_left_ == 0)
+		{
+			// много удалённых слотов — чистим на месте, иначе растём
+			return rehash_(size_ < max_load_(capacity_) / 2
+							   ? capacity_
+							   : std::max(capacity_ * 2, group_width),
+						   hash, std::forward<Args>(args)...);
+		}
+		size_t index = find_free_(hash);
+		slot_traits::construct(alloc_, slots_ + index,
+							   std::forward<Args>(args)...);
+		if (ctrl_[index] == empty_ctrl)
+		{
+			--growth_left_;
+		}
+		ctrl_[index] = h2_(hash);
+		++size_;
+		return index;
+	}
+
+	// Перекладывает элементы в новые массивы, удалённые слоты исчезают.
+	// Если переданы args, сначала в новой таблице строится элемент с хешем
+	// hash: args могут ссылаться на старые элементы, а те при переезде
+	// перемещаются и освобождаются. Возвращает индекс нового элемента.
+	template <typename... Args>
+	size_t rehash_(size_t capacity, size_t hash = 0, Args&&... args)
+	{
+		ctrl_allocator ctrl_alloc(alloc_);
+		ctrl_t* ctrl = ctrl_traits::allocate(ctrl_alloc, capacity + 1);
+		slot_type* slots;
+		try
+		{
+			slots = slot_traits::allocate(alloc_, capacity);
+		}
+		catch (...)
+		{
+			ctrl_traits::deallocate(ctrl_alloc, ctrl, capacity + 1);
+			throw;
+		}
+		std::memset(ctrl, empty_ctrl, capacity);
+		ctrl[capacity] = sentinel_ctrl;
+
+		unordered_map fresh(alloc_);
+		fresh.ctrl_ = ctrl;
+		fresh.slots_ = slots;
+		fresh.capacity_ = capacity;
+		fresh.growth_left_ = max_load_(capacity);
+		size_t added = npos;
+		if constexpr (sizeof...(Args) > 0)
+		{
+			added = fresh.find_free_(hash);
+			slot_traits::construct(alloc_, slots + added,
+								   std::forward<Args>(args)...);
+			ctrl[added] = h2_(hash);
+			--fresh.growth_left_;
+			++fresh.size_;
+		}
+		// при исключении fresh освобождает уже перенесённое
+		for (size_t i = 0; i < capacity_; ++i)
+		{
+			if (ctrl_[i] >= 0)
+			{
+				size_t index =
+					fresh.find_free_(hash_of_(slots_[i].first));
+				slot_traits::construct(alloc_, slots + index,
+									   std::move_if_noexcept(slots_[i]));
+				ctrl[index] = ctrl_[i];
+				--fresh.growth_left_;
+				++fresh.size_;
+			}
+		}
+		swap_storage_(fresh);
+		return added;
+	}
+
+	void destroy_slots_() noexcept
+	{
+		for (size_t i = 0; i < capacity_ && size_ > 0; ++i)
+		{
+			if (ctrl_[i] >= 0)
+			{
+				slot_traits::destroy(alloc_, slots_ + i);
+			}
+		}
+	}
+
+	void release_() noexcept
+	{
+		if (capacity_ == 0)
+		{
+			return;
+		}
+		destroy_slots_();
+		ctrl_allocator ctrl_alloc(alloc_);
+		ctrl_traits::deallocate(ctrl_alloc, ctrl_, capacity_ + 1);
+		slot_traits::deallocate(alloc_, slots_, capacity_);
+		ctrl_ = nullptr;
+		slots_ = nullptr;
+		capacity_ = size_ = growth_left_ = 0;
+	}
+
+	void take_(unordered_map& other) noexcept
+	{
+		ctrl_ = std::exchange(other.ctrl_, nullptr);
+		slots_ = std::exchange(other.slots_, nullptr);
+		capacity_ = std::exchange(other.capacity_, 0);
+		size_ = std::exchange(other.size_, 0);
+		growth_left_ = std::exchange(other.growth_left_, 0);
+	}
+
+	void swap_storage_(unordered_map& other) noexcept
+	{
+		std::swap(ctrl_, other.ctrl_);
+		std::swap(slots_, other.slots_);
+		std::swap(capacity_, other.capacity_);
+		std::swap(size_, other.size_);
+		std::swap(growth_left_, other.growth_left_);
+	}
+
+	ctrl_t* ctrl_ = nullptr;
+	slot_type* slots_ = nullptr;
+	size_t capacity_ = 0;
+	size_t size_ = 0;
+	// сколько ещё пустых слотов можно занять до перестройки
+	size_t growth_left_ = 0;
+	[[no_unique_address]] Hash hash_;
+	[[no_unique_address]] slot_allocator alloc_;
+};
+
+namespace pmr
+{
+template <typename K, typename V, typename Hash = std::hash<K>>
+using unordered_map = bmstu::unordered_map<
+	K,
+	V,
+	Hash,
+	std::pmr::polymorphic_allocator<std::pair<const K, V>>>;
+}  // namespace pmr
+}  // namespace bmstu
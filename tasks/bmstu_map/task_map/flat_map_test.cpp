@@ -0,0 +1,117 @@
+#include "bmstu_flat_map.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <memory_resource>
+#include <random>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+TEST(FlatMap, SameInterfaceAsMap)
+{
+	bmstu::flat_map<std::string, int> map;
+	ASSERT_TRUE(map.empty());
+	map.insert("two", 2);
+	map.insert({"one", 1});
+	map["three"] = 3;
+	// insert перезаписывает значение, как у bmstu::map
+	map.insert("two", 22);
+	ASSERT_EQ(map.size(), 3u);
+	ASSERT_EQ(map.at("two"), 22);
+	ASSERT_EQ(*map.find("one"), 1);
+	ASSERT_EQ(map.find("four"), nullptr);
+	ASSERT_THROW(map.at("four"), std::out_of_range);
+	ASSERT_TRUE(map.contains("three"));
+
+	map.erase("one");
+	map.erase("missing");
+	ASSERT_FALSE(map.contains("one"));
+	ASSERT_EQ(map.size(), 2u);
+	ASSERT_EQ(map.keys()[0], "three");
+	ASSERT_EQ(map.values()[1], 22);
+
+	map.clear();
+	ASSERT_TRUE(map.empty());
+	ASSERT_EQ(map.begin(), map.end());
+}
+
+TEST(FlatMap, BulkInsertMatchesOneByOne)
+{
+	std::mt19937 gen(17);
+	std::map<int, int> expected;
+	bmstu::flat_map<int, int> map;
+	for (int round = 0; round < 20; ++round)
+	{
+		std::vector<std::pair<int, int>> batch;
+		for (int i = 0; i < 500; ++i)
+		{
+			// узкий диапазон: повторы внутри пачки и с уже вставленными
+			int key = static_cast<int>(gen() % 3000);
+			batch.emplace_back(key, round * 1000 + i);
+		}
+		for (const auto& [key, value] : batch)
+		{
+			expected[key] = value;
+		}
+		map.insert(batch.begin(), batch.end());
+		ASSERT_EQ(map.size(), expected.size());
+		ASSERT_TRUE(
+			std::ranges::equal(map.keys(), expected | std::views::keys));
+		ASSERT_TRUE(
+			std::ranges::equal(map.values(), expected | std::views::values));
+	}
+
+	bmstu::flat_map<int, char> small{{3, 'c'}, {1, 'a'}, {3, 'C'}, {2, 'b'}};
+	ASSERT_EQ(small.size(), 3u);
+	ASSERT_EQ(small.at(3), 'C');
+}
+
+TEST(FlatMap, IteratorsWalkKeysInOrder)
+{
+	bmstu::flat_map<int, std::string> map;
+	for (int key : {5, 1, 4, 2, 3})
+	{
+		map.insert(key, std::string(key, '*'));
+	}
+	int previous = 0;
+	for (auto [key, value] : map)
+	{
+		ASSERT_EQ(key, previous + 1);
+		ASSERT_EQ(value.size(), static_cast<size_t>(key));
+		// значение — ссылка в массив значений
+		value += '!';
+		previous = key;
+	}
+	ASSERT_EQ(map.at(3), "***!");
+
+	const auto& view = map;
+	auto it = view.begin() + 2;
+	ASSERT_EQ(it->first, 3);
+	ASSERT_EQ(view.end() - it, 3);
+	ASSERT_EQ(it[1].first, 4);
+	bmstu::flat_map<int, std::string>::const_iterator converted = map.begin();
+	ASSERT_EQ(converted, view.begin());
+	ASSERT_LT(converted, it);
+}
+
+TEST(FlatMap, PmrArraysComeFromResource)
+{
+	std::pmr::monotonic_buffer_resource arena;
+	bmstu::pmr::flat_map<int, double> map(&arena);
+	std::vector<std::pair<int, double>> batch;
+	for (int i = 1000; i > 0; --i)
+	{
+		batch.emplace_back(i, i * 0.5);
+	}
+	map.insert(batch.begin(), batch.end());
+	map[0] = -1;
+	ASSERT_EQ(map.get_allocator().resource(), &arena);
+	ASSERT_EQ(map.size(), 1001u);
+	ASSERT_EQ(map.keys().front(), 0);
+	ASSERT_EQ(map.at(1000), 500.0);
+}
@@ -0,0 +1,169 @@
+#include "bmstu_unordered_map.h"
+
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <memory_resource>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include "bmstu_map.h"
+
+namespace
+{
+// один и тот же код для обоих словарей: замена — один typedef
+template <typename Map>
+void exercise_access_api()
+{
+	Map map;
+	ASSERT_TRUE(map.empty());
+	map.insert("two", 2);
+	map.insert({"one", 1});
+	map["three"] = 3;
+	map.insert("two", 22);
+	ASSERT_EQ(map.size(), 3u);
+	ASSERT_EQ(map.at("two"), 22);
+	ASSERT_EQ(*map.find("one"), 1);
+	ASSERT_EQ(map.find("four"), nullptr);
+	ASSERT_THROW(map.at("four"), std::out_of_range);
+	ASSERT_TRUE(map.contains("three"));
+	map.erase("one");
+	map.erase("missing");
+	ASSERT_FALSE(map.contains("one"));
+	ASSERT_EQ(map.size(), 2u);
+	map.clear();
+	ASSERT_TRUE(map.empty());
+}
+
+// все ключи попадают в одну группу и сравниваются по цепочке
+struct colliding_hash
+{
+	size_t operator()(int) const noexcept { return 42; }
+};
+}  // namespace
+
+TEST(UnorderedMap, SameAccessApiAsMap)
+{
+	exercise_access_api<bmstu::map<std::string, int>>();
+	exercise_access_api<bmstu::unordered_map<std::string, int>>();
+}
+
+TEST(UnorderedMap, MatchesStdUnderChurn)
+{
+	std::mt19937 gen(5);
+	std::unordered_map<int, int> expected;
+	bmstu::unordered_map<int, int> map;
+	for (int step = 0; step < 200000; ++step)
+	{
+		int key = static_cast<int>(gen() % 5000);
+		if (gen() % 2 == 0)
+		{
+			map[key] = step;
+			expected[key] = step;
+		}
+		else
+		{
+			map.erase(key);
+			expected.erase(key);
+		}
+	}
+	ASSERT_EQ(map.size(), expected.size());
+	for (int key = 0; key < 5000; ++key)
+	{
+		auto it = expected.find(key);
+		const int* value = map.find(key);
+		ASSERT_EQ(value != nullptr, it != expected.end()) << key;
+		if (value != nullptr)
+		{
+			ASSERT_EQ(*value, it->second);
+		}
+	}
+	// удалённые слоты переиспользуются: таблица не растёт без числа ключей
+	ASSERT_LE(map.capacity(), 8192u);
+	ASSERT_LE(map.load_factor(), 7.0 / 8);
+
+	bmstu::unordered_map<int, int, colliding_hash> chained;
+	for (int i = 0; i < 100; ++i)
+	{
+		chained[i] = i * i;
+	}
+	for (int i = 0; i < 100; i += 2)
+	{
+		chained.erase(i);
+	}
+	ASSERT_EQ(chained.size(), 50u);
+	ASSERT_EQ(chained.at(99), 99 * 99);
+	ASSERT_FALSE(chained.contains(98));
+}
+
+TEST(UnorderedMap, IteratesEveryEntryOnce)
+{
+	bmstu::unordered_map<int, std::string> map;
+	ASSERT_EQ(map.begin(), map.end());
+	long long key_sum = 0;
+	for (int i = 0; i < 1000; ++i)
+	{
+		map.insert(i, std::to_string(i));
+		key_sum += i;
+	}
+	for (auto [key, value] : map)
+	{
+		key_sum -= key;
+		ASSERT_EQ(value, std::to_string(key));
+		value += '!';
+	}
+	ASSERT_EQ(key_sum, 0);
+	ASSERT_EQ(map.at(7), "7!");
+
+	auto copy = map;
+	map.erase(7);
+	ASSERT_EQ(copy.at(7), "7!");
+	const auto moved = std::move(copy);
+	ASSERT_TRUE(copy.empty());
+	ASSERT_EQ(moved.size(), 1000u);
+	size_t visited = 0;
+	for (auto it = moved.begin(); it != moved.end(); ++it)
+	{
+		ASSERT_EQ(it->second.back(), '!');
+		++visited;
+	}
+	ASSERT_EQ(visited, moved.size());
+}
+
+TEST(UnorderedMap, PmrSlotsComeFromResource)
+{
+	std::pmr::monotonic_buffer_resource arena;
+	bmstu::pmr::unordered_map<int, double> map(&arena);
+	map.reserve(1000);
+	size_t capacity = map.capacity();
+	for (int i = 0; i < 1000; ++i)
+	{
+		map[i] = i * 0.5;
+	}
+	ASSERT_EQ(map.capacity(), capacity);
+	ASSERT_EQ(map.get_allocator().resource(), &arena);
+	ASSERT_EQ(map.at(999), 499.5);
+
+	bmstu::pmr::unordered_map<int, double> other(&arena);
+	other = map;
+	ASSERT_EQ(other.size(), 1000u);
+}
+
+TEST(UnorderedMap, InsertFromOwnElementSurvivesGrowth)
+{
+	// 14 ключей заполняют 16 слотов до предела, следующая вставка растит
+	// таблицу; значение берётся из элемента, который при этом переезжает
+	bmstu::unordered_map<int, std::string> map;
+	map.reserve(14);
+	size_t capacity = map.capacity();
+	for (int i = 0; i < static_cast<int>(capacity - capacity / 8); ++i)
+	{
+		map[i] = std::string(40, static_cast<char>('a' + i));
+	}
+	map.insert(100, map.at(3));
+	ASSERT_GT(map.capacity(), capacity);
+	ASSERT_EQ(map.at(100), std::string(40, 'd'));
+	ASSERT_EQ(map.at(3), std::string(40, 'd'));
+	ASSERT_EQ(map.size(), capacity - capacity / 8 + 1);
+}
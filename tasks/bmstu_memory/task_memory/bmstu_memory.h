@@ -0,0 +1,132 @@
+#pragma once
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace bmstu
+{
+// Политика роста: новая ёмкость = старая * Num / Den (по умолчанию 1.5x).
+// Геометрический рост даёт амортизированное O(1) на вставку.
+template <size_t Num = 3, size_t Den = 2>
+struct geometric_growth
+{
+	static_assert(Den > 0 && Num > Den, "growth factor must be greater than 1");
+
+	static size_t next_capacity(size_t capacity, size_t required) noexcept
+	{
+		// capacity * Num / Den без переполнения на промежуточном умножении
+		size_t grown = capacity / Den * Num + capacity % Den * Num / Den;
+		if (grown < capacity)
+		{
+			// переполнение size_t
+			return required;
+		}
+		return grown > required ? grown : required;
+	}
+};
+
+// Политика роста фиксированными порциями по Chunk элементов.
+// Подходит, когда верхняя граница размера известна и память важнее скорости.
+template <size_t Chunk>
+struct fixed_chunk_growth
+{
+	static_assert(Chunk > 0, "chunk size must be positive");
+
+	static size_t next_capacity(size_t capacity, size_t required) noexcept
+	{
+		size_t grown = capacity + Chunk;
+		return grown > required ? grown : required;
+	}
+};
+
+// Тип тривиально переносим, если перенос объекта в новую память и забывание
+// старой копии эквивалентны memcpy. Для тривиально копируемых типов это так
+// всегда; для остальных (например, строк без указателя на самих себя) трейт
+// можно включить явной специализацией:
+//
+//   template <>
+//   struct bmstu::is_trivially_relocatable<my_type> : std::true_type {};
+template <typename T>
+struct is_trivially_relocatable
+	: std::bool_constant<std::is_trivially_copyable_v<T> &&
+						 std::is_trivially_destructible_v<T>>
+{
+};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v =
+	is_trivially_relocatable<T>::value;
+
+// Создаёт в неинициализированной памяти dest count объектов из src через
+// аллокатор: перемещением, если перемещающий конструктор T не бросает
+// исключений, иначе копированием. Если создание бросит, уже созданные
+// объекты уничтожаются, а src остаётся нетронутым, поэтому перенос на её
+// основе даёт строгую гарантию. Уничтожать src вызывающий должен сам.
+template <typename Allocator, typename T>
+void uninitialized_move_if_noexcept(Allocator& alloc,
+									T* src,
+									size_t count,
+									T* dest)
+{
+	using alloc_traits = std::allocator_traits<Allocator>;
+	size_t constructed = 0;
+	try
+	{
+		for (; constructed < count; ++constructed)
+		{
+			alloc_traits::construct(alloc, dest + constructed,
+									std::move_if_noexcept(src[constructed]));
+		}
+	}
+	catch (...)
+	{
+		while (constructed > 0)
+		{
+			alloc_traits::destroy(alloc, dest + --constructed);
+		}
+		throw;
+	}
+}
+
+// Переносит count объектов из src в неинициализированную память dest,
+// объекты создаются и уничтожаются через аллокатор контейнера. Для std::pmr
+// это важно: polymorphic_allocator передаёт свой ресурс элементам, которые
+// сами умеют работать с аллокатором (например, std::pmr::string), и при
+// переносе они остаются в той же арене. После вызова объекты в src
+// уничтожены, память src можно освобождать. Если создание бросит
+// (копирование типа без noexcept-перемещения), dest пуста, а src цела.
+template <typename Allocator, typename T>
+void uninitialized_relocate(Allocator& alloc, T* src, size_t count, T* dest)
+{
+	using alloc_traits = std::allocator_traits<Allocator>;
+	if constexpr (is_trivially_relocatable_v<T>)
+	{
+		if (count > 0)
+		{
+			std::memcpy(static_cast<void*>(dest), static_cast<const void*>(src),
+						count * sizeof(T));
+		}
+	}
+	else
+	{
+		// src уничтожается только после того, как создан весь dest
+		uninitialized_move_if_noexcept(alloc, src, count, dest);
+		for (size_t i = 0; i < count; ++i)
+		{
+			alloc_traits::destroy(alloc, src + i);
+		}
+	}
+}
+
+// то же для памяти без аллокатора: объекты создаются new и уничтожаются
+// деструктором
+template <typename T>
+void uninitialized_relocate(T* src, size_t count, T* dest)
+{
+	std::allocator<T> alloc;
+	uninitialized_relocate(alloc, src, count, dest);
+}
+}  // namespace bmstu
@@ -0,0 +1,224 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+
+namespace bmstu
+{
+// Пул ячеек одного размера для узлов списков и деревьев. Память берётся у
+// системы блоками по slots_per_block ячеек и раздаётся подряд, поэтому
+// соседние узлы лежат рядом. Освобождённая ячейка попадает в интрузивный
+// список свободных и выдаётся первой при следующем запросе. Блоки
+// возвращаются системе только вместе с пулом. Пул не потокобезопасен.
+class node_pool
+{
+   public:
+	static constexpr size_t default_slots_per_block = 256;
+
+	node_pool(size_t slot_size,
+			  size_t slot_align,
+			  size_t slots_per_block = default_slots_per_block)
+		: slot_align_(std::max(slot_align, alignof(free_slot))),
+		  slot_size_(round_up_(std::max(slot_size, sizeof(free_slot)),
+							   slot_align_)),
+		  header_size_(round_up_(sizeof(block_header), slot_align_)),
+		  slots_per_block_(std::max<size_t>(slots_per_block, 1))
+	{
+	}
+
+	node_pool(const node_pool&) = delete;
+	node_pool& operator=(const node_pool&) = delete;
+
+	~node_pool()
+	{
+		while (blocks_ != nullptr)
+		{
+			block_header* next = blocks_->next;
+			::operator delete(static_cast<void*>(blocks_),
+							  std::align_val_t(slot_align_));
+			blocks_ = next;
+		}
+	}
+
+	void* allocate()
+	{
+		if (free_ != nullptr)
+		{
+			free_slot* slot = free_;
+			free_ = slot->next;
+			return slot;
+		}
+		if (unused_ == unused_end_)
+		{
+			grow_();
+		}
+		void* slot = unused_;
+		unused_ += slot_size_;
+		return slot;
+	}
+
+	void deallocate(void* ptr) noexcept
+	{
+		free_ = ::new (ptr) free_slot{free_};
+	}
+
+	size_t slot_size() const noexcept { return slot_size_; }
+
+	size_t block_count() const noexcept { return block_count_; }
+
+   private:
+	struct free_slot
+	{
+		free_slot* next;
+	};
+
+	// заголовок в начале каждого блока связывает блоки для освобождения
+	struct block_header
+	{
+		block_header* next;
+	};
+
+	static size_t round_up_(size_t size, size_t align) noexcept
+	{
+		return (size + align - 1) / align * align;
+	}
+
+	void grow_()
+	{
+		void* raw = ::operator new(header_size_ + slot_size_ * slots_per_block_,
+								   std::align_val_t(slot_align_));
+		blocks_ = ::new (raw) block_header{blocks_};
+		++block_count_;
+		unused_ = static_cast<std::byte*>(raw) + header_size_;
+		unused_end_ = unused_ + slot_size_ * slots_per_block_;
+	}
+
+	size_t slot_align_;
+	size_t slot_size_;
+	size_t header_size_;
+	size_t slots_per_block_;
+	free_slot* free_ = nullptr;
+	std::byte* unused_ = nullptr;
+	std::byte* unused_end_ = nullptr;
+	block_header* blocks_ = nullptr;
+	size_t block_count_ = 0;
+};
+
+// Пул, который настраивается на размер первого запрошенного объекта. Его
+// делят между собой копии pool_allocator, в том числе после rebind.
+class lazy_node_pool
+{
+   public:
+	explicit lazy_node_pool(size_t slots_per_block)
+		: slots_per_block_(slots_per_block)
+	{
+	}
+
+	// пул для объектов size/align или nullptr, если пул настроен на другие
+	node_pool* pool_for(size_t size, size_t align)
+	{
+		if (!pool_)
+		{
+			pool_.emplace(size, align, slots_per_block_);
+			object_size_ = size;
+			object_align_ = align;
+		}
+		return size == object_size_ && align == object_align_ ? &*pool_
+															  : nullptr;
+	}
+
+	size_t slots_per_block() const noexcept { return slots_per_block_; }
+
+	size_t block_count() const noexcept
+	{
+		return pool_ ? pool_->block_count() : 0;
+	}
+
+   private:
+	size_t slots_per_block_;
+	size_t object_size_ = 0;
+	size_t object_align_ = 0;
+	std::optional<node_pool> pool_;
+};
+
+// Аллокатор в стиле std поверх node_pool. Копии аллокатора делят один пул,
+// а копия контейнера получает собственный (select_on_container_copy_
+// construction). Пул создаётся при первом запросе одного объекта и
+// настраивается на его размер: контейнеры на узлах после rebind запрашивают
+// только свои узлы. Массивы и объекты другого размера идут в operator new.
+template <typename T>
+class pool_allocator
+{
+	template <typename U>
+	friend class pool_allocator;
+
+   public:
+	using value_type = T;
+	using propagate_on_container_copy_assignment = std::false_type;
+	using propagate_on_container_move_assignment = std::true_type;
+	using propagate_on_container_swap = std::true_type;
+	using is_always_equal = std::false_type;
+
+	explicit pool_allocator(
+		size_t slots_per_block = node_pool::default_slots_per_block)
+		: pool_(std::make_shared<lazy_node_pool>(slots_per_block))
+	{
+	}
+
+	// перемещение копирует: перемещённый контейнер должен остаться рабочим
+	pool_allocator(const pool_allocator&) noexcept = default;
+	pool_allocator& operator=(const pool_allocator&) noexcept = default;
+
+	template <typename U>
+	pool_allocator(const pool_allocator<U>& other) noexcept
+		: pool_(other.pool_)
+	{
+	}
+
+	T* allocate(size_t n)
+	{
+		if (n == 1)
+		{
+			if (node_pool* pool = pool_->pool_for(sizeof(T), alignof(T)))
+			{
+				return static_cast<T*>(pool->allocate());
+			}
+		}
+		return static_cast<T*>(
+			::operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+	}
+
+	void deallocate(T* ptr, size_t n) noexcept
+	{
+		if (n == 1)
+		{
+			if (node_pool* pool = pool_->pool_for(sizeof(T), alignof(T)))
+			{
+				pool->deallocate(ptr);
+				return;
+			}
+		}
+		::operator delete(ptr, std::align_val_t(alignof(T)));
+	}
+
+	pool_allocator select_on_container_copy_construction() const
+	{
+		return pool_allocator(pool_->slots_per_block());
+	}
+
+	// число блоков, взятых пулом у системы; 0, пока пул не создан
+	size_t block_count() const noexcept { return pool_->block_count(); }
+
+	template <typename U>
+	bool operator==(const pool_allocator<U>& other) const noexcept
+	{
+		return pool_ == other.pool_;
+	}
+
+   private:
+	std::shared_ptr<lazy_node_pool> pool_;
+};
+}  // namespace bmstu
@@ -0,0 +1,152 @@
+#include "bmstu_memory.h"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+struct point
+{
+	int x;
+	int y;
+};
+
+struct relocatable_handle
+{
+	explicit relocatable_handle(int v) : value(new int(v)) {}
+	relocatable_handle(relocatable_handle&& other) noexcept
+		: value(other.value)
+	{
+		other.value = nullptr;
+		++moves;
+	}
+	~relocatable_handle() { delete value; }
+
+	int* value;
+	static int moves;
+};
+
+// без перемещающего конструктора; копия с номером fail_at бросает
+struct throwing_copy
+{
+	explicit throwing_copy(int v) : value(v) { ++alive; }
+	throwing_copy(const throwing_copy& other) : value(other.value)
+	{
+		if (++copies == fail_at)
+		{
+			throw std::runtime_error("copy failed");
+		}
+		++alive;
+	}
+	~throwing_copy() { --alive; }
+
+	int value;
+	static int copies;
+	static int fail_at;
+	static int alive;
+};
+
+int relocatable_handle::moves = 0;
+int throwing_copy::copies = 0;
+int throwing_copy::fail_at = 0;
+int throwing_copy::alive = 0;
+}  // namespace
+
+template <>
+struct bmstu::is_trivially_relocatable<relocatable_handle> : std::true_type
+{
+};
+
+TEST(Relocate, Trait)
+{
+	ASSERT_TRUE(bmstu::is_trivially_relocatable_v<int>);
+	ASSERT_TRUE(bmstu::is_trivially_relocatable_v<point>);
+	ASSERT_FALSE(bmstu::is_trivially_relocatable_v<std::unique_ptr<int>>);
+	ASSERT_TRUE(bmstu::is_trivially_relocatable_v<relocatable_handle>);
+}
+
+TEST(Relocate, TrivialTypes)
+{
+	point src[3] = {{1, 2}, {3, 4}, {5, 6}};
+	alignas(point) unsigned char storage[sizeof(src)];
+	auto* dest = reinterpret_cast<point*>(storage);
+
+	bmstu::uninitialized_relocate(src, 3, dest);
+	ASSERT_EQ(dest[0].x, 1);
+	ASSERT_EQ(dest[2].y, 6);
+}
+
+TEST(Relocate, NonTrivialTypes)
+{
+	auto* src = static_cast<std::string*>(
+		::operator new(2 * sizeof(std::string)));
+	auto* dest = static_cast<std::string*>(
+		::operator new(2 * sizeof(std::string)));
+	new (src) std::string(50, 'a');
+	new (src + 1) std::string("short");
+
+	bmstu::uninitialized_relocate(src, 2, dest);
+	ASSERT_EQ(dest[0], std::string(50, 'a'));
+	ASSERT_EQ(dest[1], "short");
+
+	dest[0].~basic_string();
+	dest[1].~basic_string();
+	::operator delete(src);
+	::operator delete(dest);
+}
+
+TEST(Relocate, SpecializedTypeIsNotMoved)
+{
+	auto* src = static_cast<relocatable_handle*>(
+		::operator new(2 * sizeof(relocatable_handle)));
+	auto* dest = static_cast<relocatable_handle*>(
+		::operator new(2 * sizeof(relocatable_handle)));
+	new (src) relocatable_handle(1);
+	new (src + 1) relocatable_handle(2);
+	relocatable_handle::moves = 0;
+
+	bmstu::uninitialized_relocate(src, 2, dest);
+	ASSERT_EQ(relocatable_handle::moves, 0);
+	ASSERT_EQ(*dest[0].value, 1);
+	ASSERT_EQ(*dest[1].value, 2);
+
+	dest[0].~relocatable_handle();
+	dest[1].~relocatable_handle();
+	::operator delete(src);
+	::operator delete(dest);
+}
+
+TEST(Relocate, ThrowingCopyLeavesSourceIntact)
+{
+	auto* src = static_cast<throwing_copy*>(
+		::operator new(3 * sizeof(throwing_copy)));
+	auto* dest = static_cast<throwing_copy*>(
+		::operator new(3 * sizeof(throwing_copy)));
+	for (int i = 0; i < 3; ++i)
+	{
+		new (src + i) throwing_copy(i);
+	}
+	throwing_copy::copies = 0;
+	throwing_copy::fail_at = 3;
+
+	// две копии уже созданы в dest и должны быть уничтожены, src цела
+	ASSERT_THROW(bmstu::uninitialized_relocate(src, 3, dest),
+				 std::runtime_error);
+	ASSERT_EQ(throwing_copy::alive, 3);
+	ASSERT_EQ(src[2].value, 2);
+
+	throwing_copy::fail_at = 0;
+	bmstu::uninitialized_relocate(src, 3, dest);
+	ASSERT_EQ(throwing_copy::alive, 3);
+	ASSERT_EQ(dest[0].value, 0);
+	ASSERT_EQ(dest[2].value, 2);
+
+	for (int i = 0; i < 3; ++i)
+	{
+		dest[i].~throwing_copy();
+	}
+	::operator delete(src);
+	::operator delete(dest);
+}
@@ -0,0 +1,76 @@
+#include "bmstu_node_pool.h"
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+namespace
+{
+struct alignas(32) wide_node
+{
+	char payload[40];
+};
+}  // namespace
+
+TEST(NodePool, SlotsAreAlignedAndDistinct)
+{
+	bmstu::node_pool pool(sizeof(wide_node), alignof(wide_node), 4);
+	ASSERT_EQ(pool.slot_size(), 64u);
+
+	std::set<void*> slots;
+	for (int i = 0; i < 10; ++i)
+	{
+		void* slot = pool.allocate();
+		ASSERT_EQ(reinterpret_cast<std::uintptr_t>(slot) % 32, 0u);
+		ASSERT_TRUE(slots.insert(slot).second);
+	}
+	ASSERT_EQ(pool.block_count(), 3u);
+	for (void* slot : slots)
+	{
+		pool.deallocate(slot);
+	}
+}
+
+TEST(NodePool, FreedSlotsAreReused)
+{
+	bmstu::node_pool pool(sizeof(int), alignof(int), 8);
+	std::vector<void*> slots;
+	for (int i = 0; i < 8; ++i)
+	{
+		slots.push_back(pool.allocate());
+	}
+	pool.deallocate(slots[3]);
+	pool.deallocate(slots[5]);
+	ASSERT_EQ(pool.allocate(), slots[5]);
+	ASSERT_EQ(pool.allocate(), slots[3]);
+	ASSERT_EQ(pool.block_count(), 1u);
+}
+
+TEST(PoolAllocator, CopiesShareRebindsAndContainerCopiesDoNot)
+{
+	bmstu::pool_allocator<int> alloc(16);
+	bmstu::pool_allocator<int> copy(alloc);
+	bmstu::pool_allocator<double> rebound(alloc);
+	ASSERT_TRUE(alloc == copy);
+	ASSERT_TRUE(alloc == rebound);
+	ASSERT_FALSE(alloc == alloc.select_on_container_copy_construction());
+
+	int* a = alloc.allocate(1);
+	int* b = copy.allocate(1);
+	// ячейка не меньше указателя списка свободных
+	ASSERT_EQ(reinterpret_cast<char*>(b) - reinterpret_cast<char*>(a),
+			  static_cast<std::ptrdiff_t>(sizeof(void*)));
+	ASSERT_EQ(alloc.block_count(), 1u);
+	copy.deallocate(a, 1);
+	ASSERT_EQ(alloc.allocate(1), a);
+
+	// пул настроен на int: массивы и объекты другого размера идут мимо него
+	double* d = rebound.allocate(1);
+	int* array = alloc.allocate(100);
+	ASSERT_EQ(alloc.block_count(), 1u);
+	rebound.deallocate(d, 1);
+	alloc.deallocate(array, 100);
+	alloc.deallocate(a, 1);
+	alloc.deallocate(b, 1);
+}
@@ -1,7 +1,9 @@
 #pragma once
 #include <cstdint>
 #include <exception>
+#include <new>
 #include <type_traits>
+#include <utility>
 
 namespace bmstu
 {
@@ -16,7 +18,10 @@ class bad_optional_access : public std::exception
    public:
 	using exception::exception;
 
-	const char* what() const noexcept override { return "WRONG TEXT"; }
+	const char* what() const noexcept override
+	{
+		return "Bad optional access";
+	}
 };
 
 template <typename T>
@@ -25,69 +30,175 @@ class optional
    public:
 	optional() = default;
 
-	optional(const T& value) {}
+	optional(nullopt_t) noexcept {}
 
-	optional(T&& value) {}
+	optional(const T& value)
+	{
+		new (data_) T(value);
+		is_initialized_ = true;
+	}
 
-	optional(const optional& other) {}
+	optional(T&& value)
+	{
+		new (data_) T(std::move(value));
+		is_initialized_ = true;
+	}
 
-	optional(optional&& other) noexcept {}
+	optional(const optional& other)
+	{
+		if (other.is_initialized_)
+		{
+			new (data_) T(*other);
+			is_initialized_ = true;
+		}
+	}
 
-	optional& operator=(const T& value) { return *this; }
+	optional(optional&& other) noexcept
+	{
+		if (other.is_initialized_)
+		{
+			new (data_) T(std::move(*other));
+			is_initialized_ = true;
+		}
+	}
 
-	optional& operator=(T&& value) { return *this; }
+	optional& operator=(nullopt_t) noexcept
+	{
+		reset();
+		return *this;
+	}
 
-	optional& operator=(const optional& value) { return *this; }
+	optional& operator=(const T& value)
+	{
+		if (is_initialized_)
+		{
+			**this = value;
+		}
+		else
+		{
+			new (data_) T(value);
+			is_initialized_ = true;
+		}
+		return *this;
+	}
 
-	optional& operator=(optional&& value) { return *this; }
+	optional& operator=(T&& value)
+	{
+		if (is_initialized_)
+		{
+			**this = std::move(value);
+		}
+		else
+		{
+			new (data_) T(std::move(value));
+			is_initialized_ = true;
+		}
+		return *this;
+	}
 
-	T& operator*() &
+	optional& operator=(const optional& value)
 	{
-		T* ptr = nullptr;
-		return *ptr;
+		if (this == &value)
+		{
+			return *this;
+		}
+		if (value.is_initialized_)
+		{
+			*this = *value;
+		}
+		else
+		{
+			reset();
+		}
+		return *this;
 	}
 
-	const T& operator*() const&
+	optional& operator=(optional&& value)
 	{
-		T* ptr = nullptr;
-		return *ptr;
+		if (this == &value)
+		{
+			return *this;
+		}
+		if (value.is_initialized_)
+		{
+			*this = std::move(*value);
+		}
+		else
+		{
+			reset();
+		}
+		return *this;
 	}
 
-	T* operator->() { return nullptr; }
+	T& operator*() & { return *ptr_(); }
 
-	const T* operator->() const { return nullptr; }
+	const T& operator*() const& { return *ptr_(); }
 
-	T&& operator*() &&
-	{
-		T* ptr = nullptr;
-		return std::move(*ptr);
-	}
+	T* operator->() { return ptr_(); }
+
+	const T* operator->() const { return ptr_(); }
+
+	T&& operator*() && { return std::move(*ptr_()); }
 
 	T& value() &
 	{
-		T* ptr = nullptr;
-		return *ptr;
+		if (!is_initialized_)
+		{
+			throw bad_optional_access();
+		}
+		return *ptr_();
 	}
 
 	const T& value() const&
 	{
-		T* ptr = nullptr;
-		return *ptr;
+		if (!is_initialized_)
+		{
+			throw bad_optional_access();
+		}
+		return *ptr_();
+	}
+
+	T&& value() &&
+	{
+		if (!is_initialized_)
+		{
+			throw bad_optional_access();
+		}
+		return std::move(*ptr_());
 	}
 
 	template <typename... Args>
 	void emplace(Args&&... args)
 	{
+		reset();
+		new (data_) T(std::forward<Args>(args)...);
+		is_initialized_ = true;
 	}
 
-	void reset() {}
+	void reset()
+	{
+		if (is_initialized_)
+		{
+			ptr_()->~T();
+			is_initialized_ = false;
+		}
+	}
 
-	~optional() {}
+	~optional() { reset(); }
 
-	bool has_value() const { return false; };
+	bool has_value() const { return is_initialized_; };
+
+	explicit operator bool() const { return is_initialized_; }
 
    private:
+	T* ptr_() { return std::launder(reinterpret_cast<T*>(data_)); }
+
+	const T* ptr_() const
+	{
+		return std::launder(reinterpret_cast<const T*>(data_));
+	}
+
 	alignas(T) uint8_t data_[sizeof(T)];
 	bool is_initialized_ = false;
 };
-}  // namespace bmstu
\ No newline at end of file
+}  // namespace bmstu
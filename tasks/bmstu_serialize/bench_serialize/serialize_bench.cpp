@@ -0,0 +1,281 @@
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include "bmstu_serialize.h"
+
+// Двоичный снимок против текстового operator<< / operator>>: вектор 4M
+// double, строка 64 МБ и словарь 1e5 int -> int. Скорость — в байтах
+// исходных данных (size() * sizeof элемента) в секунду, поэтому GB/s
+// сравнимы между форматами. view — разбор заголовка снимка в памяти плюс
+// один проход по элементам.
+
+constexpr size_t vector_size = 1 << 22;
+constexpr size_t string_size = 1 << 26;
+constexpr int map_size = 100'000;
+
+static const bmstu::simple_vector<double>& numbers()
+{
+	static const auto v = [] {
+		bmstu::simple_vector<double> v;
+		v.reserve(vector_size);
+		for (size_t i = 0; i < vector_size; ++i)
+		{
+			v.push_back(static_cast<double>(i) * 1.25);
+		}
+		return v;
+	}();
+	return v;
+}
+
+static const bmstu::string& text()
+{
+	static const auto s = [] {
+		bmstu::string s(string_size);
+		for (size_t i = 0; i < string_size; ++i)
+		{
+			s[i] = static_cast<char>('a' + i % 26);
+		}
+		return s;
+	}();
+	return s;
+}
+
+static const bmstu::map<int, int>& dictionary()
+{
+	static const auto m = [] {
+		bmstu::map<int, int> m;
+		for (int i = 0; i < map_size; ++i)
+		{
+			m.insert(i * 7, i);
+		}
+		return m;
+	}();
+	return m;
+}
+
+template <typename T>
+static std::string snapshot_of(const T& value)
+{
+	std::ostringstream os;
+	bmstu::snapshot::save(os, value);
+	return std::move(os).str();
+}
+
+// текстовый формат operator<< вектора: "{a, b, c}"
+static bmstu::simple_vector<double> parse_text(std::istream& is)
+{
+	bmstu::simple_vector<double> v;
+	char separator = 0;
+	is >> separator;
+	double value;
+	while (is >> value)
+	{
+		v.push_back(value);
+		is >> separator;
+	}
+	return v;
+}
+
+static void BM_VectorSaveBinary(benchmark::State& state)
+{
+	const auto& v = numbers();
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(snapshot_of(v));
+	}
+	state.SetBytesProcessed(state.iterations() * v.size() * sizeof(double));
+}
+
+static void BM_VectorSaveText(benchmark::State& state)
+{
+	const auto& v = numbers();
+	for (auto _ : state)
+	{
+		std::ostringstream os;
+		os << v;
+		benchmark::DoNotOptimize(std::move(os).str());
+	}
+	state.SetBytesProcessed(state.iterations() * v.size() * sizeof(double));
+}
+
+static void BM_VectorLoadBinary(benchmark::State& state)
+{
+	std::string bytes = snapshot_of(numbers());
+	for (auto _ : state)
+	{
+		std::istringstream is(bytes);
+		auto v = bmstu::snapshot::load<bmstu::simple_vector<double>>(is);
+		benchmark::DoNotOptimize(v);
+	}
+	state.SetBytesProcessed(state.iterations() * vector_size * sizeof(double));
+}
+
+static void BM_VectorLoadText(benchmark::State& state)
+{
+	std::ostringstream os;
+	os << numbers();
+	std::string chars = std::move(os).str();
+	for (auto _ : state)
+	{
+		std::istringstream is(chars);
+		auto v = parse_text(is);
+		benchmark::DoNotOptimize(v);
+	}
+	state.SetBytesProcessed(state.iterations() * vector_size * sizeof(double));
+}
+
+static void BM_VectorView(benchmark::State& state)
+{
+	std::string bytes = snapshot_of(numbers());
+	// выровненная копия, как у отображённого в память файла
+	bmstu::simple_vector<double> aligned(bytes.size() / sizeof(double) + 1);
+	std::memcpy(&aligned[0], bytes.data(), bytes.size());
+	auto buffer = std::as_bytes(std::span(&aligned[0], aligned.size()));
+	for (auto _ : state)
+	{
+		auto view = bmstu::snapshot::view_sequence<double>(buffer);
+		benchmark::DoNotOptimize(
+			std::accumulate(view.begin(), view.end(), 0.0));
+	}
+	state.SetBytesProcessed(state.iterations() * vector_size * sizeof(double));
+}
+
+static void BM_StringSaveBinary(benchmark::State& state)
+{
+	const auto& s = text();
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(snapshot_of(s));
+	}
+	state.SetBytesProcessed(state.iterations() * string_size);
+}
+
+static void BM_StringSaveText(benchmark::State& state)
+{
+	const auto& s = text();
+	for (auto _ : state)
+	{
+		std::ostringstream os;
+		os << s;
+		benchmark::DoNotOptimize(std::move(os).str());
+	}
+	state.SetBytesProcessed(state.iterations() * string_size);
+}
+
+static void BM_StringLoadBinary(benchmark::State& state)
+{
+	std::string bytes = snapshot_of(text());
+	for (auto _ : state)
+	{
+		std::istringstream is(bytes);
+		auto s = bmstu::snapshot::load<bmstu::string>(is);
+		benchmark::DoNotOptimize(s);
+	}
+	state.SetBytesProcessed(state.iterations() * string_size);
+}
+
+static void BM_StringLoadText(benchmark::State& state)
+{
+	std::string chars(text().c_str(), text().size());
+	for (auto _ : state)
+	{
+		std::istringstream is(chars);
+		bmstu::string s;
+		is >> s;
+		benchmark::DoNotOptimize(s);
+	}
+	state.SetBytesProcessed(state.iterations() * string_size);
+}
+
+// у map нет operator<<, текст — пары "ключ значение" построчно
+static void BM_MapSaveBinary(benchmark::State& state)
+{
+	const auto& m = dictionary();
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(snapshot_of(m));
+	}
+	state.SetBytesProcessed(state.iterations() * map_size * 2 * sizeof(int));
+}
+
+static void BM_MapSaveText(benchmark::State& state)
+{
+	const auto& m = dictionary();
+	for (auto _ : state)
+	{
+		std::ostringstream os;
+		for (const auto& [key, value] : m)
+		{
+			os << key << ' ' << value << '\n';
+		}
+		benchmark::DoNotOptimize(std::move(os).str());
+	}
+	state.SetBytesProcessed(state.iterations() * map_size * 2 * sizeof(int));
+}
+
+static void BM_MapLoadBinary(benchmark::State& state)
+{
+	std::string bytes = snapshot_of(dictionary());
+	for (auto _ : state)
+	{
+		std::istringstream is(bytes);
+		auto m = bmstu::snapshot::load<bmstu::map<int, int>>(is);
+		benchmark::DoNotOptimize(m);
+	}
+	state.SetBytesProcessed(state.iterations() * map_size * 2 * sizeof(int));
+}
+
+static void BM_MapLoadText(benchmark::State& state)
+{
+	std::ostringstream os;
+	for (const auto& [key, value] : dictionary())
+	{
+		os << key << ' ' << value << '\n';
+	}
+	std::string chars = std::move(os).str();
+	for (auto _ : state)
+	{
+		std::istringstream is(chars);
+		bmstu::map<int, int> m;
+		int key;
+		int value;
+		while (is >> key >> value)
+		{
+			m.insert(key, value);
+		}
+		benchmark::DoNotOptimize(m);
+	}
+	state.SetBytesProcessed(state.iterations() * map_size * 2 * sizeof(int));
+}
+
+static void BM_MapView(benchmark::State& state)
+{
+	std::string bytes = snapshot_of(dictionary());
+	bmstu::simple_vector<int> aligned(bytes.size() / sizeof(int) + 1);
+	std::memcpy(&aligned[0], bytes.data(), bytes.size());
+	auto buffer = std::as_bytes(std::span(&aligned[0], aligned.size()));
+	for (auto _ : state)
+	{
+		bmstu::snapshot::map_view<int, int> view(buffer);
+		benchmark::DoNotOptimize(std::accumulate(view.values().begin(),
+												 view.values().end(), 0LL));
+	}
+	state.SetBytesProcessed(state.iterations() * map_size * 2 * sizeof(int));
+}
+
+BENCHMARK(BM_VectorSaveBinary)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_VectorSaveText)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_VectorLoadBinary)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_VectorLoadText)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_VectorView)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StringSaveBinary)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StringSaveText)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StringLoadBinary)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StringLoadText)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MapSaveBinary)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MapSaveText)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MapLoadBinary)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MapLoadText)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MapView)->Unit(benchmark::kMillisecond);
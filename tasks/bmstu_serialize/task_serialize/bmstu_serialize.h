@@ -0,0 +1,629 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include "bmstu_list.h"
+#include "bmstu_map.h"
+#include "bmstu_simple_vector.h"
+#include "bmstu_sso_string.h"
+
+// Двоичный снимок контейнеров bmstu: simple_vector, list, basic_string и
+// map. Снимок начинается с заголовка (магическое число, версия формата, вид
+// контейнера и размеры элементов), за ним идёт содержимое:
+//   - вектор, список и строка — длина (uint64_t) и элементы подряд;
+//   - map — длина, затем все ключи в порядке Compare словаря (для
+//     std::less — по возрастанию), затем значения в том же порядке.
+// Тривиально копируемые элементы пишутся сырыми байтами, выровненными по
+// alignof от начала снимка, и непрерывный массив пишется одним write; прочие
+// элементы (строки, вложенные контейнеры) кодируются так же рекурсивно, но
+// без заголовка. Снимок со сырыми элементами можно не читать, а смотреть на
+// месте — view_sequence, view_string и map_view над буфером (например,
+// отображённым в память файлом), выровненным хотя бы по alignof элемента.
+//
+// Числа пишутся в порядке байт машины; снимок с другим порядком байт,
+// другой версией или другими размерами элементов отвергается с
+// std::runtime_error, как и обрезанный снимок.
+namespace bmstu::snapshot
+{
+// "BMSZ" в little-endian
+inline constexpr uint32_t magic = 0x5A534D42;
+inline constexpr uint16_t version = 1;
+
+enum class kind : uint8_t
+{
+	// simple_vector и list кодируются одинаково и взаимозаменяемы
+	sequence = 1,
+	string = 2,
+	map = 3,
+};
+
+struct header
+{
+	uint32_t magic;
+	uint16_t version;
+	snapshot::kind type;
+	uint8_t reserved;
+	// sizeof элемента (у map — ключа) и значения map, если они пишутся
+	// сырыми байтами; 0 — элемент кодируется рекурсивно
+	uint32_t key_size;
+	uint32_t value_size;
+};
+
+static_assert(sizeof(header) == 16);
+
+// указатели тривиально копируемы, но в снимке бессмысленны
+template <typename T>
+concept raw_value = std::is_trivially_copyable_v<T> && !std::is_pointer_v<T>;
+
+namespace detail
+{
+template <typename T>
+inline constexpr uint32_t raw_size = raw_value<T> ? sizeof(T) : 0;
+
+template <typename T>
+struct traits;
+
+template <typename T, typename Allocator, typename Growth>
+struct traits<simple_vector<T, Allocator, Growth>>
+{
+	static constexpr kind type = kind::sequence;
+	static constexpr uint32_t key_size = raw_size<T>;
+	static constexpr uint32_t value_size = 0;
+};
+
+template <typename T, typename Allocator>
+struct traits<list<T, Allocator>>
+{
+	static constexpr kind type = kind::sequence;
+	static constexpr uint32_t key_size = raw_size<T>;
+	static constexpr uint32_t value_size = 0;
+};
+
+template <typename T, typename Allocator>
+struct traits<basic_string<T, Allocator>>
+{
+	static constexpr kind type = kind::string;
+	static constexpr uint32_t key_size = sizeof(T);
+	static constexpr uint32_t value_size = 0;
+};
+
+template <typename K,
+		  typename V,
+		  typename Compare,
+		  typename Allocator,
+		  bool Ranked>
+struct traits<map<K, V, Compare, Allocator, Ranked>>
+{
+	static constexpr kind type = kind::map;
+	static constexpr uint32_t key_size = raw_size<K>;
+	static constexpr uint32_t value_size = raw_size<V>;
+};
+
+inline size_t padding(size_t offset, size_t alignment)
+{
+	return (alignment - offset % alignment) % alignment;
+}
+
+inline void check_header(const header& h,
+						 kind type,
+						 uint32_t key_size,
+						 uint32_t value_size)
+{
+	if (h.magic == std::byteswap(magic))
+	{
+		throw std::runtime_error("Snapshot byte order mismatch");
+	}
+	if (h.magic != magic)
+	{
+		throw std::runtime_error("Not a bmstu snapshot");
+	}
+	if (h.version != version)
+	{
+		throw std::runtime_error("Unsupported snapshot version");
+	}
+	if (h.type != type || h.key_size != key_size ||
+		h.value_size != value_size)
+	{
+		throw std::runtime_error("Snapshot type mismatch");
+	}
+}
+
+[[noreturn]] inline void throw_truncated()
+{
+	throw std::runtime_error("Truncated snapshot");
+}
+
+// Столько байт можно выделить заранее под длину из снимка, когда размер
+// потока неизвестен; дальше память растёт по мере чтения.
+inline constexpr size_t read_chunk = size_t{1} << 20;
+
+// длина из снимка, если count элементов по size байт помещаются в size_t
+inline size_t checked_count(uint64_t count, size_t size)
+{
+	if (count > std::numeric_limits<size_t>::max() / size)
+	{
+		throw std::runtime_error("Corrupted snapshot length");
+	}
+	return static_cast<size_t>(count);
+}
+
+// поток с подсчётом записанных байт: от него считается выравнивание
+class writer
+{
+   public:
+	explicit writer(std::ostream& os) : os_(os) {}
+
+	void write(const void* data, size_t size)
+	{
+		os_.write(static_cast<const char*>(data),
+				  static_cast<std::streamsize>(size));
+		if (!os_)
+		{
+			throw std::runtime_error("Snapshot write failed");
+		}
+		position_ += size;
+	}
+
+	template <raw_value T>
+	void raw(const T& value)
+	{
+		write(std::addressof(value), sizeof(T));
+	}
+
+	void align(size_t alignment)
+	{
+		static constexpr char zeros[16] = {};
+		for (size_t left = padding(position_, alignment); left > 0;)
+		{
+			size_t chunk = std::min(left, sizeof(zeros));
+			write(zeros, chunk);
+			left -= chunk;
+		}
+	}
+
+   private:
+	std::ostream& os_;
+	size_t position_ = 0;
+};
+
+// Длины из снимка не проверены. Если поток позволяет узнать свой размер
+// (файл, строка), длина сверяется с оставшимися байтами; иначе (pipe)
+// испорченная длина упирается в конец потока, а не в огромное выделение.
+class reader
+{
+   public:
+	explicit reader(std::istream& is) : is_(is)
+	{
+		auto start = is_.tellg();
+		if (start == std::istream::pos_type(-1))
+		{
+			return;
+		}
+		is_.seekg(0, std::ios::end);
+		auto end = is_.tellg();
+		is_.seekg(start);
+		if (end != std::istream::pos_type(-1) && is_)
+		{
+			size_ = static_cast<size_t>(end - start);
+		}
+		is_.clear();
+	}
+
+	void read(void* data, size_t size)
+	{
+		is_.read(static_cast<char*>(data), static_cast<std::streamsize>(size));
+		if (static_cast<size_t>(is_.gcount()) != size)
+		{
+			throw_truncated();
+		}
+		position_ += size;
+	}
+
+	template <raw_value T>
+	T raw()
+	{
+		T value;
+		read(std::addressof(value), sizeof(T));
+		return value;
+	}
+
+	void align(size_t alignment)
+	{
+		auto size = static_cast<std::streamsize>(padding(position_, alignment));
+		is_.ignore(size);
+		if (is_.gcount() != size)
+		{
+			throw_truncated();
+		}
+		position_ += static_cast<size_t>(size);
+	}
+
+	// сколько из count элементов по size байт выделить заранее
+	size_t upfront(size_t count, size_t size) const
+	{
+		if (size_ == unknown)
+		{
+			return std::min(count, std::max<size_t>(1, read_chunk / size));
+		}
+		if (count > (size_ - position_) / size)
+		{
+			throw_truncated();
+		}
+		return count;
+	}
+
+   private:
+	static constexpr size_t unknown = std::numeric_limits<size_t>::max();
+
+	std::istream& is_;
+	size_t position_ = 0;
+	size_t size_ = unknown;
+};
+
+// чтение снимка на месте, без копирования элементов
+class cursor
+{
+   public:
+	explicit cursor(std::span<const std::byte> bytes) : bytes_(bytes) {}
+
+	template <raw_value T>
+	T raw()
+	{
+		T value;
+		std::memcpy(std::addressof(value), take_(sizeof(T)), sizeof(T));
+		return value;
+	}
+
+	template <raw_value T>
+	std::span<const T> array(uint64_t count)
+	{
+		take_(padding(offset_, alignof(T)));
+		if (count > (bytes_.size() - offset_) / sizeof(T))
+		{
+			throw_truncated();
+		}
+		const std::byte* data = take_(count * sizeof(T));
+		if (reinterpret_cast<uintptr_t>(data) % alignof(T) != 0)
+		{
+			throw std::runtime_error("Misaligned snapshot buffer");
+		}
+		return {reinterpret_cast<const T*>(data), static_cast<size_t>(count)};
+	}
+
+   private:
+	const std::byte* take_(size_t size)
+	{
+		if (size > bytes_.size() - offset_)
+		{
+			throw_truncated();
+		}
+		const std::byte* data = bytes_.data() + offset_;
+		offset_ += size;
+		return data;
+	}
+
+	std::span<const std::byte> bytes_;
+	size_t offset_ = 0;
+};
+
+// Перегрузки объявлены заранее, чтобы вложенные контейнеры (например,
+// вектор строк) находили друг друга при инстанцировании.
+template <raw_value T>
+void encode(writer& w, const T& value);
+template <typename T, typename Allocator, typename Growth>
+void encode(writer& w, const simple_vector<T, Allocator, Growth>& v);
+template <typename T, typename Allocator>
+void encode(writer& w, const list<T, Allocator>& l);
+template <typename T, typename Allocator>
+void encode(writer& w, const basic_string<T, Allocator>& s);
+template <typename K,
+		  typename V,
+		  typename Compare,
+		  typename Allocator,
+		  bool Ranked>
+void encode(writer& w, const map<K, V, Compare, Allocator, Ranked>& m);
+
+template <raw_value T>
+void decode(reader& r, T& value);
+template <typename T, typename Allocator, typename Growth>
+void decode(reader& r, simple_vector<T, Allocator, Growth>& v);
+template <typename T, typename Allocator>
+void decode(reader& r, list<T, Allocator>& l);
+template <typename T, typename Allocator>
+void decode(reader& r, basic_string<T, Allocator>& s);
+template <typename K,
+		  typename V,
+		  typename Compare,
+		  typename Allocator,
+		  bool Ranked>
+void decode(reader& r, map<K, V, Compare, Allocator, Ranked>& m);
+
+// count элементов начиная с first; непрерывный массив сырых элементов
+// уходит в поток одним write
+template <typename T, typename It>
+void encode_elements(writer& w, It first, size_t count)
+{
+	if constexpr (raw_value<T>)
+	{
+		w.align(alignof(T));
+		if constexpr (std::contiguous_iterator<It>)
+		{
+			if (count > 0)
+			{
+				w.write(std::to_address(first), count * sizeof(T));
+			}
+			return;
+		}
+	}
+	for (size_t i = 0; i < count; ++i, ++first)
+	{
+		encode(w, *first);
+	}
+}
+
+// сырые элементы читаются прямо в память вектора одним read
+template <typename T, typename Allocator, typename Growth>
+void decode_elements(reader& r,
+					 simple_vector<T, Allocator, Growth>& v,
+					 uint64_t count)
+{
+	v.clear();
+	if constexpr (raw_value<T>)
+	{
+		size_t total = checked_count(count, sizeof(T));
+		r.align(alignof(T));
+		for (size_t done = 0; done < total;)
+		{
+			size_t part = r.upfront(total - done, sizeof(T));
+			v.resize(done + part);
+			r.read(std::to_address(v.begin()) + done, part * sizeof(T));
+			done += part;
+		}
+	}
+	else
+	{
+		// элемент кодируется хотя бы одним байтом, но в памяти занимает
+		// sizeof(T), поэтому заранее — не больше read_chunk байт
+		v.reserve(static_cast<size_t>(
+			std::min<uint64_t>(count, read_chunk / sizeof(T))));
+		for (uint64_t i = 0; i < count; ++i)
+		{
+			T value;
+			decode(r, value);
+			v.push_back(std::move(value));
+		}
+	}
+}
+
+template <raw_value T>
+void encode(writer& w, const T& value)
+{
+	w.raw(value);
+}
+
+template <typename T, typename Allocator, typename Growth>
+void encode(writer& w, const simple_vector<T, Allocator, Growth>& v)
+{
+	w.raw(static_cast<uint64_t>(v.size()));
+	encode_elements<T>(w, v.begin(), v.size());
+}
+
+template <typename T, typename Allocator>
+void encode(writer& w, const list<T, Allocator>& l)
+{
+	w.raw(static_cast<uint64_t>(l.size()));
+	encode_elements<T>(w, l.begin(), l.size());
+}
+
+template <typename T, typename Allocator>
+void encode(writer& w, const basic_string<T, Allocator>& s)
+{
+	w.raw(static_cast<uint64_t>(s.size()));
+	encode_elements<T>(w, s.c_str(), s.size());
+}
+
+template <typename K,
+		  typename V,
+		  typename Compare,
+		  typename Allocator,
+		  bool Ranked>
+void encode(writer& w, const map<K, V, Compare, Allocator, Ranked>& m)
+{
+	w.raw(static_cast<uint64_t>(m.size()));
+	if constexpr (raw_value<K>)
+	{
+		w.align(alignof(K));
+	}
+	for (const auto& [key, value] : m)
+	{
+		encode(w, key);
+	}
+	if constexpr (raw_value<V>)
+	{
+		w.align(alignof(V));
+	}
+	for (const auto& [key, value] : m)
+	{
+		encode(w, value);
+	}
+}
+
+template <raw_value T>
+void decode(reader& r, T& value)
+{
+	r.read(std::addressof(value), sizeof(T));
+}
+
+template <typename T, typename Allocator, typename Growth>
+void decode(reader& r, simple_vector<T, Allocator, Growth>& v)
+{
+	decode_elements(r, v, r.raw<uint64_t>());
+}
+
+template <typename T, typename Allocator>
+void decode(reader& r, list<T, Allocator>& l)
+{
+	auto count = r.raw<uint64_t>();
+	l.clear();
+	if constexpr (raw_value<T>)
+	{
+		r.align(alignof(T));
+	}
+	for (uint64_t i = 0; i < count; ++i)
+	{
+		T value;
+		decode(r, value);
+		l.emplace_back(std::move(value));
+	}
+}
+
+template <typename T, typename Allocator>
+void decode(reader& r, basic_string<T, Allocator>& s)
+{
+	size_t total = checked_count(r.raw<uint64_t>(), sizeof(T));
+	r.align(alignof(T));
+	size_t part = r.upfront(total, sizeof(T));
+	s = basic_string<T, Allocator>(part, s.get_allocator());
+	r.read(s.data(), part * sizeof(T));
+	for (size_t done = part; done < total; done += part)
+	{
+		part = r.upfront(total - done, sizeof(T));
+		basic_string<T, Allocator> tail(part, s.get_allocator());
+		r.read(tail.data(), part * sizeof(T));
+		s += tail;
+	}
+}
+
+template <typename K,
+		  typename V,
+		  typename Compare,
+		  typename Allocator,
+		  bool Ranked>
+void decode(reader& r, map<K, V, Compare, Allocator, Ranked>& m)
+{
+	simple_vector<K> keys;
+	decode_elements(r, keys, r.raw<uint64_t>());
+	m.clear();
+	if constexpr (raw_value<V>)
+	{
+		r.align(alignof(V));
+	}
+	for (const K& key : keys)
+	{
+		V value;
+		decode(r, value);
+		m.insert(key, value);
+	}
+}
+
+template <typename T>
+concept container = requires { traits<T>::type; };
+}  // namespace detail
+
+template <detail::container T>
+void save(std::ostream& os, const T& value)
+{
+	using traits = detail::traits<T>;
+	detail::writer w(os);
+	w.raw(header{magic, version, traits::type, 0, traits::key_size,
+				 traits::value_size});
+	detail::encode(w, value);
+}
+
+// содержимое out заменяется; его аллокатор сохраняется
+template <detail::container T>
+void load(std::istream& is, T& out)
+{
+	using traits = detail::traits<T>;
+	detail::reader r(is);
+	detail::check_header(r.raw<header>(), traits::type, traits::key_size,
+						 traits::value_size);
+	detail::decode(r, out);
+}
+
+template <detail::container T>
+T load(std::istream& is)
+{
+	T result;
+	load(is, result);
+	return result;
+}
+
+// Элементы снимка simple_vector<T> или list<T> без копирования. Буфер
+// должен жить дольше результата.
+template <raw_value T>
+std::span<const T> view_sequence(std::span<const std::byte> bytes)
+{
+	detail::cursor c(bytes);
+	detail::check_header(c.raw<header>(), kind::sequence, sizeof(T), 0);
+	return c.array<T>(c.raw<uint64_t>());
+}
+
+template <raw_value T>
+std::basic_string_view<T> view_string(std::span<const std::byte> bytes)
+{
+	detail::cursor c(bytes);
+	detail::check_header(c.raw<header>(), kind::string, sizeof(T), 0);
+	auto chars = c.array<T>(c.raw<uint64_t>());
+	return {chars.data(), chars.size()};
+}
+
+// Словарь из снимка map<K, V, Compare> без копирования: поиск — двоичный
+// по массиву ключей. Ключи лежат в порядке Compare словаря, поэтому
+// Compare должен быть тем же, что у сохранённого map. Буфер должен жить
+// дольше map_view.
+template <raw_value K, raw_value V, typename Compare = std::less<K>>
+class map_view
+{
+   public:
+	explicit map_view(std::span<const std::byte> bytes,
+					  const Compare& compare = Compare())
+		: compare_(compare)
+	{
+		detail::cursor c(bytes);
+		detail::check_header(c.raw<header>(), kind::map, sizeof(K), sizeof(V));
+		auto count = c.raw<uint64_t>();
+		keys_ = c.array<K>(count);
+		values_ = c.array<V>(count);
+	}
+
+	size_t size() const noexcept { return keys_.size(); }
+
+	bool empty() const noexcept { return keys_.empty(); }
+
+	std::span<const K> keys() const noexcept { return keys_; }
+
+	std::span<const V> values() const noexcept { return values_; }
+
+	const V* find(const K& key) const
+	{
+		auto it = std::lower_bound(keys_.begin(), keys_.end(), key, compare_);
+		if (it == keys_.end() || compare_(key, *it))
+		{
+			return nullptr;
+		}
+		return &values_[static_cast<size_t>(it - keys_.begin())];
+	}
+
+	bool contains(const K& key) const { return find(key) != nullptr; }
+
+   private:
+	std::span<const K> keys_;
+	std::span<const V> values_;
+	[[no_unique_address]] Compare compare_;
+};
+}  // namespace bmstu::snapshot
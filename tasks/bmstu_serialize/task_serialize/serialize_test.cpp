@@ -0,0 +1,312 @@
+// bmstu_map.h подключается раньше bmstu_serialize.h, который включает его
+// повторно: так тест проверяет, что заголовки не конфликтуют
+#include "bmstu_map.h"
+#include "bmstu_serialize.h"
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory_resource>
+#include <sstream>
+#include <streambuf>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include "bmstu_mapped_vector.h"
+
+#ifdef BMSTU_HAS_MMAP
+#include <unistd.h>
+#endif
+
+namespace
+{
+template <typename T>
+std::string to_bytes(const T& value)
+{
+	std::ostringstream os;
+	bmstu::snapshot::save(os, value);
+	return std::move(os).str();
+}
+
+template <typename T>
+T from_bytes(const std::string& bytes)
+{
+	std::istringstream is(bytes);
+	return bmstu::snapshot::load<T>(is);
+}
+
+// поток без позиционирования, как pipe: размер снимка заранее неизвестен
+class pipe_buffer : public std::streambuf
+{
+   public:
+	explicit pipe_buffer(std::string bytes) : bytes_(std::move(bytes))
+	{
+		setg(bytes_.data(), bytes_.data(), bytes_.data() + bytes_.size());
+	}
+
+   private:
+	std::string bytes_;
+};
+
+template <typename T>
+T from_pipe(const std::string& bytes)
+{
+	pipe_buffer buffer(bytes);
+	std::istream is(&buffer);
+	return bmstu::snapshot::load<T>(is);
+}
+
+std::string_view text_of(const bmstu::string& s)
+{
+	return {s.c_str(), s.size()};
+}
+
+template <typename K, typename V>
+bool same_entries(bmstu::map<K, V>& lhs, bmstu::map<K, V>& rhs)
+{
+	if (lhs.size() != rhs.size())
+	{
+		return false;
+	}
+	for (auto it = lhs.begin(); it != lhs.end(); ++it)
+	{
+		const V* value = rhs.find(it->first);
+		if (value == nullptr || !(*value == it->second))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+}  // namespace
+
+TEST(Snapshot, VectorRoundTrip)
+{
+	bmstu::simple_vector<int> ints;
+	for (int i = 0; i < 10000; ++i)
+	{
+		ints.push_back(i * 7 - 5000);
+	}
+	std::string bytes = to_bytes(ints);
+	// заголовок, длина и сами элементы, без разделителей
+	ASSERT_EQ(bytes.size(), sizeof(bmstu::snapshot::header) +
+								sizeof(uint64_t) + ints.size() * sizeof(int));
+	ASSERT_EQ(from_bytes<bmstu::simple_vector<int>>(bytes), ints);
+
+	ASSERT_TRUE(from_bytes<bmstu::simple_vector<double>>(
+					to_bytes(bmstu::simple_vector<double>{}))
+					.empty());
+
+	// из потока неизвестного размера длинный массив читается по частям
+	bmstu::simple_vector<int64_t> large(
+		3 * bmstu::snapshot::detail::read_chunk / sizeof(int64_t) + 5);
+	for (size_t i = 0; i < large.size(); ++i)
+	{
+		large[i] = static_cast<int64_t>(i) * 3;
+	}
+	ASSERT_EQ(from_bytes<decltype(large)>(to_bytes(large)), large);
+	ASSERT_EQ(from_pipe<decltype(large)>(to_bytes(large)), large);
+
+	bmstu::simple_vector<bmstu::string> words{
+		"", "short", "a string long enough to leave the buffer"};
+	auto restored_words =
+		from_bytes<bmstu::simple_vector<bmstu::string>>(to_bytes(words));
+	ASSERT_EQ(restored_words.size(), words.size());
+	for (size_t i = 0; i < words.size(); ++i)
+	{
+		ASSERT_EQ(text_of(restored_words[i]), text_of(words[i]));
+	}
+
+	bmstu::simple_vector<bmstu::simple_vector<char>> nested{
+		{}, {'a'}, {'b', 'c', 'd'}};
+	ASSERT_EQ(from_bytes<decltype(nested)>(to_bytes(nested)), nested);
+
+	// снимок вектора читается как список и наоборот
+	auto as_list = from_bytes<bmstu::list<int>>(bytes);
+	ASSERT_EQ(as_list.size(), ints.size());
+	ASSERT_EQ(from_bytes<bmstu::simple_vector<int>>(to_bytes(as_list)), ints);
+}
+
+TEST(Snapshot, StringAndMapRoundTrip)
+{
+	// нулевой символ внутри строки переживает снимок
+	bmstu::string text("binary");
+	text += '\0';
+	text += "snapshot";
+	ASSERT_EQ(text_of(from_bytes<bmstu::string>(to_bytes(text))),
+			  text_of(text));
+	auto wide =
+		from_bytes<bmstu::u32string>(to_bytes(bmstu::u32string(U"юникод")));
+	ASSERT_EQ(std::u32string_view(wide.c_str(), wide.size()), U"юникод");
+	bmstu::u32string long_wide(
+		2 * bmstu::snapshot::detail::read_chunk / sizeof(char32_t) + 3);
+	long_wide[0] = U'н';
+	long_wide[long_wide.size() - 1] = U'к';
+	auto restored_long = from_pipe<bmstu::u32string>(to_bytes(long_wide));
+	ASSERT_EQ(std::u32string_view(restored_long.c_str(), restored_long.size()),
+			  std::u32string_view(long_wide.c_str(), long_wide.size()));
+
+	// символы широкой строки выровнены по alignof(char32_t) от начала
+	// снимка, перед ними здесь ключ в один байт
+	bmstu::map<char, bmstu::u32string> wide_values;
+	wide_values.insert('a', bmstu::u32string(U"xyz"));
+	auto restored_wide = from_bytes<decltype(wide_values)>(
+		to_bytes(wide_values));
+	const auto& xyz = restored_wide.at('a');
+	ASSERT_EQ(std::u32string_view(xyz.c_str(), xyz.size()), U"xyz");
+
+	bmstu::map<int, double> numbers;
+	for (int i = 0; i < 1000; ++i)
+	{
+		numbers.insert((i * 37) % 1000, i * 0.5);
+	}
+	auto restored = from_bytes<bmstu::map<int, double>>(to_bytes(numbers));
+	ASSERT_TRUE(same_entries(restored, numbers));
+
+	bmstu::map<int, bmstu::simple_vector<int>> index;
+	index.insert(1, {1});
+	index.insert(4, {1, 2, 3, 4});
+	index.insert(0, {});
+	auto restored_index = from_bytes<decltype(index)>(to_bytes(index));
+	ASSERT_TRUE(same_entries(restored_index, index));
+
+	// аллокатор приёмника сохраняется
+	std::pmr::monotonic_buffer_resource arena;
+	bmstu::pmr::map<int, double> pooled(&arena);
+	std::istringstream is(to_bytes(numbers));
+	bmstu::snapshot::load(is, pooled);
+	ASSERT_EQ(pooled.get_allocator().resource(), &arena);
+	ASSERT_EQ(pooled.size(), numbers.size());
+	ASSERT_EQ(pooled.at(37), 0.5);
+
+	// ranked::map отличается только счётчиками в узлах
+	bmstu::ranked::map<int, double> ranked;
+	std::istringstream ranked_is(to_bytes(numbers));
+	bmstu::snapshot::load(ranked_is, ranked);
+	ASSERT_EQ(ranked.size(), numbers.size());
+	ASSERT_EQ(ranked.nth(37)->second, numbers.at(37));
+	ASSERT_EQ(to_bytes(ranked), to_bytes(numbers));
+}
+
+TEST(Snapshot, ViewsWithoutCopying)
+{
+	bmstu::simple_vector<int64_t> values;
+	bmstu::map<int, float> prices;
+	for (int i = 0; i < 5000; ++i)
+	{
+		values.push_back(int64_t{i} << 33);
+		prices.insert(i * 2, i * 0.25f);
+	}
+	std::string bytes = to_bytes(values);
+	// буфер std::string не обязан быть выровнен по 8, поэтому копия в
+	// выровненный массив
+	bmstu::simple_vector<uint64_t> aligned(bytes.size() / 8 + 1);
+	std::memcpy(&aligned[0], bytes.data(), bytes.size());
+	auto view = bmstu::snapshot::view_sequence<int64_t>(
+		std::as_bytes(std::span(&aligned[0], aligned.size())));
+	ASSERT_TRUE(std::ranges::equal(view, values));
+
+	bytes = to_bytes(prices);
+	aligned.resize(bytes.size() / 8 + 1);
+	std::memcpy(&aligned[0], bytes.data(), bytes.size());
+	bmstu::snapshot::map_view<int, float> price_view(
+		std::as_bytes(std::span(&aligned[0], aligned.size())));
+	ASSERT_EQ(price_view.size(), 5000u);
+	ASSERT_TRUE(std::ranges::is_sorted(price_view.keys()));
+	ASSERT_EQ(*price_view.find(4242), 2121 * 0.25f);
+	ASSERT_EQ(price_view.find(4243), nullptr);
+
+	// ключи лежат в порядке Compare словаря, и map_view ищет тем же Compare
+	bmstu::map<int, float, std::greater<int>> descending;
+	for (int i = 0; i < 100; ++i)
+	{
+		descending.insert(i, i * 0.5f);
+	}
+	bytes = to_bytes(descending);
+	aligned.resize(bytes.size() / 8 + 1);
+	std::memcpy(&aligned[0], bytes.data(), bytes.size());
+	bmstu::snapshot::map_view<int, float, std::greater<int>> descending_view(
+		std::as_bytes(std::span(&aligned[0], aligned.size())));
+	ASSERT_EQ(descending_view.keys().front(), 99);
+	for (int i = 0; i < 100; ++i)
+	{
+		ASSERT_EQ(*descending_view.find(i), i * 0.5f);
+	}
+	ASSERT_FALSE(descending_view.contains(100));
+
+	bytes = to_bytes(bmstu::string("view me"));
+	auto text = bmstu::snapshot::view_string<char>(std::as_bytes(
+		std::span(bytes.data(), bytes.size())));
+	ASSERT_EQ(text, "view me");
+
+#ifdef BMSTU_HAS_MMAP
+	// снимок в файле смотрится через отображение без чтения
+	auto path = std::filesystem::temp_directory_path() /
+				("bmstu_snapshot_" + std::to_string(::getpid()));
+	{
+		std::ofstream file(path, std::ios::binary);
+		bmstu::snapshot::save(file, values);
+	}
+	{
+		bmstu::mapped_vector<std::byte> mapped(path,
+											   bmstu::map_mode::read_only);
+		auto mapped_view = bmstu::snapshot::view_sequence<int64_t>(
+			std::span(mapped.data(), mapped.size()));
+		ASSERT_TRUE(std::ranges::equal(mapped_view, values));
+	}
+	std::filesystem::remove(path);
+#endif
+}
+
+TEST(Snapshot, RejectsForeignData)
+{
+	using bmstu::simple_vector;
+	std::string bytes = to_bytes(simple_vector<int>{1, 2, 3});
+
+	ASSERT_THROW(from_bytes<simple_vector<int>>(bytes.substr(0, 30)),
+				 std::runtime_error);
+	ASSERT_THROW(from_bytes<simple_vector<int>>(bytes.substr(0, 10)),
+				 std::runtime_error);
+	ASSERT_THROW(from_bytes<simple_vector<long long>>(bytes),
+				 std::runtime_error);
+	ASSERT_THROW(from_bytes<bmstu::string>(bytes), std::runtime_error);
+	ASSERT_THROW(from_bytes<simple_vector<int>>("{1, 2, 3}"),
+				 std::runtime_error);
+
+	std::string newer = bytes;
+	newer[4] = static_cast<char>(bmstu::snapshot::version + 1);
+	ASSERT_THROW(from_bytes<simple_vector<int>>(newer), std::runtime_error);
+
+	std::string swapped = bytes;
+	std::reverse(swapped.begin(), swapped.begin() + 4);
+	ASSERT_THROW(from_bytes<simple_vector<int>>(swapped), std::runtime_error);
+
+	// испорченная длина: переполнение size_t или больше, чем есть в потоке
+	for (uint64_t length : {~uint64_t{0}, uint64_t{1} << 40})
+	{
+		std::string corrupted = bytes;
+		std::memcpy(corrupted.data() + sizeof(bmstu::snapshot::header),
+					&length, sizeof(length));
+		ASSERT_THROW(from_bytes<simple_vector<int>>(corrupted),
+					 std::runtime_error);
+		ASSERT_THROW(from_pipe<simple_vector<int>>(corrupted),
+					 std::runtime_error);
+		ASSERT_THROW(from_bytes<bmstu::list<int>>(corrupted),
+					 std::runtime_error);
+
+		corrupted = to_bytes(bmstu::u32string(U"text"));
+		std::memcpy(corrupted.data() + sizeof(bmstu::snapshot::header),
+					&length, sizeof(length));
+		ASSERT_THROW(from_bytes<bmstu::u32string>(corrupted),
+					 std::runtime_error);
+		ASSERT_THROW(from_pipe<bmstu::u32string>(corrupted),
+					 std::runtime_error);
+	}
+
+	auto span = std::as_bytes(std::span(bytes.data(), bytes.size() - 1));
+	ASSERT_THROW(bmstu::snapshot::view_sequence<int>(span), std::runtime_error);
+}
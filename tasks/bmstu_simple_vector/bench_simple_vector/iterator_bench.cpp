@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+#include "bmstu_simple_vector.h"
+
+// Итератор simple_vector — тривиально копируемая обёртка над указателем,
+// поэтому std::accumulate и std::ranges::sort должны работать с той же
+// скоростью, что и по std::vector (и компилироваться в тот же цикл).
+
+template <typename Vector>
+static Vector make_random(size_t size)
+{
+	std::mt19937 gen(42);
+	Vector v;
+	v.reserve(size);
+	for (size_t i = 0; i < size; ++i)
+	{
+		v.push_back(static_cast<int>(gen()));
+	}
+	return v;
+}
+
+template <typename Vector>
+static void BM_Accumulate(benchmark::State& state)
+{
+	const auto v = make_random<Vector>(state.range(0));
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(std::accumulate(v.begin(), v.end(), 0u));
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Vector>
+static void BM_RangeFor(benchmark::State& state)
+{
+	const auto v = make_random<Vector>(state.range(0));
+	for (auto _ : state)
+	{
+		unsigned sum = 0;
+		for (int value : v)
+		{
+			sum += value;
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Vector>
+static void BM_Sort(benchmark::State& state)
+{
+	const auto source = make_random<Vector>(state.range(0));
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		Vector v = source;
+		state.ResumeTiming();
+		std::ranges::sort(v);
+		benchmark::DoNotOptimize(v.begin());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+using std_ints = std::vector<int>;
+using bmstu_ints = bmstu::simple_vector<int>;
+
+BENCHMARK(BM_Accumulate<std_ints>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_Accumulate<bmstu_ints>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_RangeFor<std_ints>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_RangeFor<bmstu_ints>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_Sort<std_ints>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_Sort<bmstu_ints>)->Range(1 << 10, 1 << 20);
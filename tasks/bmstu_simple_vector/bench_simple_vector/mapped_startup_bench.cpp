@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+#include "bmstu_mapped_vector.h"
+
+#ifdef BMSTU_HAS_MMAP
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdio>
+#include <filesystem>
+#include <numeric>
+#include "bmstu_simple_vector.h"
+
+// Старт процесса с массивом 8M int (32 МБ) на диске: чтение файла в
+// simple_vector против отображения mapped_vector. Аргумент 1 — холодный
+// старт: перед каждой итерацией страницы файла выбрасываются из
+// страничного кэша (posix_fadvise DONTNEED), 0 — тёплый.
+
+constexpr size_t elements = 1 << 23;
+
+// файл создаётся при первом обращении и удаляется при выходе
+struct dataset_file
+{
+	dataset_file()
+		: path(std::filesystem::temp_directory_path() /
+			   ("bmstu_mapped_bench_" + std::to_string(::getpid())))
+	{
+		bmstu::mapped_vector<int> v(path);
+		v.resize(elements);
+		std::iota(v.begin(), v.end(), 0);
+	}
+
+	~dataset_file() { std::filesystem::remove(path); }
+
+	std::filesystem::path path;
+};
+
+static const std::filesystem::path& dataset()
+{
+	static const dataset_file file;
+	return file.path;
+}
+
+static void drop_page_cache(const std::filesystem::path& path)
+{
+	int fd = ::open(path.c_str(), O_RDONLY);
+	::fdatasync(fd);
+	::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+	::close(fd);
+}
+
+static void prepare(benchmark::State& state)
+{
+	if (state.range(0) == 1)
+	{
+		state.PauseTiming();
+		drop_page_cache(dataset());
+		state.ResumeTiming();
+	}
+}
+
+// O(N) загрузка: весь файл читается в память процесса
+static void BM_ReadIntoVector(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		prepare(state);
+		bmstu::simple_vector<int> v(elements);
+		std::FILE* file = std::fopen(dataset().c_str(), "rb");
+		size_t read = std::fread(&v[0], sizeof(int), elements, file);
+		std::fclose(file);
+		benchmark::DoNotOptimize(read);
+		benchmark::DoNotOptimize(v[elements / 2]);
+	}
+}
+
+// O(1) старт: отображение и одно обращение
+static void BM_MapFile(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		prepare(state);
+		bmstu::mapped_vector<int> v(dataset(), bmstu::map_mode::read_only);
+		benchmark::DoNotOptimize(v[elements / 2]);
+	}
+}
+
+// отображение и полный проход: цена ленивой подгрузки страниц
+static void BM_MapAndScan(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		prepare(state);
+		bmstu::mapped_vector<int> v(dataset(), bmstu::map_mode::read_only);
+		benchmark::DoNotOptimize(std::accumulate(v.begin(), v.end(), 0u));
+	}
+}
+
+BENCHMARK(BM_ReadIntoVector)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_MapFile)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_MapAndScan)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+#endif
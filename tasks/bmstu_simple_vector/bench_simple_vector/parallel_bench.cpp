@@ -0,0 +1,109 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include "bmstu_parallel.h"
+#include "bmstu_simple_vector.h"
+
+// Масштабирование параллельных алгоритмов: 4M элементов на пулах из 1, 2,
+// 4, 8 и 16 потоков. На машине с меньшим числом ядер лишние потоки только
+// делят время, и график это честно показывает.
+
+constexpr size_t elements = 1 << 22;
+
+static const bmstu::simple_vector<int>& source()
+{
+	static const bmstu::simple_vector<int> v = [] {
+		std::mt19937 gen(42);
+		bmstu::simple_vector<int> v;
+		v.reserve(elements);
+		for (size_t i = 0; i < elements; ++i)
+		{
+			v.push_back(static_cast<int>(gen()));
+		}
+		return v;
+	}();
+	return v;
+}
+
+static void BM_StdSort(benchmark::State& state)
+{
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		auto v = source();
+		state.ResumeTiming();
+		std::sort(v.begin(), v.end());
+		benchmark::DoNotOptimize(v.begin());
+	}
+	state.SetItemsProcessed(state.iterations() * elements);
+}
+
+static void BM_ParallelSort(benchmark::State& state)
+{
+	bmstu::thread_pool pool(state.range(0));
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		auto v = source();
+		state.ResumeTiming();
+		bmstu::parallel::sort(pool, v.begin(), v.end());
+		benchmark::DoNotOptimize(v.begin());
+	}
+	state.SetItemsProcessed(state.iterations() * elements);
+}
+
+static void BM_ParallelReduce(benchmark::State& state)
+{
+	bmstu::thread_pool pool(state.range(0));
+	const auto& v = source();
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(
+			bmstu::parallel::reduce(pool, v.begin(), v.end(), 0LL));
+	}
+	state.SetItemsProcessed(state.iterations() * elements);
+}
+
+static void BM_DeterministicReduce(benchmark::State& state)
+{
+	bmstu::thread_pool pool(state.range(0));
+	bmstu::simple_vector<double> v(source().size());
+	std::ranges::copy(source(), v.begin());
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(bmstu::parallel::reduce(
+			bmstu::parallel::deterministic, pool, v.begin(), v.end(), 0.0));
+	}
+	state.SetItemsProcessed(state.iterations() * elements);
+}
+
+static void BM_ParallelTransform(benchmark::State& state)
+{
+	bmstu::thread_pool pool(state.range(0));
+	const auto& v = source();
+	bmstu::simple_vector<double> out(v.size());
+	for (auto _ : state)
+	{
+		bmstu::parallel::transform(pool, v.begin(), v.end(), out.begin(),
+								   [](int x) { return std::sqrt(x * 1.0); });
+		benchmark::DoNotOptimize(out.begin());
+	}
+	state.SetItemsProcessed(state.iterations() * elements);
+}
+
+BENCHMARK(BM_StdSort)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ParallelSort)
+	->RangeMultiplier(2)
+	->Range(1, 16)
+	->Unit(benchmark::kMillisecond)
+	->UseRealTime();
+BENCHMARK(BM_ParallelReduce)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK(BM_DeterministicReduce)
+	->RangeMultiplier(2)
+	->Range(1, 16)
+	->UseRealTime();
+BENCHMARK(BM_ParallelTransform)
+	->RangeMultiplier(2)
+	->Range(1, 16)
+	->UseRealTime();
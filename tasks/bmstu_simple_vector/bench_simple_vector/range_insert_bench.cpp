@@ -0,0 +1,98 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+#include "bmstu_simple_vector.h"
+
+// 1e6 элементов вставляются порциями по chunk штук: поэлементным
+// push_back, диапазонным insert в конец и insert в начало. Диапазонная
+// вставка узнаёт длину порции заранее, выделяет память не больше одного
+// раза и для int копирует порцию одним memcpy.
+
+constexpr int total = 1'000'000;
+
+template <typename T>
+static std::vector<T> make_chunk(size_t size)
+{
+	std::vector<T> chunk;
+	for (size_t i = 0; i < size; ++i)
+	{
+		if constexpr (std::is_same_v<T, std::string>)
+		{
+			chunk.push_back(std::to_string(i));
+		}
+		else
+		{
+			chunk.push_back(static_cast<T>(i));
+		}
+	}
+	return chunk;
+}
+
+template <typename Vector>
+static void BM_PushBackChunks(benchmark::State& state)
+{
+	using value_type = typename Vector::value_type;
+	const auto chunk = make_chunk<value_type>(state.range(0));
+	for (auto _ : state)
+	{
+		Vector v;
+		for (int done = 0; done < total; done += chunk.size())
+		{
+			for (const auto& value : chunk)
+			{
+				v.push_back(value);
+			}
+		}
+		benchmark::DoNotOptimize(v.size());
+	}
+	state.SetItemsProcessed(state.iterations() * total);
+}
+
+template <typename Vector>
+static void BM_InsertChunksBack(benchmark::State& state)
+{
+	using value_type = typename Vector::value_type;
+	const auto chunk = make_chunk<value_type>(state.range(0));
+	for (auto _ : state)
+	{
+		Vector v;
+		for (int done = 0; done < total; done += chunk.size())
+		{
+			v.insert(v.end(), chunk.begin(), chunk.end());
+		}
+		benchmark::DoNotOptimize(v.size());
+	}
+	state.SetItemsProcessed(state.iterations() * total);
+}
+
+// вставка в начало сдвигает весь вектор, поэтому объём в 100 раз меньше
+template <typename Vector>
+static void BM_InsertChunksFront(benchmark::State& state)
+{
+	using value_type = typename Vector::value_type;
+	const auto chunk = make_chunk<value_type>(state.range(0));
+	for (auto _ : state)
+	{
+		Vector v;
+		for (int done = 0; done < total / 100; done += chunk.size())
+		{
+			v.insert(v.begin(), chunk.begin(), chunk.end());
+		}
+		benchmark::DoNotOptimize(v.size());
+	}
+	state.SetItemsProcessed(state.iterations() * total / 100);
+}
+
+template <typename T>
+using std_v = std::vector<T>;
+template <typename T>
+using bmstu_v = bmstu::simple_vector<T>;
+
+BENCHMARK(BM_PushBackChunks<bmstu_v<int>>)->Arg(16)->Arg(256)->Arg(4096);
+BENCHMARK(BM_InsertChunksBack<std_v<int>>)->Arg(16)->Arg(256)->Arg(4096);
+BENCHMARK(BM_InsertChunksBack<bmstu_v<int>>)->Arg(16)->Arg(256)->Arg(4096);
+BENCHMARK(BM_InsertChunksFront<std_v<int>>)->Arg(16)->Arg(256)->Arg(4096);
+BENCHMARK(BM_InsertChunksFront<bmstu_v<int>>)->Arg(16)->Arg(256)->Arg(4096);
+BENCHMARK(BM_PushBackChunks<bmstu_v<std::string>>)->Arg(256);
+BENCHMARK(BM_InsertChunksBack<std_v<std::string>>)->Arg(256);
+BENCHMARK(BM_InsertChunksBack<bmstu_v<std::string>>)->Arg(256);
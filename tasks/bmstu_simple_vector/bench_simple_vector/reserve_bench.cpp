@@ -0,0 +1,42 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include "bmstu_simple_vector.h"
+
+// Цена reserve: только выделение памяти, без создания элементов. Пока
+// array_ptr создавал и заполнял все ячейки, reserve(1 << 24) для int
+// проходил по 64 МБ дважды; теперь он не трогает страницы вовсе.
+
+template <typename T>
+static void BM_Reserve(benchmark::State& state)
+{
+	const auto capacity = static_cast<size_t>(state.range(0));
+	for (auto _ : state)
+	{
+		bmstu::simple_vector<T> v;
+		v.reserve(capacity);
+		benchmark::DoNotOptimize(v.capacity());
+	}
+}
+
+// reserve и заполнение: ячейки создаются по одной, каждая ровно один раз
+template <typename T>
+static void BM_ReserveAndFill(benchmark::State& state)
+{
+	const auto count = static_cast<size_t>(state.range(0));
+	for (auto _ : state)
+	{
+		bmstu::simple_vector<T> v;
+		v.reserve(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			v.push_back(T{});
+		}
+		benchmark::DoNotOptimize(v.size());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_Reserve<int>)->RangeMultiplier(16)->Range(1 << 8, 1 << 24);
+BENCHMARK(BM_Reserve<std::string>)->RangeMultiplier(16)->Range(1 << 8, 1 << 24);
+BENCHMARK(BM_ReserveAndFill<int>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_ReserveAndFill<std::string>)->Range(1 << 10, 1 << 20);
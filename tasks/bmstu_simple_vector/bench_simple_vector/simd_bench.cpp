@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "bmstu_simd.h"
+#include "bmstu_simple_vector.h"
+
+// Сравнение и заполнение арифметических массивов: скалярный цикл против
+// векторных ядер (с диспетчеризацией SSE2/AVX2). Массивы равны, поэтому
+// сравнение проходит их целиком, как при поиске дубликатов.
+
+template <typename T>
+static void BM_EqualScalar(benchmark::State& state)
+{
+	const auto count = static_cast<size_t>(state.range(0));
+	std::vector<T> a(count, T(1));
+	std::vector<T> b(count, T(1));
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(
+			bmstu::simd::scalar::mismatch(a.data(), b.data(), count));
+	}
+	state.SetBytesProcessed(state.iterations() * count * sizeof(T) * 2);
+}
+
+template <typename T>
+static void BM_EqualSimd(benchmark::State& state)
+{
+	const auto count = static_cast<size_t>(state.range(0));
+	bmstu::simple_vector<T> a(count, T(1));
+	bmstu::simple_vector<T> b(count, T(1));
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(a == b);
+	}
+	state.SetBytesProcessed(state.iterations() * count * sizeof(T) * 2);
+}
+
+template <typename T>
+static void BM_CompareThreeWay(benchmark::State& state)
+{
+	const auto count = static_cast<size_t>(state.range(0));
+	bmstu::simple_vector<T> a(count, T(1));
+	bmstu::simple_vector<T> b(count, T(1));
+	b.back() = T(2);
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(a <=> b);
+	}
+	state.SetBytesProcessed(state.iterations() * count * sizeof(T) * 2);
+}
+
+template <typename T>
+static void BM_FillScalar(benchmark::State& state)
+{
+	const auto count = static_cast<size_t>(state.range(0));
+	std::vector<T> a(count);
+	for (auto _ : state)
+	{
+		bmstu::simd::scalar::fill(a.data(), count, T(7));
+		benchmark::ClobberMemory();
+	}
+	state.SetBytesProcessed(state.iterations() * count * sizeof(T));
+}
+
+template <typename T>
+static void BM_FillSimd(benchmark::State& state)
+{
+	const auto count = static_cast<size_t>(state.range(0));
+	std::vector<T> a(count);
+	for (auto _ : state)
+	{
+		bmstu::simd::fill(a.data(), count, T(7));
+		benchmark::ClobberMemory();
+	}
+	state.SetBytesProcessed(state.iterations() * count * sizeof(T));
+}
+
+BENCHMARK(BM_EqualScalar<char>)->Range(1 << 6, 1 << 20);
+BENCHMARK(BM_EqualSimd<char>)->Range(1 << 6, 1 << 20);
+BENCHMARK(BM_EqualScalar<int>)->Range(1 << 6, 1 << 20);
+BENCHMARK(BM_EqualSimd<int>)->Range(1 << 6, 1 << 20);
+BENCHMARK(BM_EqualScalar<float>)->Range(1 << 6, 1 << 20);
+BENCHMARK(BM_EqualSimd<float>)->Range(1 << 6, 1 << 20);
+BENCHMARK(BM_CompareThreeWay<char>)->Range(1 << 6, 1 << 20);
+BENCHMARK(BM_CompareThreeWay<int>)->Range(1 << 6, 1 << 20);
+BENCHMARK(BM_CompareThreeWay<float>)->Range(1 << 6, 1 << 20);
+BENCHMARK(BM_FillScalar<char>)->Range(1 << 6, 1 << 20);
+BENCHMARK(BM_FillSimd<char>)->Range(1 << 6, 1 << 20);
+BENCHMARK(BM_FillScalar<int>)->Range(1 << 6, 1 << 20);
+BENCHMARK(BM_FillSimd<int>)->Range(1 << 6, 1 << 20);
@@ -0,0 +1,94 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <vector>
+#include "bmstu_simple_vector.h"
+
+// simple_vector против std::vector на элементах разного размера:
+// push_back копии, emplace_back на месте и insert в середину.
+
+namespace
+{
+template <size_t Size>
+struct payload
+{
+	payload() = default;
+	explicit payload(int v) { bytes[0] = static_cast<std::byte>(v); }
+
+	std::byte bytes[Size] = {};
+};
+}  // namespace
+
+template <typename Vector>
+static void BM_PushBack(benchmark::State& state)
+{
+	using value_type = typename Vector::value_type;
+	const auto count = static_cast<int>(state.range(0));
+	const value_type value(1);
+	for (auto _ : state)
+	{
+		Vector v;
+		for (int i = 0; i < count; ++i)
+		{
+			v.push_back(value);
+		}
+		benchmark::DoNotOptimize(v.size());
+	}
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+template <typename Vector>
+static void BM_EmplaceBack(benchmark::State& state)
+{
+	const auto count = static_cast<int>(state.range(0));
+	for (auto _ : state)
+	{
+		Vector v;
+		for (int i = 0; i < count; ++i)
+		{
+			v.emplace_back(i);
+		}
+		benchmark::DoNotOptimize(v.size());
+	}
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+template <typename Vector>
+static void BM_InsertMiddle(benchmark::State& state)
+{
+	using value_type = typename Vector::value_type;
+	const auto count = static_cast<int>(state.range(0));
+	for (auto _ : state)
+	{
+		Vector v;
+		for (int i = 0; i < count; ++i)
+		{
+			v.insert(v.begin() + v.size() / 2, value_type(i));
+		}
+		benchmark::DoNotOptimize(v.size());
+	}
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+template <size_t Size>
+using std_vector = std::vector<payload<Size>>;
+template <size_t Size>
+using bmstu_vector = bmstu::simple_vector<payload<Size>>;
+
+BENCHMARK(BM_PushBack<std_vector<4>>)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_PushBack<bmstu_vector<4>>)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_PushBack<std_vector<32>>)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_PushBack<bmstu_vector<32>>)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_PushBack<std_vector<256>>)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_PushBack<bmstu_vector<256>>)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_EmplaceBack<std_vector<4>>)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_EmplaceBack<bmstu_vector<4>>)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_EmplaceBack<std_vector<32>>)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_EmplaceBack<bmstu_vector<32>>)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_EmplaceBack<std_vector<256>>)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_EmplaceBack<bmstu_vector<256>>)->Range(1 << 10, 1 << 16);
+BENCHMARK(BM_InsertMiddle<std_vector<4>>)->Range(1 << 8, 1 << 12);
+BENCHMARK(BM_InsertMiddle<bmstu_vector<4>>)->Range(1 << 8, 1 << 12);
+BENCHMARK(BM_InsertMiddle<std_vector<32>>)->Range(1 << 8, 1 << 12);
+BENCHMARK(BM_InsertMiddle<bmstu_vector<32>>)->Range(1 << 8, 1 << 12);
+BENCHMARK(BM_InsertMiddle<std_vector<256>>)->Range(1 << 8, 1 << 12);
+BENCHMARK(BM_InsertMiddle<bmstu_vector<256>>)->Range(1 << 8, 1 << 12);
@@ -1,18 +1,11 @@
 #pragma once
 #include <algorithm>
+#include <memory>
 #include <type_traits>
+#include <utility>
 
 namespace
 {
-template <typename T>
-void my_fill(T* ptr, size_t size, const T& value = {})
-{
-	for (size_t i = 0; i < size; ++i)
-	{
-		ptr[i] = value;
-	}
-}
-
 template <typename T>
 void my_swap(T& a, T& b)
 {
@@ -24,47 +17,85 @@ void my_swap(T& a, T& b)
 
 namespace bmstu
 {
-template <typename T>
+// Владеющий указатель на неинициализированный буфер из capacity ячеек,
+// выделенный аллокатором. array_ptr отвечает только за память: объекты в
+// буфере создаёт и уничтожает владелец (simple_vector знает, сколько их).
+template <typename T, typename Allocator = std::allocator<T>>
 class array_ptr
 {
+	using alloc_traits = std::allocator_traits<Allocator>;
+
    public:
+	using allocator_type = Allocator;
+
 	array_ptr() = default;
-	explicit array_ptr(size_t size)
+
+	explicit array_ptr(size_t capacity, const Allocator& alloc = Allocator())
+		: alloc_(alloc),
+		  raw_ptr_(capacity > 0 ? alloc_traits::allocate(alloc_, capacity)
+								: nullptr),
+		  capacity_(capacity)
+	{
+	}
+
+	// принимает во владение буфер из capacity ячеек, выделенный
+	// аллокатором, равным alloc
+	array_ptr(T* raw_ptr, size_t capacity, const Allocator& alloc = Allocator())
+		: alloc_(alloc), raw_ptr_(raw_ptr), capacity_(capacity)
 	{
-		if (size > 0)
-		{
-			raw_ptr_ = new T[size];
-			my_fill(raw_ptr_, size);
-		}
-		else
-		{
-			raw_ptr_ = nullptr;
-		}
 	}
-	explicit array_ptr(T* raw_ptr) : raw_ptr_(raw_ptr) {}
+
 	array_ptr(const array_ptr& other) = delete;
 	array_ptr& operator=(const array_ptr& other) = delete;
-	array_ptr(array_ptr&& other) noexcept : raw_ptr_(other.raw_ptr_)
+
+	array_ptr(array_ptr&& other) noexcept
+		: alloc_(std::move(other.alloc_)),
+		  raw_ptr_(std::exchange(other.raw_ptr_, nullptr)),
+		  capacity_(std::exchange(other.capacity_, 0))
 	{
-		other.raw_ptr_ = nullptr;
 	}
+
+	// аллокаторы должны совпадать, если они не переносятся при присваивании;
+	// объекты в буфере к этому моменту должны быть уничтожены владельцем
 	array_ptr& operator=(array_ptr&& other) noexcept
 	{
 		if (this != &other)
 		{
-			delete[] raw_ptr_;
-			raw_ptr_ = other.raw_ptr_;
-			other.raw_ptr_ = nullptr;
+			constexpr bool propagate =
+				alloc_traits::propagate_on_container_move_assignment::value;
+			reset_();
+			if constexpr (propagate)
+			{
+				alloc_ = std::move(other.alloc_);
+			}
+			raw_ptr_ = std::exchange(other.raw_ptr_, nullptr);
+			capacity_ = std::exchange(other.capacity_, 0);
 		}
 		return *this;
 	}
 
 	T* get() const noexcept { return raw_ptr_; }
 
+	size_t capacity() const noexcept { return capacity_; }
+
+	allocator_type get_allocator() const noexcept { return alloc_; }
+
+	// аллокатор буфера; через него владелец создаёт и уничтожает объекты
+	Allocator& allocator() noexcept { return alloc_; }
+
 	explicit operator bool() const noexcept { return raw_ptr_ != nullptr; }
 
-	~array_ptr() { delete[] raw_ptr_; }
-	void swap(array_ptr& other) noexcept { my_swap(raw_ptr_, other.raw_ptr_); }
+	~array_ptr() { reset_(); }
+
+	void swap(array_ptr& other) noexcept
+	{
+		if constexpr (alloc_traits::propagate_on_container_swap::value)
+		{
+			std::swap(alloc_, other.alloc_);
+		}
+		my_swap(raw_ptr_, other.raw_ptr_);
+		my_swap(capacity_, other.capacity_);
+	}
 
 	const T& operator[](size_t index) const
 	{
@@ -73,14 +104,27 @@ class array_ptr
 
 	T& operator[](size_t index) { return raw_ptr_[index]; }
 
+	// отдаёт буфер вызывающему: вернуть capacity() ячеек аллокатору
+	// теперь должен он
 	[[nodiscard]] T* release() noexcept
 	{
-		T* tmp = raw_ptr_;
-		raw_ptr_ = nullptr;
-		return tmp;
+		capacity_ = 0;
+		return std::exchange(raw_ptr_, nullptr);
 	}
 
    private:
+	void reset_() noexcept
+	{
+		if (raw_ptr_ != nullptr)
+		{
+			alloc_traits::deallocate(alloc_, raw_ptr_, capacity_);
+			raw_ptr_ = nullptr;
+			capacity_ = 0;
+		}
+	}
+
+	[[no_unique_address]] Allocator alloc_;
 	T* raw_ptr_ = nullptr;
+	size_t capacity_ = 0;
 };
-}  // namespace bmstu
\ No newline at end of file
+}  // namespace bmstu
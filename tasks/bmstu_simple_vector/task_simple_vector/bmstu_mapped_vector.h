@@ -0,0 +1,371 @@
+#pragma once
+
+// mapped_vector опирается на mmap и доступен только на POSIX-системах
+#if defined(__unix__) || defined(__APPLE__)
+#define BMSTU_HAS_MMAP 1
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include "bmstu_memory.h"
+
+namespace bmstu
+{
+enum class map_mode
+{
+	// только чтение; изменение вектора бросает std::logic_error
+	read_only,
+	// изменения пишутся в файл и сразу видны другим отображениям файла
+	read_write,
+	// изменения видны только этому вектору, файл не меняется
+	copy_on_write,
+};
+
+// Вектор тривиально копируемых T, хранилище которого — отображённый в
+// память файл: элементы лежат в файле подряд, без заголовка, и длина файла
+// равна size() * sizeof(T). Открытие файла не читает его (O(1)), страницы
+// подгружаются при первом обращении, а страничный кэш делят все процессы,
+// отобразившие тот же файл.
+//
+// В режиме read_write рост делается через ftruncate и mremap (на
+// не-Linux — повторным mmap); пока вектор открыт, в конце файла может быть
+// неиспользуемый запас ёмкости, деструктор обрезает его. В copy_on_write
+// рост переносит данные в анонимную память. Интерфейс повторяет
+// simple_vector; итераторы — указатели. В режиме read_only запись через
+// неконстантные operator[], data() или итератор — ошибка доступа к памяти.
+template <typename T, typename Growth = geometric_growth<2, 1>>
+class mapped_vector
+{
+	static_assert(std::is_trivially_copyable_v<T>,
+				  "mapped_vector stores raw bytes of T in a file");
+
+   public:
+	using value_type = T;
+	using size_type = size_t;
+	using iterator = T*;
+	using const_iterator = const T*;
+
+	// вектор без файла: растёт в анонимной памяти, как copy_on_write
+	mapped_vector() = default;
+
+	// read_write создаёт файл, если его нет
+	explicit mapped_vector(const std::filesystem::path& path,
+						   map_mode mode = map_mode::read_write)
+		: mode_(mode)
+	{
+		int flags = mode == map_mode::read_write ? O_RDWR | O_CREAT : O_RDONLY;
+		fd_ = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+		if (fd_ < 0)
+		{
+			throw_errno_("open");
+		}
+		try
+		{
+			struct stat info;
+			if (::fstat(fd_, &info) != 0)
+			{
+				throw_errno_("fstat");
+			}
+			auto bytes = static_cast<size_t>(info.st_size);
+			if (bytes % sizeof(T) != 0)
+			{
+				throw std::invalid_argument(
+					"File size is not a multiple of element size");
+			}
+			size_ = capacity_ = bytes / sizeof(T);
+			if (capacity_ > 0)
+			{
+				data_ = map_file_(capacity_);
+			}
+		}
+		catch (...)
+		{
+			::close(fd_);
+			throw;
+		}
+	}
+
+	mapped_vector(const mapped_vector&) = delete;
+	mapped_vector& operator=(const mapped_vector&) = delete;
+
+	mapped_vector(mapped_vector&& other) noexcept
+		: fd_(std::exchange(other.fd_, -1)),
+		  data_(std::exchange(other.data_, nullptr)),
+		  size_(std::exchange(other.size_, 0)),
+		  capacity_(std::exchange(other.capacity_, 0)),
+		  mode_(other.mode_),
+		  anonymous_(other.anonymous_)
+	{
+	}
+
+	mapped_vector& operator=(mapped_vector&& other) noexcept
+	{
+		if (this != &other)
+		{
+			close_();
+			fd_ = std::exchange(other.fd_, -1);
+			data_ = std::exchange(other.data_, nullptr);
+			size_ = std::exchange(other.size_, 0);
+			capacity_ = std::exchange(other.capacity_, 0);
+			mode_ = other.mode_;
+			anonymous_ = other.anonymous_;
+		}
+		return *this;
+	}
+
+	~mapped_vector() { close_(); }
+
+	map_mode mode() const noexcept { return mode_; }
+
+	iterator begin() noexcept { return data_; }
+
+	iterator end() noexcept { return data_ + size_; }
+
+	const_iterator begin() const noexcept { return data_; }
+
+	const_iterator end() const noexcept { return data_ + size_; }
+
+	T* data() noexcept { return data_; }
+
+	const T* data() const noexcept { return data_; }
+
+	T& operator[](size_t index) noexcept { return data_[index]; }
+
+	const T& operator[](size_t index) const noexcept { return data_[index]; }
+
+	T& at(size_t index)
+	{
+		if (index >= size_)
+		{
+			throw std::out_of_range("Index out of range");
+		}
+		return data_[index];
+	}
+
+	const T& at(size_t index) const
+	{
+		if (index >= size_)
+		{
+			throw std::out_of_range("Index out of range");
+		}
+		return data_[index];
+	}
+
+	T& front() noexcept { return data_[0]; }
+
+	const T& front() const noexcept { return data_[0]; }
+
+	T& back() noexcept { return data_[size_ - 1]; }
+
+	const T& back() const noexcept { return data_[size_ - 1]; }
+
+	size_t size() const noexcept { return size_; }
+
+	size_t capacity() const noexcept { return capacity_; }
+
+	bool empty() const noexcept { return size_ == 0; }
+
+	void reserve(size_t new_cap)
+	{
+		check_writable_();
+		if (new_cap > capacity_)
+		{
+			remap_(new_cap);
+		}
+	}
+
+	// новые элементы инициализируются значением T{}
+	void resize(size_t new_size)
+	{
+		check_writable_();
+		if (new_size > capacity_)
+		{
+			remap_(Growth::next_capacity(capacity_, new_size));
+		}
+		if (new_size > size_)
+		{
+			std::uninitialized_value_construct(data_ + size_,
+											   data_ + new_size);
+		}
+		size_ = new_size;
+	}
+
+	template <typename... Args>
+	T& emplace_back(Args&&... args)
+	{
+		check_writable_();
+		if (size_ == capacity_)
+		{
+			// args может ссылаться на элемент, который переедет
+			T value(std::forward<Args>(args)...);
+			remap_(Growth::next_capacity(capacity_, size_ + 1));
+			return *std::construct_at(data_ + size_++, value);
+		}
+		return *std::construct_at(data_ + size_++,
+								  std::forward<Args>(args)...);
+	}
+
+	void push_back(const T& value) { emplace_back(value); }
+
+	void pop_back()
+	{
+		check_writable_();
+		if (empty())
+			throw std::underflow_error("Vector is empty!");
+		--size_;
+	}
+
+	void clear()
+	{
+		check_writable_();
+		size_ = 0;
+	}
+
+	// сбрасывает изменённые страницы в файл (только read_write)
+	void sync()
+	{
+		if (mode_ == map_mode::read_write && data_ != nullptr &&
+			::msync(data_, capacity_ * sizeof(T), MS_SYNC) != 0)
+		{
+			throw_errno_("msync");
+		}
+	}
+
+	friend bool operator==(const mapped_vector& lhs, const mapped_vector& rhs)
+	{
+		return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+	}
+
+   private:
+	[[noreturn]] static void throw_errno_(const char* what)
+	{
+		throw std::system_error(errno, std::generic_category(), what);
+	}
+
+	void check_writable_() const
+	{
+		if (mode_ == map_mode::read_only)
+		{
+			throw std::logic_error("Mapped vector is read-only");
+		}
+	}
+
+	T* map_file_(size_t capacity)
+	{
+		int prot = mode_ == map_mode::read_only ? PROT_READ
+												: PROT_READ | PROT_WRITE;
+		int flags =
+			mode_ == map_mode::copy_on_write ? MAP_PRIVATE : MAP_SHARED;
+		void* addr =
+			::mmap(nullptr, capacity * sizeof(T), prot, flags, fd_, 0);
+		if (addr == MAP_FAILED)
+		{
+			throw_errno_("mmap");
+		}
+		return static_cast<T*>(addr);
+	}
+
+	// Меняет ёмкость. Файл read_write удлиняется, и отображение растёт
+	// вместе с ним; частная копия переезжает в анонимную память, потому что
+	// страницы за концом неизменного файла читать нельзя (SIGBUS).
+	void remap_(size_t new_cap)
+	{
+		size_t old_bytes = capacity_ * sizeof(T);
+		size_t new_bytes = new_cap * sizeof(T);
+		if (mode_ == map_mode::read_write)
+		{
+			if (::ftruncate(fd_, static_cast<off_t>(new_bytes)) != 0)
+			{
+				throw_errno_("ftruncate");
+			}
+		}
+		if (mode_ == map_mode::read_write || anonymous_)
+		{
+#ifdef __linux__
+			if (data_ != nullptr)
+			{
+				void* addr = ::mremap(data_, old_bytes, new_bytes,
+									  MREMAP_MAYMOVE);
+				if (addr == MAP_FAILED)
+				{
+					throw_errno_("mremap");
+				}
+				data_ = static_cast<T*>(addr);
+				capacity_ = new_cap;
+				return;
+			}
+#endif
+			if (mode_ == map_mode::read_write)
+			{
+				// без mremap: содержимое уже в файле, отображаем заново
+				T* addr = map_file_(new_cap);
+				unmap_();
+				data_ = addr;
+				capacity_ = new_cap;
+				return;
+			}
+		}
+		void* addr = ::mmap(nullptr, new_bytes, PROT_READ | PROT_WRITE,
+							MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (addr == MAP_FAILED)
+		{
+			throw_errno_("mmap");
+		}
+		if (size_ > 0)
+		{
+			std::memcpy(addr, data_, size_ * sizeof(T));
+		}
+		unmap_();
+		data_ = static_cast<T*>(addr);
+		capacity_ = new_cap;
+		anonymous_ = true;
+	}
+
+	void unmap_() noexcept
+	{
+		if (data_ != nullptr)
+		{
+			::munmap(data_, capacity_ * sizeof(T));
+			data_ = nullptr;
+		}
+	}
+
+	// запас ёмкости в конце файла обрезается, чтобы длина файла снова
+	// равнялась size() * sizeof(T)
+	void close_() noexcept
+	{
+		unmap_();
+		if (fd_ >= 0)
+		{
+			if (mode_ == map_mode::read_write && capacity_ != size_)
+			{
+				[[maybe_unused]] int rc =
+					::ftruncate(fd_, static_cast<off_t>(size_ * sizeof(T)));
+			}
+			::close(fd_);
+			fd_ = -1;
+		}
+		size_ = capacity_ = 0;
+	}
+
+	int fd_ = -1;
+	T* data_ = nullptr;
+	size_t size_ = 0;
+	size_t capacity_ = 0;
+	map_mode mode_ = map_mode::copy_on_write;
+	// частная копия уже переехала из файла в анонимную память
+	bool anonymous_ = false;
+};
+}  // namespace bmstu
+#endif
@@ -0,0 +1,313 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+#include "bmstu_thread_pool.h"
+
+// Параллельные sort, reduce, transform и for_each для непрерывных
+// контейнеров (simple_vector, std::vector, массивы). Итераторы переводятся
+// в указатели через std::to_address, диапазон делится на куски, и куски
+// обрабатываются в thread_pool. Первым аргументом можно передать пул; без
+// него используется thread_pool::default_pool(). Функции, которые
+// передаются алгоритмам, вызываются из нескольких потоков одновременно.
+namespace bmstu::parallel
+{
+// reduce(deterministic, ...) складывает блоки фиксированного размера в
+// фиксированном порядке, поэтому сумма float/double не зависит от числа
+// потоков. Обычный reduce делит диапазон по числу потоков: результат
+// повторяется на том же пуле, но может отличаться на пуле другого размера.
+struct deterministic_t
+{
+	explicit deterministic_t() = default;
+};
+
+inline constexpr deterministic_t deterministic{};
+
+namespace detail
+{
+// кусок меньше этого не стоит отдавать другому потоку
+inline constexpr size_t min_grain = 4096;
+
+// кусков в несколько раз больше, чем потоков, чтобы выровнять нагрузку
+inline constexpr size_t chunks_per_thread = 4;
+
+inline size_t chunk_count(const thread_pool& pool, size_t n, size_t grain)
+{
+	size_t by_size = (n + grain - 1) / grain;
+	return std::max<size_t>(
+		std::min(by_size, pool.size() * chunks_per_thread), 1);
+}
+
+// начало k-го из chunks почти равных кусков [0, n)
+inline size_t chunk_begin(size_t n, size_t chunks, size_t k)
+{
+	return n / chunks * k + std::min(k, n % chunks);
+}
+
+// Сколько элементов из a входит в первые diag элементов устойчивого
+// слияния a и b (merge path): при равенстве первым идёт элемент a.
+template <typename T, typename Compare>
+size_t merge_split(const T* a,
+				   size_t a_size,
+				   const T* b,
+				   size_t b_size,
+				   size_t diag,
+				   Compare& comp)
+{
+	size_t lo = diag > b_size ? diag - b_size : 0;
+	size_t hi = std::min(diag, a_size);
+	while (lo < hi)
+	{
+		size_t mid = lo + (hi - lo) / 2;
+		if (!std::invoke(comp, b[diag - mid - 1], a[mid]))
+		{
+			lo = mid + 1;
+		}
+		else
+		{
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+// Сворачивает chunks почти равных кусков параллельно, а их итоги — по
+// порядку, начиная с init.
+template <typename U, typename T, typename Op>
+T reduce_chunks(thread_pool& pool,
+				const U* data,
+				size_t n,
+				size_t chunks,
+				T init,
+				Op& op)
+{
+	if (n == 0)
+	{
+		return init;
+	}
+	std::vector<std::optional<T>> partial(chunks);
+	pool.run(chunks, [&](size_t k) {
+		size_t begin = chunk_begin(n, chunks, k);
+		size_t end = chunk_begin(n, chunks, k + 1);
+		T acc(data[begin]);
+		for (size_t i = begin + 1; i < end; ++i)
+		{
+			acc = std::invoke(op, std::move(acc), data[i]);
+		}
+		partial[k].emplace(std::move(acc));
+	});
+	for (std::optional<T>& value : partial)
+	{
+		init = std::invoke(op, std::move(init), std::move(*value));
+	}
+	return init;
+}
+
+template <typename T>
+void move_chunks(thread_pool& pool, T* src, size_t n, T* dest)
+{
+	size_t chunks = chunk_count(pool, n, min_grain);
+	pool.run(chunks, [&](size_t k) {
+		std::move(src + chunk_begin(n, chunks, k),
+				  src + chunk_begin(n, chunks, k + 1),
+				  dest + chunk_begin(n, chunks, k));
+	});
+}
+
+template <typename T, typename Compare>
+void merge_sort(thread_pool& pool, T* data, size_t n, size_t runs,
+				Compare& comp)
+{
+	// bounds — границы отсортированных кусков в src
+	std::vector<size_t> bounds(runs + 1);
+	for (size_t k = 0; k <= runs; ++k)
+	{
+		bounds[k] = chunk_begin(n, runs, k);
+	}
+	pool.run(runs, [&](size_t k) {
+		std::sort(data + bounds[k], data + bounds[k + 1], std::ref(comp));
+	});
+
+	auto buffer = std::make_unique_for_overwrite<T[]>(n);
+	T* src = data;
+	T* dst = buffer.get();
+	while (bounds.size() > 2)
+	{
+		size_t count = bounds.size() - 1;
+		size_t pairs = count / 2;
+		size_t pieces = std::max<size_t>(pool.size() / pairs, 1);
+		// Точки разбиения ищутся до слияния: слияние перемещает элементы, и
+		// соседняя часть не должна сравнивать уже перемещённые.
+		std::vector<size_t> split(pairs * (pieces + 1));
+		pool.run(pairs, [&](size_t p) {
+			size_t a_size = bounds[2 * p + 1] - bounds[2 * p];
+			size_t b_size = bounds[2 * p + 2] - bounds[2 * p + 1];
+			for (size_t k = 0; k <= pieces; ++k)
+			{
+				split[p * (pieces + 1) + k] = merge_split(
+					src + bounds[2 * p], a_size, src + bounds[2 * p + 1],
+					b_size, chunk_begin(a_size + b_size, pieces, k), comp);
+			}
+		});
+		// нечётный последний кусок переносится без слияния
+		size_t tasks = pairs * pieces + count % 2;
+		pool.run(tasks, [&](size_t t) {
+			if (t == pairs * pieces)
+			{
+				std::move(src + bounds[count - 1], src + n,
+						  dst + bounds[count - 1]);
+				return;
+			}
+			size_t p = t / pieces;
+			size_t k = t % pieces;
+			T* a = src + bounds[2 * p];
+			T* b = src + bounds[2 * p + 1];
+			size_t total = bounds[2 * p + 2] - bounds[2 * p];
+			size_t from = chunk_begin(total, pieces, k);
+			size_t to = chunk_begin(total, pieces, k + 1);
+			size_t a_from = split[p * (pieces + 1) + k];
+			size_t a_to = split[p * (pieces + 1) + k + 1];
+			std::merge(std::make_move_iterator(a + a_from),
+					   std::make_move_iterator(a + a_to),
+					   std::make_move_iterator(b + (from - a_from)),
+					   std::make_move_iterator(b + (to - a_to)),
+					   dst + bounds[2 * p] + from, std::ref(comp));
+		});
+		std::vector<size_t> merged;
+		for (size_t k = 0; k < bounds.size(); k += 2)
+		{
+			merged.push_back(bounds[k]);
+		}
+		if (merged.back() != n)
+		{
+			merged.push_back(n);
+		}
+		bounds = std::move(merged);
+		std::swap(src, dst);
+	}
+	if (src != data)
+	{
+		move_chunks(pool, src, n, data);
+	}
+}
+}  // namespace detail
+
+template <std::contiguous_iterator It, typename F>
+void for_each(thread_pool& pool, It first, It last, F f)
+{
+	auto* data = std::to_address(first);
+	auto n = static_cast<size_t>(last - first);
+	size_t chunks = detail::chunk_count(pool, n, detail::min_grain);
+	pool.run(chunks, [&](size_t k) {
+		std::for_each(data + detail::chunk_begin(n, chunks, k),
+					  data + detail::chunk_begin(n, chunks, k + 1), f);
+	});
+}
+
+template <std::contiguous_iterator It, typename F>
+void for_each(It first, It last, F f)
+{
+	parallel::for_each(thread_pool::default_pool(), first, last, f);
+}
+
+// out должен указывать на непрерывную память не короче [first, last)
+template <std::contiguous_iterator It, std::contiguous_iterator Out,
+		  typename F>
+Out transform(thread_pool& pool, It first, It last, Out out, F f)
+{
+	auto* data = std::to_address(first);
+	auto* dest = std::to_address(out);
+	auto n = static_cast<size_t>(last - first);
+	size_t chunks = detail::chunk_count(pool, n, detail::min_grain);
+	pool.run(chunks, [&](size_t k) {
+		size_t begin = detail::chunk_begin(n, chunks, k);
+		size_t end = detail::chunk_begin(n, chunks, k + 1);
+		std::transform(data + begin, data + end, dest + begin, f);
+	});
+	return out + static_cast<std::iter_difference_t<Out>>(n);
+}
+
+template <std::contiguous_iterator It, std::contiguous_iterator Out,
+		  typename F>
+Out transform(It first, It last, Out out, F f)
+{
+	return parallel::transform(thread_pool::default_pool(), first, last, out,
+							   f);
+}
+
+// op должна быть ассоциативной: куски сворачиваются независимо, а их итоги
+// складываются по порядку слева направо
+template <std::contiguous_iterator It, typename T, typename Op = std::plus<>>
+T reduce(thread_pool& pool, It first, It last, T init, Op op = {})
+{
+	auto* data = std::to_address(first);
+	auto n = static_cast<size_t>(last - first);
+	size_t chunks = detail::chunk_count(pool, n, detail::min_grain);
+	return detail::reduce_chunks(pool, data, n, chunks, std::move(init), op);
+}
+
+template <std::contiguous_iterator It, typename T, typename Op = std::plus<>>
+T reduce(It first, It last, T init, Op op = {})
+{
+	return parallel::reduce(thread_pool::default_pool(), first, last,
+							std::move(init), op);
+}
+
+template <std::contiguous_iterator It, typename T, typename Op = std::plus<>>
+T reduce(deterministic_t,
+		 thread_pool& pool,
+		 It first,
+		 It last,
+		 T init,
+		 Op op = {})
+{
+	auto* data = std::to_address(first);
+	auto n = static_cast<size_t>(last - first);
+	size_t blocks = (n + detail::min_grain - 1) / detail::min_grain;
+	return detail::reduce_chunks(pool, data, n, std::max<size_t>(blocks, 1),
+								 std::move(init), op);
+}
+
+template <std::contiguous_iterator It, typename T, typename Op = std::plus<>>
+T reduce(deterministic_t, It first, It last, T init, Op op = {})
+{
+	return parallel::reduce(deterministic, thread_pool::default_pool(), first,
+							last, std::move(init), op);
+}
+
+// Сортировка слиянием: куски сортируются параллельно std::sort, затем
+// соседние отсортированные куски сливаются попарно, пока не останется один.
+// Каждое слияние делится по merge path на части, которые сливаются
+// независимо, поэтому и последние раунды занимают все потоки. Нужен буфер
+// на n элементов; T без конструктора по умолчанию сортируется std::sort в
+// одном потоке.
+template <std::contiguous_iterator It, typename Compare = std::ranges::less>
+void sort(thread_pool& pool, It first, It last, Compare comp = {})
+{
+	using T = std::iter_value_t<It>;
+	T* data = std::to_address(first);
+	auto n = static_cast<size_t>(last - first);
+	size_t runs = std::min(pool.size(), n / detail::min_grain);
+	if constexpr (std::is_default_constructible_v<T>)
+	{
+		if (runs >= 2)
+		{
+			detail::merge_sort(pool, data, n, runs, comp);
+			return;
+		}
+	}
+	std::sort(data, data + n, std::ref(comp));
+}
+
+template <std::contiguous_iterator It, typename Compare = std::ranges::less>
+void sort(It first, It last, Compare comp = {})
+{
+	parallel::sort(thread_pool::default_pool(), first, last, comp);
+}
+}  // namespace bmstu::parallel
@@ -0,0 +1,280 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+// Векторные ядра для сравнения и заполнения массивов арифметических типов.
+// На x86-64 с GCC/Clang используется SSE2 (есть всегда) или AVX2, если его
+// поддерживает процессор (проверка один раз при первом вызове). На прочих
+// платформах и компиляторах работает скалярный вариант. Все три варианта
+// доступны и напрямую (bmstu::simd::scalar, sse2, avx2) для тестов.
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define BMSTU_SIMD_X86 1
+#define BMSTU_TARGET_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#endif
+
+namespace bmstu::simd
+{
+// Целые (включая bool и символы) сравниваются побайтно; float и double
+// сравниваются векторными == с той же семантикой, что и скалярный ==
+// (NaN не равен ничему, -0.0 == 0.0).
+template <typename T>
+inline constexpr bool is_vectorizable_v =
+	std::is_integral_v<T> || std::is_same_v<T, float> ||
+	std::is_same_v<T, double>;
+
+namespace scalar
+{
+// индекс первого i, для которого !(a[i] == b[i]), или n
+template <typename T>
+size_t mismatch(const T* a, const T* b, size_t n) noexcept
+{
+	for (size_t i = 0; i < n; ++i)
+	{
+		if (!(a[i] == b[i]))
+		{
+			return i;
+		}
+	}
+	return n;
+}
+
+template <typename T>
+void fill(T* dest, size_t n, T value) noexcept
+{
+	for (size_t i = 0; i < n; ++i)
+	{
+		dest[i] = value;
+	}
+}
+}  // namespace scalar
+
+#ifdef BMSTU_SIMD_X86
+namespace sse2
+{
+inline size_t mismatch_bytes(const unsigned char* a,
+							 const unsigned char* b,
+							 size_t n) noexcept
+{
+	size_t i = 0;
+	for (; i + 16 <= n; i += 16)
+	{
+		__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+		__m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+		unsigned mask = _mm_movemask_epi8(_mm_cmpeq_epi8(x, y));
+		if (mask != 0xFFFF)
+		{
+			return i + __builtin_ctz(~mask);
+		}
+	}
+	return i + scalar::mismatch(a + i, b + i, n - i);
+}
+
+inline size_t mismatch(const float* a, const float* b, size_t n) noexcept
+{
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4)
+	{
+		__m128 eq = _mm_cmpeq_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i));
+		unsigned mask = _mm_movemask_ps(eq);
+		if (mask != 0xF)
+		{
+			return i + __builtin_ctz(~mask);
+		}
+	}
+	return i + scalar::mismatch(a + i, b + i, n - i);
+}
+
+inline size_t mismatch(const double* a, const double* b, size_t n) noexcept
+{
+	size_t i = 0;
+	for (; i + 2 <= n; i += 2)
+	{
+		__m128d eq = _mm_cmpeq_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i));
+		unsigned mask = _mm_movemask_pd(eq);
+		if (mask != 0x3)
+		{
+			return i + __builtin_ctz(~mask);
+		}
+	}
+	return i + scalar::mismatch(a + i, b + i, n - i);
+}
+
+// value размножается на весь регистр через буфер, поэтому ядро одно на
+// все размеры T
+template <typename T>
+void fill(T* dest, size_t n, T value) noexcept
+{
+	constexpr size_t lanes = 16 / sizeof(T);
+	alignas(16) T pattern[lanes];
+	std::fill(pattern, pattern + lanes, value);
+	__m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(pattern));
+	size_t i = 0;
+	for (; i + lanes <= n; i += lanes)
+	{
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), v);
+	}
+	scalar::fill(dest + i, n - i, value);
+}
+}  // namespace sse2
+
+namespace avx2
+{
+BMSTU_TARGET_AVX2 inline size_t mismatch_bytes(const unsigned char* a,
+											   const unsigned char* b,
+											   size_t n) noexcept
+{
+	size_t i = 0;
+	for (; i + 32 <= n; i += 32)
+	{
+		__m256i x =
+			_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+		__m256i y =
+			_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+		unsigned mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y));
+		if (mask != 0xFFFFFFFFu)
+		{
+			return i + __builtin_ctz(~mask);
+		}
+	}
+	return i + sse2::mismatch_bytes(a + i, b + i, n - i);
+}
+
+BMSTU_TARGET_AVX2 inline size_t mismatch(const float* a,
+										 const float* b,
+										 size_t n) noexcept
+{
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8)
+	{
+		__m256 eq = _mm256_cmp_ps(_mm256_loadu_ps(a + i),
+								  _mm256_loadu_ps(b + i), _CMP_EQ_OQ);
+		unsigned mask = _mm256_movemask_ps(eq);
+		if (mask != 0xFF)
+		{
+			return i + __builtin_ctz(~mask);
+		}
+	}
+	return i + sse2::mismatch(a + i, b + i, n - i);
+}
+
+BMSTU_TARGET_AVX2 inline size_t mismatch(const double* a,
+										 const double* b,
+										 size_t n) noexcept
+{
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4)
+	{
+		__m256d eq = _mm256_cmp_pd(_mm256_loadu_pd(a + i),
+								   _mm256_loadu_pd(b + i), _CMP_EQ_OQ);
+		unsigned mask = _mm256_movemask_pd(eq);
+		if (mask != 0xF)
+		{
+			return i + __builtin_ctz(~mask);
+		}
+	}
+	return i + sse2::mismatch(a + i, b + i, n - i);
+}
+
+template <typename T>
+BMSTU_TARGET_AVX2 void fill(T* dest, size_t n, T value) noexcept
+{
+	constexpr size_t lanes = 32 / sizeof(T);
+	alignas(32) T pattern[lanes];
+	std::fill(pattern, pattern + lanes, value);
+	__m256i v =
+		_mm256_load_si256(reinterpret_cast<const __m256i*>(pattern));
+	size_t i = 0;
+	for (; i + lanes <= n; i += lanes)
+	{
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), v);
+	}
+	scalar::fill(dest + i, n - i, value);
+}
+}  // namespace avx2
+
+inline bool has_avx2() noexcept
+{
+	static const bool supported = __builtin_cpu_supports("avx2");
+	return supported;
+}
+#else
+inline bool has_avx2() noexcept { return false; }
+#endif
+
+// индекс первого несовпадающего элемента или n
+template <typename T>
+size_t mismatch(const T* a, const T* b, size_t n) noexcept
+{
+	static_assert(is_vectorizable_v<T>);
+#ifdef BMSTU_SIMD_X86
+	if constexpr (std::is_floating_point_v<T>)
+	{
+		return has_avx2() ? avx2::mismatch(a, b, n) : sse2::mismatch(a, b, n);
+	}
+	else
+	{
+		auto* x = reinterpret_cast<const unsigned char*>(a);
+		auto* y = reinterpret_cast<const unsigned char*>(b);
+		size_t bytes = n * sizeof(T);
+		size_t byte = has_avx2() ? avx2::mismatch_bytes(x, y, bytes)
+								 : sse2::mismatch_bytes(x, y, bytes);
+		return byte / sizeof(T);
+	}
+#else
+	return scalar::mismatch(a, b, n);
+#endif
+}
+
+template <typename T>
+bool equal(const T* a, const T* b, size_t n) noexcept
+{
+	return mismatch(a, b, n) == n;
+}
+
+// то же, что std::lexicographical_compare_three_way: векторно ищется первое
+// несовпадение, а порядок на нём задаёт скалярный <=>
+template <typename T>
+std::compare_three_way_result_t<T> compare_three_way(const T* a,
+													 size_t a_size,
+													 const T* b,
+													 size_t b_size) noexcept
+{
+	size_t common = std::min(a_size, b_size);
+	size_t i = mismatch(a, b, common);
+	if (i < common)
+	{
+		return a[i] <=> b[i];
+	}
+	return a_size <=> b_size;
+}
+
+template <typename T>
+void fill(T* dest, size_t n, T value) noexcept
+{
+	static_assert(is_vectorizable_v<T>);
+	if constexpr (sizeof(T) == 1)
+	{
+		// memset в стандартной библиотеке уже векторный и быстрее ядер ниже
+		std::memset(dest, std::bit_cast<unsigned char>(value), n);
+		return;
+	}
+#ifdef BMSTU_SIMD_X86
+	if (has_avx2())
+	{
+		avx2::fill(dest, n, value);
+	}
+	else
+	{
+		sse2::fill(dest, n, value);
+	}
+#else
+	scalar::fill(dest, n, value);
+#endif
+}
+}  // namespace bmstu::simd
@@ -1,210 +1,961 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
 #include <ostream>
+#include <ranges>
 #include <stdexcept>
 #include <utility>
 #include "array_ptr.h"
+#include "bmstu_memory.h"
+#include "bmstu_simd.h"
+
+// Подсказка оптимизатору: выражение истинно, и проверку можно выбросить.
+// Выражение не должно иметь побочных эффектов.
+#if defined(__has_cpp_attribute) && __has_cpp_attribute(assume)
+#define BMSTU_ASSUME(expr) [[assume(expr)]]
+#elif defined(__GNUC__) || defined(__clang__)
+#define BMSTU_ASSUME(expr)           \
+	do                               \
+	{                                \
+		if (!(expr))                 \
+			__builtin_unreachable(); \
+	} while (false)
+#elif defined(_MSC_VER)
+#define BMSTU_ASSUME(expr) __assume(expr)
+#else
+#define BMSTU_ASSUME(expr) ((void)0)
+#endif
 
 namespace bmstu
 {
-template <typename T>
+// Growth задаёт рост ёмкости при нехватке места, как у bmstu::stack; по
+// умолчанию ёмкость удваивается.
+template <typename T,
+		  typename Allocator = std::allocator<T>,
+		  typename Growth = geometric_growth<2, 1>>
 class simple_vector
 {
+	using alloc_traits = std::allocator_traits<Allocator>;
+
+	// стандартные аллокаторы создают арифметические и тривиально копируемые
+	// T простым присваиванием, поэтому их можно заполнять и копировать
+	// блоками
+	static constexpr bool plain_construct_ =
+		std::is_same_v<Allocator, std::allocator<T>> ||
+		std::is_same_v<Allocator, std::pmr::polymorphic_allocator<T>>;
+
+	// откуда взят итератор; без проверок пусто и места не занимает
+#ifdef BMSTU_CHECKED_ITERATORS
+	static constexpr bool checked_iterators_ = true;
+
+	struct iterator_origin_
+	{
+		const simple_vector* owner = nullptr;
+		size_t generation = 0;
+	};
+#else
+	static constexpr bool checked_iterators_ = false;
+
+	struct iterator_origin_
+	{
+	};
+#endif
+
    public:
-	class iterator
+	using value_type = T;
+	using size_type = size_t;
+	using allocator_type = Allocator;
+
+	// Итератор хранит только указатель и тривиально копируется, поэтому
+	// циклы по нему компилируются так же, как по T*. С BMSTU_CHECKED_
+	// ITERATORS он дополнительно помнит вектор и его поколение и проверяет
+	// каждое обращение: выход за [begin, end] и использование после
+	// перевыделения, вставки или удаления бросают исключение. Макрос меняет
+	// размер итератора и вектора и должен быть одинаковым во всей программе.
+	template <bool Const>
+	class basic_iterator
 	{
+		friend class simple_vector;
+		friend class basic_iterator<!Const>;
+
 	   public:
 		using iterator_category = std::contiguous_iterator_tag;
 		using value_type = T;
-		using pointer = T*;
-		using reference = T&;
+		using element_type = std::conditional_t<Const, const T, T>;
+		using pointer = element_type*;
+		using reference = element_type&;
 		using difference_type = std::ptrdiff_t;
 
-		iterator() = default;
+		basic_iterator() = default;
 
-		iterator(const iterator& other) = default;
+		basic_iterator(std::nullptr_t) noexcept {}
 
-		iterator(std::nullptr_t) noexcept : ptr_(nullptr) {}
+		explicit basic_iterator(pointer ptr) noexcept : ptr_(ptr) {}
 
-		iterator(iterator&& other) noexcept : ptr_(nullptr) {}
+		// iterator неявно превращается в const_iterator, но не наоборот
+		template <bool OtherConst>
+			requires(Const && !OtherConst)
+		basic_iterator(const basic_iterator<OtherConst>& other) noexcept
+			: ptr_(other.ptr_), origin_(other.origin_)
+		{
+		}
 
-		explicit iterator(pointer ptr) : ptr_(ptr) {}
+		reference operator*() const noexcept(!checked_iterators_)
+		{
+			check_(0, true);
+			return *ptr_;
+		}
 
-		reference operator*() const { return *ptr_; }
+		// -> не требует элемента: через него std::to_address берёт адрес
+		// end()
+		pointer operator->() const noexcept(!checked_iterators_)
+		{
+			check_(0, false);
+			return ptr_;
+		}
 
-		pointer operator->() const { return ptr_; }
+		reference operator[](difference_type n) const
+			noexcept(!checked_iterators_)
+		{
+			check_(n, true);
+			return ptr_[n];
+		}
 
-		friend pointer to_address(const iterator& it) noexcept
+		friend pointer to_address(const basic_iterator& it) noexcept
 		{
 			return it.ptr_;
 		}
 
-		iterator& operator=(const iterator& other) = default;
-
-		iterator& operator=(iterator&& other) noexcept { return *this; }
-
 #pragma region Operators
-		iterator& operator++() { return *this; }
+		basic_iterator& operator++() noexcept(!checked_iterators_)
+		{
+			check_(1, false);
+			++ptr_;
+			return *this;
+		}
 
-		iterator& operator--() { return *this; }
+		basic_iterator& operator--() noexcept(!checked_iterators_)
+		{
+			check_(-1, false);
+			--ptr_;
+			return *this;
+		}
 
-		iterator operator++(int) { return *this; }
+		basic_iterator operator++(int) noexcept(!checked_iterators_)
+		{
+			basic_iterator copy(*this);
+			++*this;
+			return copy;
+		}
+
+		basic_iterator operator--(int) noexcept(!checked_iterators_)
+		{
+			basic_iterator copy(*this);
+			--*this;
+			return copy;
+		}
 
-		iterator operator--(int) { return *this; }
+		explicit operator bool() const noexcept { return ptr_ != nullptr; }
 
-		explicit operator bool() const { return ptr_ != nullptr; }
+		friend bool operator==(const basic_iterator& lhs,
+							   const basic_iterator& rhs) noexcept
+		{
+			return lhs.ptr_ == rhs.ptr_;
+		}
 
-		friend bool operator==(const iterator& lhs, const iterator& rhs)
+		friend auto operator<=>(const basic_iterator& lhs,
+								const basic_iterator& rhs) noexcept
 		{
-			return "false";
+			return lhs.ptr_ <=> rhs.ptr_;
 		}
 
-		friend bool operator==(const iterator& lhs, std::nullptr_t)
+		friend bool operator==(const basic_iterator& lhs,
+							   std::nullptr_t) noexcept
 		{
-			return "false";
+			return lhs.ptr_ == nullptr;
 		}
 
-		iterator& operator=(std::nullptr_t) noexcept
+		basic_iterator& operator=(std::nullptr_t) noexcept
 		{
 			ptr_ = nullptr;
+			origin_ = {};
 			return *this;
 		}
 
-		friend bool operator==(std::nullptr_t, const iterator& rhs)
+		basic_iterator operator+(difference_type n) const
+			noexcept(!checked_iterators_)
 		{
-			return true;
+			basic_iterator copy(*this);
+			return copy += n;
 		}
 
-		friend bool operator!=(const iterator& lhs, const iterator& rhs)
+		friend basic_iterator operator+(difference_type n,
+										const basic_iterator& it)
+			noexcept(!checked_iterators_)
 		{
-			return true;
+			return it + n;
 		}
 
-		iterator operator+(const difference_type& n) const noexcept
+		basic_iterator& operator+=(difference_type n)
+			noexcept(!checked_iterators_)
 		{
-			return nullptr;
+			check_(n, false);
+			ptr_ += n;
+			return *this;
 		}
 
-		iterator operator+=(const difference_type& n) noexcept
+		basic_iterator operator-(difference_type n) const
+			noexcept(!checked_iterators_)
 		{
-			return nullptr;
+			basic_iterator copy(*this);
+			return copy -= n;
 		}
 
-		iterator operator-(const difference_type& n) const noexcept
+		basic_iterator& operator-=(difference_type n)
+			noexcept(!checked_iterators_)
 		{
-			return nullptr;
+			check_(-n, false);
+			ptr_ -= n;
+			return *this;
 		}
 
-		iterator operator-=(const difference_type& n) noexcept
+		friend difference_type operator-(const basic_iterator& end,
+										 const basic_iterator& begin)
+			noexcept(!checked_iterators_)
 		{
-			return nullptr;
+#ifdef BMSTU_CHECKED_ITERATORS
+			if (end.origin_.owner != begin.origin_.owner)
+			{
+				throw std::logic_error("Iterators of different vectors");
+			}
+			end.check_(0, false);
+#endif
+			return end.ptr_ - begin.ptr_;
 		}
 
-		friend difference_type operator-(const iterator& end,
-										 const iterator& begin) noexcept
+#pragma endregion
+	   private:
+		basic_iterator(pointer ptr, iterator_origin_ origin) noexcept
+			: ptr_(ptr), origin_(origin)
 		{
-			return 0;
 		}
 
-#pragma endregion
-	   private:
+		// Проверяет, что итератор действителен, а ptr_ + offset лежит в
+		// [begin, end] (в [begin, end), если по нему читают). Без
+		// BMSTU_CHECKED_ITERATORS тело пустое и вызов исчезает.
+		void check_([[maybe_unused]] difference_type offset,
+					[[maybe_unused]] bool dereference) const
+			noexcept(!checked_iterators_)
+		{
+#ifdef BMSTU_CHECKED_ITERATORS
+			const simple_vector* owner = origin_.owner;
+			if (owner == nullptr)
+			{
+				return;
+			}
+			if (origin_.generation != owner->generation_)
+			{
+				throw std::logic_error("Iterator invalidated");
+			}
+			difference_type index = ptr_ - owner->data_.get() + offset;
+			auto size = static_cast<difference_type>(owner->size_);
+			if (index < 0 || index > size || (dereference && index == size))
+			{
+				throw std::out_of_range("Iterator out of range");
+			}
+#endif
+		}
+
 		pointer ptr_ = nullptr;
+		[[no_unique_address]] iterator_origin_ origin_;
 	};
 
-	simple_vector() noexcept = default;
+	using iterator = basic_iterator<false>;
+	using const_iterator = basic_iterator<true>;
 
-	~simple_vector() = default;
+	simple_vector() noexcept(noexcept(Allocator())) = default;
 
-	simple_vector(std::initializer_list<T> init) noexcept {}
+	explicit simple_vector(const Allocator& alloc) noexcept : data_(0, alloc)
+	{
+	}
 
-	simple_vector(const simple_vector& other) {}
+	// Конструкторы ниже делегируют пустому вектору: если создание элемента
+	// бросит исключение, деструктор уничтожит уже созданные и освободит
+	// буфер.
+	simple_vector(std::initializer_list<T> init,
+				  const Allocator& alloc = Allocator())
+		: simple_vector(init.begin(), init.end(), alloc)
+	{
+	}
 
-	simple_vector(simple_vector&& other) noexcept { swap(other); }
+	template <std::input_iterator It, std::sentinel_for<It> S>
+	simple_vector(It first, S last, const Allocator& alloc = Allocator())
+		: simple_vector(alloc)
+	{
+		insert_range_(0, std::move(first), std::move(last));
+	}
 
-	simple_vector& operator=(const simple_vector& other) { return *this; }
+	simple_vector(const simple_vector& other)
+		: simple_vector(other,
+						alloc_traits::select_on_container_copy_construction(
+							other.get_allocator()))
+	{
+	}
 
-	simple_vector(size_t size, const T& value = T{}) {}
+	simple_vector(const simple_vector& other, const Allocator& alloc)
+		: simple_vector(alloc)
+	{
+		reserve(other.size_);
+		for (const T& value : other)
+		{
+			construct_back_(value);
+		}
+	}
 
-	iterator begin() noexcept { return nullptr; }
+	simple_vector(simple_vector&& other) noexcept
+		: data_(std::move(other.data_)), size_(std::exchange(other.size_, 0))
+	{
+		other.invalidate_();
+	}
 
-	iterator end() noexcept { return nullptr; }
+	simple_vector(size_t size,
+				  const T& value = T{},
+				  const Allocator& alloc = Allocator())
+		: simple_vector(alloc)
+	{
+		reserve(size);
+		fill_back_(size, value);
+	}
 
-	using const_iterator = iterator;
+	~simple_vector() { clear(); }
 
-	const_iterator begin() const noexcept { return nullptr; }
+	simple_vector& operator=(const simple_vector& other)
+	{
+		if (this != &other)
+		{
+			constexpr bool propagate =
+				alloc_traits::propagate_on_container_copy_assignment::value;
+			simple_vector copy(
+				other, propagate ? other.get_allocator() : get_allocator());
+			if constexpr (propagate)
+			{
+				// аллокатор переходит вместе с буфером, а присваивание
+				// аллокатора может быть запрещено (std::pmr): пересоздаём data_
+				clear();
+				std::destroy_at(&data_);
+				std::construct_at(&data_, std::move(copy.data_));
+				size_ = std::exchange(copy.size_, 0);
+				invalidate_();
+			}
+			else
+			{
+				swap(copy);
+			}
+		}
+		return *this;
+	}
 
-	const_iterator end() const noexcept { return nullptr; }
+	simple_vector& operator=(simple_vector&& other) noexcept(
+		alloc_traits::propagate_on_container_move_assignment::value ||
+		alloc_traits::is_always_equal::value)
+	{
+		if (this == &other)
+		{
+			return *this;
+		}
+		if (alloc_traits::propagate_on_container_move_assignment::value ||
+			get_allocator() == other.get_allocator())
+		{
+			clear();
+			data_ = std::move(other.data_);
+			size_ = std::exchange(other.size_, 0);
+			invalidate_();
+			other.invalidate_();
+		}
+		else
+		{
+			// память other нельзя отдать нашему аллокатору: переносим
+			// элементы по одному
+			simple_vector moved(get_allocator());
+			moved.reserve(other.size_);
+			for (T& value : other)
+			{
+				moved.construct_back_(std::move(value));
+			}
+			other.clear();
+			swap(moved);
+		}
+		return *this;
+	}
 
-	typename iterator::reference operator[](size_t index) noexcept
+	allocator_type get_allocator() const noexcept
 	{
-		return data_[0];
+		return data_.get_allocator();
 	}
 
-	typename const_iterator::reference operator[](size_t index) const noexcept
+	iterator begin() noexcept { return iterator(data_.get(), origin_()); }
+
+	iterator end() noexcept
 	{
-		return data_[0];
+		return iterator(data_.get() + size_, origin_());
 	}
 
-	typename iterator::reference at(size_t index) { return data_.get()[1]; }
+	const_iterator begin() const noexcept
+	{
+		return const_iterator(data_.get(), origin_());
+	}
 
-	typename const_iterator::reference at(size_t index) const
+	const_iterator end() const noexcept
 	{
-		return data_.get()[1];
+		return const_iterator(data_.get() + size_, origin_());
 	}
 
-	size_t size() const noexcept { return 1; }
+	const_iterator cbegin() const noexcept { return begin(); }
 
-	size_t capacity() const noexcept { return 100500; }
+	const_iterator cend() const noexcept { return end(); }
 
-	void swap(simple_vector& other) noexcept {}
+	// Без проверок выход за границы не определён, а оптимизатор считает
+	// index < size() и убирает такие же проверки вокруг вызова. С
+	// BMSTU_CHECKED_ITERATORS индекс проверяется, как в at.
+	T& operator[](size_t index) noexcept(!checked_iterators_)
+	{
+		check_index_(index);
+		return data_[index];
+	}
 
-	friend void swap(simple_vector& lhs, simple_vector& rhs) noexcept {}
+	const T& operator[](size_t index) const noexcept(!checked_iterators_)
+	{
+		check_index_(index);
+		return data_.get()[index];
+	}
 
-	void reserve(size_t new_cap) {}
+	T& at(size_t index)
+	{
+		if (index >= size_)
+		{
+			throw std::out_of_range("Index out of range");
+		}
+		return data_[index];
+	}
 
-	void resize(size_t new_size) { return; }
+	const T& at(size_t index) const
+	{
+		if (index >= size_)
+		{
+			throw std::out_of_range("Index out of range");
+		}
+		return data_.get()[index];
+	}
 
-	iterator insert(const_iterator where, T&& value) { return nullptr; }
+	// front и back для пустого вектора не определены, как у std::vector
+	T& front() noexcept(!checked_iterators_) { return (*this)[0]; }
 
-	iterator insert(const_iterator where, const T& value) { return nullptr; }
+	const T& front() const noexcept(!checked_iterators_) { return (*this)[0]; }
 
-	void push_back(T&& value) {}
+	T& back() noexcept(!checked_iterators_) { return (*this)[size_ - 1]; }
 
-	void clear() noexcept {}
+	const T& back() const noexcept(!checked_iterators_)
+	{
+		return (*this)[size_ - 1];
+	}
 
-	void push_back(const T& value) {}
+	size_t size() const noexcept { return size_; }
 
-	bool empty() const noexcept { return false; }
+	size_t capacity() const noexcept { return data_.capacity(); }
 
-	void pop_back() { return; }
+	// при неравных аллокаторах без propagate_on_container_swap обмен
+	// не определён, как и у std::vector
+	void swap(simple_vector& other) noexcept
+	{
+		data_.swap(other.data_);
+		my_swap(size_, other.size_);
+		invalidate_();
+		other.invalidate_();
+	}
+
+	friend void swap(simple_vector& lhs, simple_vector& rhs) noexcept
+	{
+		lhs.swap(rhs);
+	}
+
+	// выделяет память, но не создаёт элементов
+	void reserve(size_t new_cap)
+	{
+		if (new_cap > capacity())
+		{
+			reallocate_(new_cap, size_, 0);
+		}
+	}
+
+	// отдаёт неиспользуемую память, capacity становится равной size
+	void shrink_to_fit()
+	{
+		if (capacity() > size_)
+		{
+			reallocate_(size_, size_, 0);
+		}
+	}
+
+	void resize(size_t new_size) { resize_(new_size); }
+
+	void resize(size_t new_size, const T& value) { resize_(new_size, value); }
+
+	template <typename... Args>
+	T& emplace_back(Args&&... args)
+	{
+		if (size_ == capacity())
+		{
+			grow_and_emplace_(size_, std::forward<Args>(args)...);
+		}
+		else
+		{
+			construct_back_(std::forward<Args>(args)...);
+		}
+		return data_[size_ - 1];
+	}
+
+	void push_back(const T& value) { emplace_back(value); }
+
+	void push_back(T&& value) { emplace_back(std::move(value)); }
+
+	template <typename... Args>
+	iterator emplace(const_iterator where, Args&&... args)
+	{
+		size_t index = where - begin();
+		if (size_ == capacity())
+		{
+			grow_and_emplace_(index, std::forward<Args>(args)...);
+		}
+		else if (index == size_)
+		{
+			construct_back_(std::forward<Args>(args)...);
+		}
+		else
+		{
+			// args может ссылаться на элемент, который сейчас сдвинется
+			T value(std::forward<Args>(args)...);
+			invalidate_();
+			construct_back_(std::move(data_[size_ - 1]));
+			std::move_backward(begin() + index, end() - 2, end() - 1);
+			data_[index] = std::move(value);
+		}
+		return begin() + index;
+	}
+
+	iterator insert(const_iterator where, const T& value)
+	{
+		return emplace(where, value);
+	}
+
+	iterator insert(const_iterator where, T&& value)
+	{
+		return emplace(where, std::move(value));
+	}
+
+	template <std::input_iterator It, std::sentinel_for<It> S>
+	iterator insert(const_iterator where, It first, S last)
+	{
+		size_t index = where - begin();
+		insert_range_(index, std::move(first), std::move(last));
+		return begin() + index;
+	}
+
+	iterator insert(const_iterator where, std::initializer_list<T> values)
+	{
+		return insert(where, values.begin(), values.end());
+	}
+
+	template <std::ranges::input_range R>
+	void append_range(R&& range)
+	{
+		insert_range_(size_, std::ranges::begin(range),
+					  std::ranges::end(range));
+	}
+
+	// как у std::vector: при исключении вектор может остаться частично
+	// заполненным, но корректным
+	template <std::input_iterator It, std::sentinel_for<It> S>
+	void assign(It first, S last)
+	{
+		clear();
+		invalidate_();
+		insert_range_(0, std::move(first), std::move(last));
+	}
+
+	void assign(std::initializer_list<T> values)
+	{
+		assign(values.begin(), values.end());
+	}
+
+	void clear() noexcept { destroy_tail_(0); }
+
+	bool empty() const noexcept { return size_ == 0; }
+
+	void pop_back()
+	{
+		if (empty())
+			throw std::underflow_error("Vector is empty!");
+		destroy_tail_(size_ - 1);
+	}
 
 	friend bool operator==(const simple_vector& lhs, const simple_vector& rhs)
 	{
-		return true;
+		if (lhs.size_ != rhs.size_)
+		{
+			return false;
+		}
+		if constexpr (simd::is_vectorizable_v<T>)
+		{
+			return simd::equal(lhs.data_.get(), rhs.data_.get(), lhs.size_);
+		}
+		else
+		{
+			return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+		}
 	}
 
 	friend bool operator!=(const simple_vector& lhs, const simple_vector& rhs)
 	{
-		return false;
+		return !(lhs == rhs);
 	}
 
 	friend auto operator<=>(const simple_vector& lhs, const simple_vector& rhs)
 	{
-		return true;
+		if constexpr (simd::is_vectorizable_v<T>)
+		{
+			return simd::compare_three_way(lhs.data_.get(), lhs.size_,
+										   rhs.data_.get(), rhs.size_);
+		}
+		else
+		{
+			return std::lexicographical_compare_three_way(
+				lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+		}
 	}
 
 	friend std::ostream& operator<<(std::ostream& os, const simple_vector& vec)
 	{
-		return os;
+		os << "{";
+		for (size_t i = 0; i < vec.size_; ++i)
+		{
+			if (i > 0)
+			{
+				os << ", ";
+			}
+			os << vec[i];
+		}
+		return os << "}";
+	}
+
+	// erase(end()) удаляет последний элемент
+	iterator erase(const_iterator where)
+	{
+		size_t index = where - begin();
+		if (index == size_ && size_ > 0)
+		{
+			--index;
+		}
+		invalidate_();
+		std::move(begin() + index + 1, end(), begin() + index);
+		destroy_tail_(size_ - 1);
+		return begin() + index;
 	}
-	iterator erase(iterator where) { return nullptr; }
 
    private:
-	static bool alphabet_compare(const simple_vector<T>& lhs,
-								 const simple_vector<T>& rhs)
+	iterator_origin_ origin_() const noexcept
+	{
+#ifdef BMSTU_CHECKED_ITERATORS
+		return {this, generation_};
+#else
+		return {};
+#endif
+	}
+
+	// Все итераторы, взятые раньше, становятся недействительными: буфер
+	// переехал или элементы сдвинулись. Сдвиг портит итераторы только от
+	// места вставки, но отладочный режим строже стандарта и ловит все.
+	void invalidate_() noexcept
+	{
+#ifdef BMSTU_CHECKED_ITERATORS
+		++generation_;
+#endif
+	}
+
+	void check_index_(size_t index) const noexcept(!checked_iterators_)
+	{
+#ifdef BMSTU_CHECKED_ITERATORS
+		if (index >= size_)
+		{
+			throw std::out_of_range("Index out of range");
+		}
+#else
+		BMSTU_ASSUME(index < size_);
+#endif
+	}
+
+	// создаёт элемент в первой свободной ячейке; место должно быть
+	template <typename... Args>
+	void construct_back_(Args&&... args)
+	{
+		alloc_traits::construct(data_.allocator(), data_.get() + size_,
+								std::forward<Args>(args)...);
+		++size_;
+	}
+
+	// Новый элемент создаётся в новом буфере до переноса старых: args может
+	// ссылаться на элемент этого же вектора (v.push_back(v[0])). Если
+	// создание или перенос бросят, вектор остаётся прежним.
+	template <typename... Args>
+	void grow_and_emplace_(size_t index, Args&&... args)
+	{
+		array_ptr<T, Allocator> new_data(
+			Growth::next_capacity(capacity(), size_ + 1), get_allocator());
+		alloc_traits::construct(new_data.allocator(), new_data.get() + index,
+								std::forward<Args>(args)...);
+		try
+		{
+			relocate_(new_data, index, 1);
+		}
+		catch (...)
+		{
+			alloc_traits::destroy(new_data.allocator(),
+								  new_data.get() + index);
+			throw;
+		}
+		++size_;
+	}
+
+	// Источник можно копировать одним memcpy: непрерывная память из тех же
+	// тривиально копируемых T, а аллокатор создаёт их простым присваиванием.
+	template <typename It>
+	static constexpr bool bulk_copyable_ =
+		std::contiguous_iterator<It> &&
+		std::is_same_v<std::iter_value_t<It>, T> &&
+		std::is_trivially_copyable_v<T> && plain_construct_;
+
+	// Вставляет [first, last) перед элементом index. Если длина диапазона
+	// известна заранее, память выделяется не больше одного раза, а
+	// тривиально копируемые элементы из непрерывного источника переносятся
+	// memmove/memcpy. Иначе элементы дописываются в конец и поворачиваются
+	// на место.
+	template <typename It, typename S>
+	void insert_range_(size_t index, It first, S last)
+	{
+		if constexpr (std::forward_iterator<It>)
+		{
+			auto count =
+				static_cast<size_t>(std::ranges::distance(first, last));
+			if (count == 0)
+			{
+				return;
+			}
+			if (size_ + count > capacity())
+			{
+				array_ptr<T, Allocator> new_data(
+					Growth::next_capacity(capacity(), size_ + count),
+					get_allocator());
+				T* dest = new_data.get() + index;
+				copy_uninitialized_(new_data.allocator(), first, count, dest);
+				try
+				{
+					relocate_(new_data, index, count);
+				}
+				catch (...)
+				{
+					for (size_t i = 0; i < count; ++i)
+					{
+						alloc_traits::destroy(new_data.allocator(), dest + i);
+					}
+					throw;
+				}
+				size_ += count;
+				return;
+			}
+			if constexpr (bulk_copyable_<It>)
+			{
+				invalidate_();
+				T* pos = data_.get() + index;
+				std::memmove(pos + count, pos, (size_ - index) * sizeof(T));
+				std::memcpy(pos, std::to_address(first), count * sizeof(T));
+				size_ += count;
+				return;
+			}
+		}
+		size_t old_size = size_;
+		try
+		{
+			for (; first != last; ++first)
+			{
+				emplace_back(*first);
+			}
+		}
+		catch (...)
+		{
+			destroy_tail_(old_size);
+			throw;
+		}
+		if (index != old_size)
+		{
+			invalidate_();
+			std::rotate(begin() + index, begin() + old_size, end());
+		}
+	}
+
+	// создаёт count элементов из first в неинициализированной памяти dest;
+	// при исключении созданные уничтожаются
+	template <typename It>
+	static void copy_uninitialized_(Allocator& alloc,
+									It first,
+									size_t count,
+									T* dest)
 	{
-		return false;
+		if constexpr (bulk_copyable_<It>)
+		{
+			std::memcpy(dest, std::to_address(first), count * sizeof(T));
+		}
+		else
+		{
+			size_t constructed = 0;
+			try
+			{
+				for (; constructed < count; ++constructed, ++first)
+				{
+					alloc_traits::construct(alloc, dest + constructed, *first);
+				}
+			}
+			catch (...)
+			{
+				while (constructed > 0)
+				{
+					alloc_traits::destroy(alloc, dest + --constructed);
+				}
+				throw;
+			}
+		}
+	}
+
+	void reallocate_(size_t new_cap, size_t index, size_t gap)
+	{
+		array_ptr<T, Allocator> new_data(new_cap, get_allocator());
+		relocate_(new_data, index, gap);
 	}
-	array_ptr<T> data_;
+
+	// Переносит элементы в new_data, оставляя gap пустых ячеек перед
+	// элементом index, и забирает буфер себе; старый освободит new_data.
+	// Тривиально переносимые T копируются memcpy. Остальные перемещаются,
+	// только если перемещение не бросает (иначе копируются), а старые
+	// уничтожаются после успеха, поэтому исключение не меняет вектор.
+	void relocate_(array_ptr<T, Allocator>& new_data, size_t index, size_t gap)
+	{
+		T* old = data_.get();
+		T* dest = new_data.get();
+		if constexpr (is_trivially_relocatable_v<T>)
+		{
+			uninitialized_relocate(old, index, dest);
+			uninitialized_relocate(old + index, size_ - index,
+								   dest + index + gap);
+		}
+		else
+		{
+			Allocator& alloc = data_.allocator();
+			uninitialized_move_if_noexcept(alloc, old, index, dest);
+			try
+			{
+				uninitialized_move_if_noexcept(alloc, old + index,
+											   size_ - index,
+											   dest + index + gap);
+			}
+			catch (...)
+			{
+				for (size_t i = 0; i < index; ++i)
+				{
+					alloc_traits::destroy(alloc, dest + i);
+				}
+				throw;
+			}
+			for (size_t i = 0; i < size_; ++i)
+			{
+				alloc_traits::destroy(alloc, old + i);
+			}
+		}
+		data_.swap(new_data);
+		invalidate_();
+	}
+
+	// при исключении созданные элементы уничтожаются, размер не меняется
+	template <typename... Args>
+	void resize_(size_t new_size, const Args&... value)
+	{
+		if (new_size > capacity())
+		{
+			reserve(Growth::next_capacity(capacity(), new_size));
+		}
+		size_t old_size = size_;
+		try
+		{
+			if (new_size > size_)
+			{
+				fill_back_(new_size - size_, value...);
+			}
+		}
+		catch (...)
+		{
+			destroy_tail_(old_size);
+			throw;
+		}
+		destroy_tail_(new_size);
+	}
+
+	// Создаёт count одинаковых элементов в конце. Для арифметических T,
+	// которые стандартный аллокатор создаёт простым присваиванием, ячейки
+	// заполняются векторно.
+	template <typename... Args>
+	void fill_back_(size_t count, const Args&... args)
+	{
+		if constexpr (simd::is_vectorizable_v<T> && plain_construct_)
+		{
+			simd::fill(data_.get() + size_, count, T(args...));
+			size_ += count;
+		}
+		else
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				construct_back_(args...);
+			}
+		}
+	}
+
+	// уничтожает элементы начиная с new_size, с конца
+	void destroy_tail_(size_t new_size) noexcept
+	{
+		while (size_ > new_size)
+		{
+			--size_;
+			alloc_traits::destroy(data_.allocator(), data_.get() + size_);
+		}
+	}
+
+	array_ptr<T, Allocator> data_;
 	size_t size_ = 0;
-	size_t capacity_ = 0;
+#ifdef BMSTU_CHECKED_ITERATORS
+	size_t generation_ = 0;
+#endif
 };
+
+template <std::input_iterator It, std::sentinel_for<It> S>
+simple_vector(It, S) -> simple_vector<std::iter_value_t<It>>;
+
+namespace pmr
+{
+template <typename T, typename Growth = geometric_growth<2, 1>>
+using simple_vector =
+	bmstu::simple_vector<T, std::pmr::polymorphic_allocator<T>, Growth>;
+}  // namespace pmr
 }  // namespace bmstu
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace bmstu
+{
+// Пул потоков для параллельных алгоритмов в стиле fork-join. run(tasks, f)
+// раздаёт индексы 0..tasks-1 рабочим потокам и вызывающему потоку, который
+// тоже работает, и возвращается, когда все f(i) завершены. Первое
+// исключение из f перебрасывается вызывающему, остальные задачи всё равно
+// выполняются. Пул из одного потока не создаёт рабочих и выполняет всё на
+// месте. run из задачи этого же пула выполняется на месте, без ожидания
+// других потоков, поэтому вложенные алгоритмы не зависают.
+class thread_pool
+{
+   public:
+	// threads — полная степень параллелизма вместе с вызывающим потоком
+	explicit thread_pool(size_t threads = default_thread_count())
+	{
+		threads = std::max<size_t>(threads, 1);
+		workers_.reserve(threads - 1);
+		try
+		{
+			for (size_t i = 1; i < threads; ++i)
+			{
+				workers_.emplace_back([this] { worker_loop_(); });
+			}
+		}
+		catch (...)
+		{
+			stop_workers_();
+			throw;
+		}
+	}
+
+	thread_pool(const thread_pool&) = delete;
+	thread_pool& operator=(const thread_pool&) = delete;
+
+	~thread_pool() { stop_workers_(); }
+
+	size_t size() const noexcept { return workers_.size() + 1; }
+
+	template <typename F>
+	void run(size_t tasks, F&& f)
+	{
+		if (workers_.empty() || tasks <= 1 || current_ == this)
+		{
+			for (size_t i = 0; i < tasks; ++i)
+			{
+				f(i);
+			}
+			return;
+		}
+		using fn_type = std::remove_reference_t<F>;
+		job j([](void* fn, size_t i) { (*static_cast<fn_type*>(fn))(i); },
+			  const_cast<void*>(static_cast<const void*>(&f)), tasks);
+		// задания разных потоков не смешиваются
+		std::lock_guard serial(run_mutex_);
+		{
+			std::lock_guard lock(mutex_);
+			job_ = &j;
+			++generation_;
+		}
+		wake_.notify_all();
+		execute_(j);
+		{
+			// все индексы розданы; ждём тех, кто ещё выполняет свои
+			std::unique_lock lock(mutex_);
+			job_ = nullptr;
+			done_.wait(lock, [&j] { return j.active == 0; });
+		}
+		if (j.error)
+		{
+			std::rethrow_exception(j.error);
+		}
+	}
+
+	static size_t default_thread_count() noexcept
+	{
+		return std::max<unsigned>(std::thread::hardware_concurrency(), 1);
+	}
+
+	// общий пул на все ядра, создаётся при первом обращении
+	static thread_pool& default_pool()
+	{
+		static thread_pool pool;
+		return pool;
+	}
+
+   private:
+	struct job
+	{
+		job(void (*call)(void*, size_t), void* fn, size_t tasks) noexcept
+			: call(call), fn(fn), tasks(tasks)
+		{
+		}
+
+		void (*call)(void*, size_t);
+		void* fn;
+		size_t tasks;
+		std::atomic<size_t> next{0};
+		// сколько рабочих взяли задание; защищено mutex_
+		size_t active = 0;
+		std::atomic_flag failed;
+		std::exception_ptr error;
+	};
+
+	void execute_(job& j) noexcept
+	{
+		const thread_pool* outer = std::exchange(current_, this);
+		for (size_t i = j.next.fetch_add(1, std::memory_order_relaxed);
+			 i < j.tasks; i = j.next.fetch_add(1, std::memory_order_relaxed))
+		{
+			try
+			{
+				j.call(j.fn, i);
+			}
+			catch (...)
+			{
+				if (!j.failed.test_and_set())
+				{
+					j.error = std::current_exception();
+				}
+			}
+		}
+		current_ = outer;
+	}
+
+	void stop_workers_() noexcept
+	{
+		{
+			std::lock_guard lock(mutex_);
+			stop_ = true;
+		}
+		wake_.notify_all();
+		for (std::thread& worker : workers_)
+		{
+			worker.join();
+		}
+	}
+
+	void worker_loop_()
+	{
+		size_t seen = 0;
+		std::unique_lock lock(mutex_);
+		while (true)
+		{
+			wake_.wait(lock, [&] {
+				return stop_ || (job_ != nullptr && generation_ != seen);
+			});
+			if (stop_)
+			{
+				return;
+			}
+			seen = generation_;
+			job* j = job_;
+			++j->active;
+			lock.unlock();
+			execute_(*j);
+			lock.lock();
+			if (--j->active == 0)
+			{
+				done_.notify_one();
+			}
+		}
+	}
+
+	// пул, задание которого выполняет текущий поток
+	static inline thread_local const thread_pool* current_ = nullptr;
+
+	std::vector<std::thread> workers_;
+	std::mutex run_mutex_;
+	std::mutex mutex_;
+	std::condition_variable wake_;
+	std::condition_variable done_;
+	job* job_ = nullptr;
+	size_t generation_ = 0;
+	bool stop_ = false;
+};
+}  // namespace bmstu
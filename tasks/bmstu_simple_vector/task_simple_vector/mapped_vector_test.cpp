@@ -0,0 +1,125 @@
+#include "bmstu_mapped_vector.h"
+
+#include <gtest/gtest.h>
+
+#ifdef BMSTU_HAS_MMAP
+#include <unistd.h>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+// временный файл, который удаляется вместе с объектом
+struct temp_file
+{
+	temp_file()
+		: path(std::filesystem::temp_directory_path() /
+			   ("bmstu_mapped_" + std::to_string(::getpid()) + "_" +
+				std::to_string(counter++)))
+	{
+	}
+
+	~temp_file() { std::filesystem::remove(path); }
+
+	std::filesystem::path path;
+	static inline int counter = 0;
+};
+}  // namespace
+
+TEST(MappedVector, GrowsAndReopensWithoutParsing)
+{
+	temp_file file;
+	{
+		bmstu::mapped_vector<int> v(file.path);
+		ASSERT_TRUE(v.empty());
+		for (int i = 0; i < 100000; ++i)
+		{
+			v.push_back(i);
+		}
+		ASSERT_GE(v.capacity(), 100000u);
+		v.pop_back();
+		v.sync();
+	}
+	// запас ёмкости обрезан: длина файла равна size() * sizeof(T)
+	ASSERT_EQ(std::filesystem::file_size(file.path), 99999 * sizeof(int));
+
+	bmstu::mapped_vector<int> v(file.path, bmstu::map_mode::read_only);
+	ASSERT_EQ(v.size(), 99999u);
+	ASSERT_EQ(v.front(), 0);
+	ASSERT_EQ(v.back(), 99998);
+	ASSERT_EQ(std::accumulate(v.begin(), v.end(), 0LL),
+			  99999LL * 99998 / 2);
+	ASSERT_THROW(v.at(99999), std::out_of_range);
+}
+
+TEST(MappedVector, ReadOnlyRejectsChanges)
+{
+	temp_file file;
+	{
+		bmstu::mapped_vector<double> v(file.path);
+		v.resize(10);
+		ASSERT_EQ(v[9], 0.0);
+	}
+	bmstu::mapped_vector<double> v(file.path, bmstu::map_mode::read_only);
+	ASSERT_EQ(v.mode(), bmstu::map_mode::read_only);
+	ASSERT_THROW(v.push_back(1.0), std::logic_error);
+	ASSERT_THROW(v.resize(20), std::logic_error);
+	ASSERT_THROW(v.clear(), std::logic_error);
+	ASSERT_EQ(v.size(), 10u);
+
+	ASSERT_THROW(bmstu::mapped_vector<double>(file.path / "missing",
+											  bmstu::map_mode::read_only),
+				 std::system_error);
+	{
+		std::ofstream(file.path, std::ios::app) << "abc";
+	}
+	ASSERT_THROW(bmstu::mapped_vector<double>(file.path),
+				 std::invalid_argument);
+}
+
+TEST(MappedVector, CopyOnWriteLeavesFileIntact)
+{
+	temp_file file;
+	{
+		bmstu::mapped_vector<int> v(file.path);
+		for (int i = 0; i < 1000; ++i)
+		{
+			v.push_back(i);
+		}
+	}
+	{
+		bmstu::mapped_vector<int> v(file.path, bmstu::map_mode::copy_on_write);
+		v[0] = -1;
+		// рост переносит частную копию в анонимную память
+		for (int i = 0; i < 5000; ++i)
+		{
+			v.push_back(v[i]);
+		}
+		ASSERT_EQ(v.size(), 6000u);
+		ASSERT_EQ(v[1000], -1);
+		ASSERT_EQ(v[5999], 4999 % 1000);
+	}
+	bmstu::mapped_vector<int> v(file.path, bmstu::map_mode::read_only);
+	ASSERT_EQ(v.size(), 1000u);
+	ASSERT_EQ(v[0], 0);
+}
+
+TEST(MappedVector, MappingsShareThePageCache)
+{
+	temp_file file;
+	bmstu::mapped_vector<long> writer(file.path);
+	writer.resize(4096);
+	bmstu::mapped_vector<long> reader(file.path, bmstu::map_mode::read_only);
+	// запись видна второму отображению сразу, без sync и чтения файла
+	writer[4000] = 42;
+	ASSERT_EQ(reader[4000], 42);
+
+	bmstu::mapped_vector<long> moved(std::move(writer));
+	ASSERT_EQ(moved.size(), 4096u);
+	ASSERT_TRUE(writer.empty());
+	ASSERT_TRUE(moved == reader);
+}
+#endif
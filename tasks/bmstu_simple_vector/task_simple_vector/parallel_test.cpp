@@ -0,0 +1,136 @@
+#include "bmstu_parallel.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "bmstu_simple_vector.h"
+
+namespace
+{
+bmstu::simple_vector<int> random_ints(size_t size, unsigned seed)
+{
+	std::mt19937 gen(seed);
+	bmstu::simple_vector<int> v;
+	v.reserve(size);
+	for (size_t i = 0; i < size; ++i)
+	{
+		// узкий диапазон даёт много равных ключей
+		v.push_back(static_cast<int>(gen() % 1000));
+	}
+	return v;
+}
+}  // namespace
+
+TEST(ThreadPool, RunsEveryTaskOnceAndRethrows)
+{
+	bmstu::thread_pool pool(4);
+	ASSERT_EQ(pool.size(), 4u);
+	std::vector<std::atomic<int>> hits(1000);
+	pool.run(hits.size(), [&](size_t i) { ++hits[i]; });
+	ASSERT_TRUE(std::ranges::all_of(hits, [](auto& h) { return h == 1; }));
+
+	std::atomic<int> done = 0;
+	ASSERT_THROW(pool.run(100,
+						  [&](size_t i) {
+							  if (i == 42)
+							  {
+								  throw std::runtime_error("task failed");
+							  }
+							  ++done;
+						  }),
+				 std::runtime_error);
+	ASSERT_EQ(done, 99);
+
+	// вложенный run выполняется на месте и не ждёт занятых потоков
+	std::atomic<int> inner = 0;
+	pool.run(8, [&](size_t) { pool.run(8, [&](size_t) { ++inner; }); });
+	ASSERT_EQ(inner, 64);
+}
+
+TEST(Parallel, SortMatchesStdSort)
+{
+	for (size_t threads : {1, 2, 3, 4, 7})
+	{
+		bmstu::thread_pool pool(threads);
+		for (size_t size : {0, 1, 4095, 50000, 123457})
+		{
+			auto v = random_ints(size, static_cast<unsigned>(size + threads));
+			std::vector<int> expected(v.begin(), v.end());
+			std::ranges::sort(expected);
+			bmstu::parallel::sort(pool, v.begin(), v.end());
+			ASSERT_TRUE(std::ranges::equal(v, expected)) << size;
+		}
+	}
+
+	bmstu::thread_pool pool(3);
+	auto v = random_ints(40000, 7);
+	bmstu::parallel::sort(pool, v.begin(), v.end(), std::ranges::greater{});
+	ASSERT_TRUE(std::ranges::is_sorted(v, std::ranges::greater{}));
+
+	std::vector<std::string> words;
+	for (int value : random_ints(30000, 8))
+	{
+		words.push_back(std::string(20, 'a') + std::to_string(value));
+	}
+	auto expected = words;
+	std::ranges::sort(expected);
+	bmstu::parallel::sort(pool, words.begin(), words.end());
+	ASSERT_EQ(words, expected);
+}
+
+TEST(Parallel, DeterministicReduce)
+{
+	auto ints = random_ints(100000, 1);
+	long long expected = 0;
+	for (int value : ints)
+	{
+		expected += value;
+	}
+
+	std::mt19937 gen(2);
+	std::uniform_real_distribution<float> dist(-1e3f, 1e3f);
+	bmstu::simple_vector<float> floats;
+	for (int i = 0; i < 100000; ++i)
+	{
+		floats.push_back(dist(gen));
+	}
+
+	float reference = 0;
+	for (size_t threads : {1, 2, 3, 8})
+	{
+		bmstu::thread_pool pool(threads);
+		ASSERT_EQ(bmstu::parallel::reduce(pool, ints.begin(), ints.end(), 0LL),
+				  expected);
+		float sum = bmstu::parallel::reduce(bmstu::parallel::deterministic,
+											pool, floats.begin(),
+											floats.end(), 0.0f);
+		if (threads == 1)
+		{
+			reference = sum;
+		}
+		// побитовое равенство, а не приближённое
+		ASSERT_EQ(sum, reference);
+	}
+	ASSERT_EQ(bmstu::parallel::reduce(ints.begin(), ints.begin(), 5), 5);
+}
+
+TEST(Parallel, TransformAndForEach)
+{
+	bmstu::thread_pool pool(4);
+	auto v = random_ints(100000, 3);
+	bmstu::simple_vector<long long> squares(v.size());
+	auto end = bmstu::parallel::transform(
+		pool, v.begin(), v.end(), squares.begin(),
+		[](int x) { return static_cast<long long>(x) * x; });
+	ASSERT_EQ(end, squares.end());
+
+	bmstu::parallel::for_each(pool, v.begin(), v.end(), [](int& x) { x += 1; });
+	for (size_t i = 0; i < v.size(); ++i)
+	{
+		ASSERT_EQ(squares[i], static_cast<long long>(v[i] - 1) * (v[i] - 1));
+	}
+}
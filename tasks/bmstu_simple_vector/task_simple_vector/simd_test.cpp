@@ -0,0 +1,163 @@
+#include "bmstu_simd.h"
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+#include "bmstu_simple_vector.h"
+
+namespace
+{
+// Векторные ядра обязаны совпадать со скалярными на любом размере (хвосты
+// короче регистра) и на любой позиции первого несовпадения.
+template <typename T>
+void check_mismatch_matches_scalar(const std::vector<T>& base)
+{
+	for (size_t n = 0; n <= base.size(); ++n)
+	{
+		for (size_t pos = 0; pos <= n; ++pos)
+		{
+			std::vector<T> other(base.begin(), base.begin() + n);
+			if (pos < n)
+			{
+				other[pos] = static_cast<T>(other[pos] + 1);
+			}
+			size_t expected = bmstu::simd::scalar::mismatch(base.data(),
+															other.data(), n);
+			ASSERT_EQ(bmstu::simd::mismatch(base.data(), other.data(), n),
+					  expected);
+#ifdef BMSTU_SIMD_X86
+			if constexpr (std::is_floating_point_v<T>)
+			{
+				ASSERT_EQ(bmstu::simd::sse2::mismatch(base.data(),
+													  other.data(), n),
+						  expected);
+				if (bmstu::simd::has_avx2())
+				{
+					ASSERT_EQ(bmstu::simd::avx2::mismatch(base.data(),
+														  other.data(), n),
+							  expected);
+				}
+			}
+			else
+			{
+				auto* x = reinterpret_cast<const unsigned char*>(base.data());
+				auto* y = reinterpret_cast<const unsigned char*>(other.data());
+				size_t bytes = n * sizeof(T);
+				ASSERT_EQ(bmstu::simd::sse2::mismatch_bytes(x, y, bytes) /
+							  sizeof(T),
+						  expected);
+				if (bmstu::simd::has_avx2())
+				{
+					ASSERT_EQ(bmstu::simd::avx2::mismatch_bytes(x, y, bytes) /
+								  sizeof(T),
+							  expected);
+				}
+			}
+#endif
+		}
+	}
+}
+
+template <typename T>
+std::vector<T> random_values(size_t count)
+{
+	std::mt19937 gen(7);
+	std::vector<T> values(count);
+	for (auto& value : values)
+	{
+		value = static_cast<T>(gen() % 100);
+	}
+	return values;
+}
+
+template <typename T>
+void check_fill_matches_scalar()
+{
+	for (size_t n = 0; n < 70; ++n)
+	{
+		std::vector<T> expected(n + 1, T(0));
+		std::vector<T> actual(n + 1, T(0));
+		bmstu::simd::scalar::fill(expected.data(), n, T(42));
+		bmstu::simd::fill(actual.data(), n, T(42));
+		// ячейка за концом не тронута
+		ASSERT_EQ(actual, expected);
+	}
+}
+}  // namespace
+
+TEST(Simd, MismatchMatchesScalar)
+{
+	check_mismatch_matches_scalar(random_values<char>(70));
+	check_mismatch_matches_scalar(random_values<std::int16_t>(70));
+	check_mismatch_matches_scalar(random_values<int>(70));
+	check_mismatch_matches_scalar(random_values<std::uint64_t>(70));
+	check_mismatch_matches_scalar(random_values<float>(70));
+	check_mismatch_matches_scalar(random_values<double>(70));
+}
+
+TEST(Simd, FloatEqualitySemantics)
+{
+	const float nan = std::numeric_limits<float>::quiet_NaN();
+	std::vector<float> a(20, 1.0f);
+	std::vector<float> b(20, 1.0f);
+	a[13] = -0.0f;
+	b[13] = 0.0f;
+	// -0.0 == 0.0, хотя байты различаются
+	ASSERT_TRUE(bmstu::simd::equal(a.data(), b.data(), a.size()));
+	a[17] = nan;
+	b[17] = nan;
+	// NaN не равен сам себе
+	ASSERT_EQ(bmstu::simd::mismatch(a.data(), b.data(), a.size()), 17u);
+	ASSERT_EQ(bmstu::simd::compare_three_way(a.data(), a.size(), b.data(),
+											 b.size()),
+			  std::partial_ordering::unordered);
+}
+
+TEST(Simd, CompareThreeWayMatchesStd)
+{
+	std::mt19937 gen(11);
+	for (int round = 0; round < 500; ++round)
+	{
+		bmstu::simple_vector<signed char> a;
+		bmstu::simple_vector<signed char> b;
+		size_t a_size = gen() % 40;
+		size_t b_size = gen() % 40;
+		for (size_t i = 0; i < std::max(a_size, b_size); ++i)
+		{
+			// мало различных значений, чтобы чаще встречались общие префиксы
+			auto value = static_cast<signed char>(gen() % 3 - 1);
+			if (i < a_size)
+			{
+				a.push_back(value);
+			}
+			if (i < b_size)
+			{
+				b.push_back(gen() % 8 == 0 ? static_cast<signed char>(-value)
+										   : value);
+			}
+		}
+		auto expected = std::lexicographical_compare_three_way(
+			a.begin(), a.end(), b.begin(), b.end());
+		ASSERT_EQ(a <=> b, expected);
+		ASSERT_EQ(a == b, expected == 0);
+	}
+}
+
+TEST(Simd, FillMatchesScalar)
+{
+	check_fill_matches_scalar<char>();
+	check_fill_matches_scalar<std::int16_t>();
+	check_fill_matches_scalar<int>();
+	check_fill_matches_scalar<double>();
+
+	bmstu::simple_vector<int> v(37, 5);
+	v.resize(100, 9);
+	ASSERT_EQ(v[36], 5);
+	ASSERT_EQ(v[37], 9);
+	ASSERT_EQ(v[99], 9);
+	v.resize(120);
+	ASSERT_EQ(v[119], 0);
+}
@@ -1,9 +1,14 @@
 #include "bmstu_simple_vector.h"
 
 #include <gtest/gtest.h>
+#include <string>
+#include <memory_resource>
 #include <algorithm>
 #include <numeric>
+#include <iterator>
+#include <list>
 #include <sstream>
+#include <vector>
 
 TEST(SimpleVector, DefaultConstructor)
 {
@@ -452,8 +457,9 @@ TEST(SimpleVector, PushBackCopyMove)
 
 	v.push_back(original);
 
-	ASSERT_EQ(CopyTracker::copy_count, 2);
-	ASSERT_GE(CopyTracker::move_count, 1);
+	// элемент копируется прямо в новый буфер
+	ASSERT_EQ(CopyTracker::copy_count, 1);
+	ASSERT_EQ(CopyTracker::move_count, 0);
 	ASSERT_EQ(v[0].value, 42);
 	ASSERT_EQ(original.value, 42);
 }
@@ -467,7 +473,7 @@ TEST(SimpleVector, PushBackCopyMove2)
 
 	v.push_back(std::move(original));
 
-	ASSERT_EQ(CopyTracker::copy_count, 1);
+	ASSERT_EQ(CopyTracker::copy_count, 0);
 	ASSERT_GE(CopyTracker::move_count, 1);
 	ASSERT_EQ(v[0].value, 42);
 	ASSERT_EQ(original.value, 0);
@@ -480,3 +486,321 @@ TEST(SimpleVector, PushBackCopyMove3)
 	auto it = v.begin();
 	it = nullptr;
 }
+
+TEST(SimpleVector, PmrMonotonicBuffer)
+{
+	// вышестоящий ресурс запрещает выделения: всё должно уместиться в буфер
+	std::byte buffer[16 * 1024];
+	std::pmr::monotonic_buffer_resource arena(
+		buffer, sizeof(buffer), std::pmr::null_memory_resource());
+
+	bmstu::pmr::simple_vector<std::pmr::string> v(&arena);
+	for (int i = 0; i < 20; ++i)
+	{
+		v.push_back(std::pmr::string(40, static_cast<char>('a' + i)));
+	}
+	ASSERT_EQ(v.size(), 20u);
+	ASSERT_EQ(v.get_allocator().resource(), &arena);
+	ASSERT_EQ(v[19].get_allocator().resource(), &arena);
+	ASSERT_EQ(v[19], std::pmr::string(40, 'a' + 19));
+
+	bmstu::pmr::simple_vector<std::pmr::string> copy(v, &arena);
+	ASSERT_EQ(copy, v);
+
+	// присваивание не переносит polymorphic_allocator: копия остаётся
+	// в ресурсе получателя
+	std::pmr::unsynchronized_pool_resource other_resource;
+	bmstu::pmr::simple_vector<std::pmr::string> other(&other_resource);
+	other = v;
+	ASSERT_EQ(other.get_allocator().resource(), &other_resource);
+	ASSERT_EQ(other, v);
+}
+
+namespace
+{
+struct no_default
+{
+	explicit no_default(int v) : value(v) { ++alive; }
+	no_default(const no_default& other) : value(other.value) { ++alive; }
+	no_default(no_default&& other) noexcept : value(other.value) { ++alive; }
+	no_default& operator=(const no_default&) = default;
+	no_default& operator=(no_default&&) noexcept = default;
+	~no_default() { --alive; }
+
+	int value;
+	static int alive;
+};
+
+int no_default::alive = 0;
+}  // namespace
+
+TEST(SimpleVector, ReserveDoesNotConstruct)
+{
+	{
+		bmstu::simple_vector<no_default> v;
+		v.reserve(100);
+		ASSERT_EQ(v.capacity(), 100u);
+		ASSERT_EQ(no_default::alive, 0);
+
+		for (int i = 0; i < 150; ++i)
+		{
+			v.push_back(no_default(i));
+		}
+		ASSERT_EQ(no_default::alive, 150);
+		v.insert(v.begin(), no_default(-1));
+		v.erase(v.begin() + 10);
+		v.pop_back();
+		ASSERT_EQ(no_default::alive, 149);
+		ASSERT_EQ(v[0].value, -1);
+		ASSERT_EQ(v[10].value, 10);
+
+		v.clear();
+		ASSERT_EQ(no_default::alive, 0);
+		v.push_back(no_default(7));
+	}
+	ASSERT_EQ(no_default::alive, 0);
+}
+
+TEST(SimpleVector, EmplaceBack)
+{
+	bmstu::simple_vector<std::pair<int, std::string>> v;
+	auto& last = v.emplace_back(1, "one");
+	ASSERT_EQ(last.second, "one");
+	v.emplace_back(2, std::string(30, 'x'));
+	v.emplace(v.begin(), 0, "zero");
+	ASSERT_EQ(v.size(), 3u);
+	ASSERT_EQ(v[0].first, 0);
+	ASSERT_EQ(v[2].second, std::string(30, 'x'));
+}
+
+TEST(SimpleVector, PushBackOwnElement)
+{
+	bmstu::simple_vector<std::string> v{std::string(40, 'a')};
+	for (int i = 0; i < 10; ++i)
+	{
+		v.push_back(v[0]);
+		v.insert(v.begin(), v.back());
+	}
+	ASSERT_EQ(v.size(), 21u);
+	for (const auto& s : v)
+	{
+		ASSERT_EQ(s, std::string(40, 'a'));
+	}
+}
+
+TEST(SimpleVector, GrowthAndShrinkToFit)
+{
+	bmstu::simple_vector<int> v;
+	size_t reallocations = 0;
+	for (int i = 0; i < 1000; ++i)
+	{
+		size_t old_capacity = v.capacity();
+		v.push_back(i);
+		reallocations += v.capacity() != old_capacity;
+	}
+	ASSERT_EQ(reallocations, 11u);
+	ASSERT_EQ(v.capacity(), 1024u);
+
+	v.resize(10);
+	v.shrink_to_fit();
+	ASSERT_EQ(v.capacity(), 10u);
+	ASSERT_EQ(v[9], 9);
+
+	bmstu::simple_vector<int, std::allocator<int>,
+						 bmstu::fixed_chunk_growth<100>>
+		chunked;
+	chunked.push_back(1);
+	ASSERT_EQ(chunked.capacity(), 100u);
+
+	v.clear();
+	v.shrink_to_fit();
+	ASSERT_EQ(v.capacity(), 0u);
+}
+
+TEST(SimpleVector, ResizeWithValue)
+{
+	bmstu::simple_vector<std::string> v;
+	v.resize(3, "abc");
+	ASSERT_EQ(v.size(), 3u);
+	ASSERT_EQ(v[2], "abc");
+	v.resize(1, "zzz");
+	ASSERT_EQ(v.size(), 1u);
+	ASSERT_EQ(v[0], "abc");
+}
+
+namespace
+{
+// копирование бросает на заданном по счёту вызове; перемещение не
+// помечено noexcept, поэтому вектор при переносе обязан копировать
+struct throwing_copy
+{
+	explicit throwing_copy(int v) : value(v) {}
+	throwing_copy(const throwing_copy& other) : value(other.value)
+	{
+		if (--copies_left == 0)
+		{
+			throw std::runtime_error("copy failed");
+		}
+	}
+	throwing_copy(throwing_copy&& other) : value(other.value)
+	{
+		other.value = -1;
+	}
+	throwing_copy& operator=(const throwing_copy&) = default;
+	throwing_copy& operator=(throwing_copy&&) = default;
+
+	int value;
+	static int copies_left;
+};
+
+int throwing_copy::copies_left = 0;
+}  // namespace
+
+TEST(SimpleVector, StrongGuaranteeOnGrowth)
+{
+	bmstu::simple_vector<throwing_copy> v;
+	v.reserve(4);
+	for (int i = 0; i < 4; ++i)
+	{
+		v.emplace_back(i);
+	}
+
+	throwing_copy::copies_left = 3;
+	ASSERT_THROW(v.emplace_back(4), std::runtime_error);
+	ASSERT_EQ(v.size(), 4u);
+	ASSERT_EQ(v.capacity(), 4u);
+	for (int i = 0; i < 4; ++i)
+	{
+		ASSERT_EQ(v[i].value, i);
+	}
+
+	throwing_copy::copies_left = 3;
+	ASSERT_THROW(v.reserve(100), std::runtime_error);
+	ASSERT_EQ(v.capacity(), 4u);
+	ASSERT_EQ(v[3].value, 3);
+
+	throwing_copy::copies_left = 100;
+	v.emplace_back(4);
+	ASSERT_EQ(v.size(), 5u);
+	ASSERT_EQ(v[4].value, 4);
+}
+
+
+TEST(SimpleVector, RangeConstructorAndAssign)
+{
+	static_assert(std::contiguous_iterator<bmstu::simple_vector<int>::iterator>);
+
+	std::vector<int> source{1, 2, 3, 4, 5};
+	bmstu::simple_vector v(source.begin(), source.end());
+	ASSERT_EQ(v, (bmstu::simple_vector<int>{1, 2, 3, 4, 5}));
+	ASSERT_EQ(v.capacity(), 5u);
+
+	std::list<std::string> words{"a", "bb", "ccc"};
+	bmstu::simple_vector<std::string> w(words.begin(), words.end());
+	ASSERT_EQ(w.size(), 3u);
+	ASSERT_EQ(w[2], "ccc");
+
+	w.assign({"x"});
+	ASSERT_EQ(w.size(), 1u);
+	ASSERT_EQ(w[0], "x");
+	v.assign(source.begin() + 3, source.end());
+	ASSERT_EQ(v, (bmstu::simple_vector<int>{4, 5}));
+}
+
+TEST(SimpleVector, InsertRange)
+{
+	bmstu::simple_vector<int> v{1, 2, 3};
+	std::vector<int> chunk{10, 11, 12, 13};
+
+	// с перевыделением
+	auto it = v.insert(v.begin() + 1, chunk.begin(), chunk.end());
+	ASSERT_EQ(*it, 10);
+	ASSERT_EQ(v, (bmstu::simple_vector<int>{1, 10, 11, 12, 13, 2, 3}));
+
+	// без перевыделения: сдвиг memmove
+	v.reserve(20);
+	v.insert(v.begin(), {7, 8});
+	ASSERT_EQ(v, (bmstu::simple_vector<int>{7, 8, 1, 10, 11, 12, 13, 2, 3}));
+	v.insert(v.end(), chunk.begin(), chunk.begin());
+	ASSERT_EQ(v.size(), 9u);
+
+	// однопроходный источник
+	std::istringstream input("4 5 6");
+	v.insert(v.begin() + 2, std::istream_iterator<int>(input),
+			 std::istream_iterator<int>());
+	ASSERT_EQ(v, (bmstu::simple_vector<int>{7, 8, 4, 5, 6, 1, 10, 11, 12, 13,
+											2, 3}));
+}
+
+TEST(SimpleVector, InsertRangeNonTrivial)
+{
+	bmstu::simple_vector<std::string> v{"a", "b", "c", "d"};
+	v.reserve(10);
+	std::list<std::string> more{"x", "y"};
+	v.insert(v.begin() + 1, more.begin(), more.end());
+	ASSERT_EQ(v, (bmstu::simple_vector<std::string>{"a", "x", "y", "b", "c",
+													"d"}));
+	v.append_range(more);
+	v.append_range(std::vector<std::string>(5, std::string(30, 'z')));
+	ASSERT_EQ(v.size(), 13u);
+	ASSERT_EQ(v[7], "y");
+	ASSERT_EQ(v[12], std::string(30, 'z'));
+}
+
+TEST(SimpleVector, ThinIterator)
+{
+	using iterator = bmstu::simple_vector<int>::iterator;
+	using const_iterator = bmstu::simple_vector<int>::const_iterator;
+#ifndef BMSTU_CHECKED_ITERATORS
+	static_assert(sizeof(iterator) == sizeof(int*));
+#endif
+	static_assert(std::is_trivially_copyable_v<iterator>);
+	static_assert(std::contiguous_iterator<const_iterator>);
+	static_assert(std::is_convertible_v<iterator, const_iterator>);
+	static_assert(!std::is_convertible_v<const_iterator, iterator>);
+	static_assert(std::is_same_v<std::iter_reference_t<const_iterator>,
+								 const int&>);
+
+	bmstu::simple_vector<int> v{5, 3, 1, 4, 2};
+	std::ranges::sort(v);
+	ASSERT_EQ(v, (bmstu::simple_vector<int>{1, 2, 3, 4, 5}));
+	const auto& cv = v;
+	ASSERT_EQ(std::accumulate(cv.begin(), cv.end(), 0), 15);
+	const_iterator it = v.begin() + 2;
+	ASSERT_EQ(it - cv.begin(), 2);
+	ASSERT_EQ(*v.erase(it), 4);
+	ASSERT_EQ(v.cend() - v.cbegin(), 4);
+}
+
+#ifdef BMSTU_CHECKED_ITERATORS
+TEST(SimpleVector, CheckedIterators)
+{
+	bmstu::simple_vector<int> v{1, 2, 3};
+	ASSERT_THROW(*v.end(), std::out_of_range);
+	ASSERT_THROW(v.begin() - 1, std::out_of_range);
+	ASSERT_THROW(v.begin()[3], std::out_of_range);
+	ASSERT_THROW(v[3], std::out_of_range);
+	auto last = v.end();
+	ASSERT_THROW(++last, std::out_of_range);
+
+	// вставка в середину и перевыделение портят старые итераторы
+	auto it = v.begin() + 1;
+	v.insert(v.begin(), 0);
+	ASSERT_THROW(*it, std::logic_error);
+	it = v.begin() + 1;
+	v.reserve(v.capacity() + 1);
+	ASSERT_THROW(++it, std::logic_error);
+
+	// итератор, который вернул erase, действителен
+	it = v.erase(v.begin());
+	ASSERT_EQ(*it, 1);
+	bmstu::simple_vector<int> other{1};
+	ASSERT_THROW(other.end() - v.begin(), std::logic_error);
+
+	// push_back без перевыделения не трогает начало вектора
+	v.reserve(10);
+	it = v.begin();
+	v.push_back(4);
+	ASSERT_EQ(*it, 1);
+}
+#endif
@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+#include <mutex>
+#include "bmstu_concurrent_stack.h"
+#include "bmstu_elimination_stack.h"
+#include "bmstu_stack.h"
+
+// Пропускная способность общего стека при 1..64 потоках: каждый поток
+// чередует push и pop. Сравнение lock-free стека, того же стека с массивом
+// исключения и стека под мьютексом. Выигрыш исключения заметен, когда
+// потоков больше, чем ядер, делящих одну кэш-линию вершины (от 16 и выше).
+
+namespace
+{
+class mutex_stack
+{
+   public:
+	void push(int value)
+	{
+		std::lock_guard lock(mutex_);
+		stack_.push(value);
+	}
+
+	bmstu::optional<int> try_pop()
+	{
+		std::lock_guard lock(mutex_);
+		if (stack_.empty())
+		{
+			return {};
+		}
+		bmstu::optional<int> result(stack_.top());
+		stack_.pop();
+		return result;
+	}
+
+   private:
+	std::mutex mutex_;
+	bmstu::stack<int> stack_;
+};
+
+template <typename Stack>
+void BM_SharedPushPop(benchmark::State& state)
+{
+	static Stack shared;
+	int value = static_cast<int>(state.thread_index());
+	for (auto _ : state)
+	{
+		shared.push(value);
+		benchmark::DoNotOptimize(shared.try_pop());
+	}
+	state.SetItemsProcessed(state.iterations() * 2);
+}
+}  // namespace
+
+BENCHMARK(BM_SharedPushPop<bmstu::concurrent_stack<int>>)
+	->ThreadRange(1, 64)
+	->UseRealTime();
+BENCHMARK(BM_SharedPushPop<bmstu::elimination_stack<int>>)
+	->ThreadRange(1, 64)
+	->UseRealTime();
+BENCHMARK(BM_SharedPushPop<mutex_stack>)->ThreadRange(1, 64)->UseRealTime();
@@ -0,0 +1,30 @@
+#include <benchmark/benchmark.h>
+#include "bmstu_small_stack.h"
+#include "bmstu_stack.h"
+
+// Короткоживущий стек на несколько элементов: создать, заполнить, разобрать.
+// bmstu::stack выделяет память на первом же push, small_stack до N
+// элементов обходится встроенным буфером.
+
+template <typename Stack>
+static void BM_ShortLived(benchmark::State& state)
+{
+	const auto count = static_cast<int>(state.range(0));
+	for (auto _ : state)
+	{
+		Stack s;
+		for (int i = 0; i < count; ++i)
+		{
+			s.push(i);
+		}
+		while (!s.empty())
+		{
+			benchmark::DoNotOptimize(s.top());
+			s.pop();
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_ShortLived<bmstu::stack<int>>)->DenseRange(4, 32, 4);
+BENCHMARK(BM_ShortLived<bmstu::small_stack<int, 16>>)->DenseRange(4, 32, 4);
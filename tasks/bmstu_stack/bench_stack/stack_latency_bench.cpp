@@ -0,0 +1,68 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <vector>
+#include "bmstu_segmented_stack.h"
+#include "bmstu_stack.h"
+
+// Задержка одного push: p50/p99/p999/max по всем вставкам.
+// У непрерывного стека хвост распределения определяется перевыделениями,
+// у сегментированного — выделением одного блока.
+
+namespace
+{
+struct payload
+{
+	payload(int v) { data.fill(v); }
+
+	std::array<int, 16> data;
+};
+
+template <typename Stack>
+void BM_PushLatency(benchmark::State& state)
+{
+	using clock = std::chrono::steady_clock;
+	const auto count = static_cast<size_t>(state.range(0));
+	std::vector<int64_t> samples;
+	samples.reserve(count);
+
+	for (auto _ : state)
+	{
+		samples.clear();
+		Stack s;
+		for (size_t i = 0; i < count; ++i)
+		{
+			auto start = clock::now();
+			s.emplace(static_cast<int>(i));
+			auto finish = clock::now();
+			samples.push_back(
+				std::chrono::duration_cast<std::chrono::nanoseconds>(finish -
+																	 start)
+					.count());
+		}
+		benchmark::DoNotOptimize(s.top());
+	}
+
+	std::sort(samples.begin(), samples.end());
+	auto percentile = [&samples](double p)
+	{
+		auto index = static_cast<size_t>(p * (samples.size() - 1));
+		return static_cast<double>(samples[index]);
+	};
+	state.counters["p50_ns"] = percentile(0.5);
+	state.counters["p99_ns"] = percentile(0.99);
+	state.counters["p999_ns"] = percentile(0.999);
+	state.counters["max_ns"] = static_cast<double>(samples.back());
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+}  // namespace
+
+BENCHMARK(BM_PushLatency<bmstu::stack<payload>>)
+	->RangeMultiplier(10)
+	->Range(10'000, 1'000'000)
+	->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PushLatency<bmstu::segmented_stack<payload>>)
+	->RangeMultiplier(10)
+	->Range(10'000, 1'000'000)
+	->Unit(benchmark::kMillisecond);
@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+#include <stack>
+#include <vector>
+#include "bmstu_stack.h"
+
+// Пропускная способность push: N вставок в пустой стек.
+// Сравнение политик роста bmstu::stack с std::stack<T, std::vector<T>>.
+
+template <typename Stack>
+static void BM_Push(benchmark::State& state)
+{
+	const auto count = static_cast<int>(state.range(0));
+	for (auto _ : state)
+	{
+		Stack s;
+		for (int i = 0; i < count; ++i)
+		{
+			s.push(i);
+		}
+		benchmark::DoNotOptimize(s.top());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Stack>
+static void BM_PushReserved(benchmark::State& state)
+{
+	const auto count = static_cast<int>(state.range(0));
+	for (auto _ : state)
+	{
+		Stack s;
+		s.reserve(static_cast<size_t>(count));
+		for (int i = 0; i < count; ++i)
+		{
+			s.push(i);
+		}
+		benchmark::DoNotOptimize(s.top());
+		benchmark::ClobberMemory();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+using std_stack = std::stack<int, std::vector<int>>;
+using bmstu_stack_1_5x = bmstu::stack<int>;
+using bmstu_stack_2x = bmstu::stack<int, bmstu::geometric_growth<2, 1>>;
+using bmstu_stack_chunk = bmstu::stack<int, bmstu::fixed_chunk_growth<4096>>;
+
+BENCHMARK(BM_Push<std_stack>)->RangeMultiplier(10)->Range(1'000, 10'000'000);
+BENCHMARK(BM_Push<bmstu_stack_1_5x>)
+	->RangeMultiplier(10)
+	->Range(1'000, 10'000'000);
+BENCHMARK(BM_Push<bmstu_stack_2x>)
+	->RangeMultiplier(10)
+	->Range(1'000, 10'000'000);
+// рост порциями остаётся квадратичным, поэтому большие N не меряем
+BENCHMARK(BM_Push<bmstu_stack_chunk>)
+	->RangeMultiplier(10)
+	->Range(1'000, 1'000'000);
+BENCHMARK(BM_PushReserved<bmstu_stack_1_5x>)
+	->RangeMultiplier(10)
+	->Range(1'000, 10'000'000);
@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+#include "bmstu_stack.h"
+
+// Стоимость перевыделений для стека небольших структур: перенос memcpy
+// (тривиально переносимый тип) против поэлементного move + деструктора.
+
+namespace
+{
+struct small_struct
+{
+	int id;
+	float weight;
+	double score;
+};
+
+// то же самое, но с пользовательскими конструкторами: без специализации
+// трейта стек вынужден переносить элементы по одному
+struct small_struct_moved
+{
+	small_struct_moved(int i) : id(i), weight(0), score(0) {}
+	small_struct_moved(small_struct_moved&& other) noexcept
+		: id(other.id), weight(other.weight), score(other.score)
+	{
+	}
+	~small_struct_moved() {}
+
+	int id;
+	float weight;
+	double score;
+};
+}  // namespace
+
+template <typename T>
+static void BM_GrowSmallStructs(benchmark::State& state)
+{
+	const auto count = static_cast<int>(state.range(0));
+	for (auto _ : state)
+	{
+		bmstu::stack<T> s;
+		for (int i = 0; i < count; ++i)
+		{
+			s.emplace(i);
+		}
+		benchmark::DoNotOptimize(s.top());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_GrowSmallStructs<small_struct>)
+	->RangeMultiplier(10)
+	->Range(1'000, 1'000'000);
+BENCHMARK(BM_GrowSmallStructs<small_struct_moved>)
+	->RangeMultiplier(10)
+	->Range(1'000, 1'000'000);
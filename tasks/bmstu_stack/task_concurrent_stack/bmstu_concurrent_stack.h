@@ -0,0 +1,155 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include "bmstu_hazard_pointers.h"
+#include "bmstu_optional.h"
+
+namespace bmstu
+{
+// Lock-free стек Трайбера: вершина — атомарный указатель, push и pop
+// меняют её одним CAS.
+//
+// Снятый узел освобождается через hazard pointers: пока какой-то поток
+// держит узел под защитой, память не переиспользуется. Это же закрывает
+// ABA — CAS в try_pop не может увидеть тот же адрес у другого узла, пока
+// старый узел защищён.
+//
+// top() не предоставляется: ссылка на вершину становится висячей, как только
+// другой поток снимет элемент. Вместо пары top()/pop() есть try_pop().
+template <typename T, size_t Slots>
+class elimination_stack;
+
+template <typename T>
+class concurrent_stack
+{
+	template <typename U, size_t Slots>
+	friend class elimination_stack;
+
+	struct node
+	{
+		template <typename... Args>
+		explicit node(Args&&... args) : value(std::forward<Args>(args)...)
+		{
+		}
+
+		T value;
+		node* next = nullptr;
+	};
+
+   public:
+	concurrent_stack() = default;
+
+	concurrent_stack(const concurrent_stack&) = delete;
+	concurrent_stack& operator=(const concurrent_stack&) = delete;
+
+	// деструктор не должен выполняться одновременно с другими операциями
+	~concurrent_stack()
+	{
+		node* current = head_.load(std::memory_order_relaxed);
+		while (current != nullptr)
+		{
+			node* next = current->next;
+			delete current;
+			current = next;
+		}
+	}
+
+	template <typename... Args>
+	void emplace(Args&&... args)
+	{
+		push_node_(new node(std::forward<Args>(args)...));
+	}
+
+	// copy semantics (lvalue)
+	void push(const T& value) { emplace(value); }
+
+	// move semantics (rvalue)
+	void push(T&& value) { emplace(std::move(value)); }
+
+	// снимает вершину; пустой optional, если стек пуст
+	optional<T> try_pop()
+	{
+		node* old_head = pop_node_();
+		if (old_head == nullptr)
+		{
+			return {};
+		}
+		return extract_(old_head);
+	}
+
+	// снимает вершину без возврата значения, как bmstu::stack::pop
+	void pop()
+	{
+		node* old_head = pop_node_();
+		if (old_head == nullptr)
+			throw std::underflow_error("Stack is empty!");
+		hazard_pointers::retire(old_head);
+	}
+
+	// снимок состояния: при конкурентном доступе может сразу устареть
+	bool empty() const noexcept
+	{
+		return head_.load(std::memory_order_acquire) == nullptr;
+	}
+
+   private:
+	// одна попытка CAS; false — вершину успел сменить другой поток
+	bool try_push_node_(node* new_node) noexcept
+	{
+		new_node->next = head_.load(std::memory_order_relaxed);
+		return head_.compare_exchange_strong(new_node->next, new_node,
+											 std::memory_order_release,
+											 std::memory_order_relaxed);
+	}
+
+	// одна попытка снять вершину: false — CAS проигран, иначе в taken
+	// снятый узел или nullptr, если стек пуст
+	bool try_pop_node_(node*& taken)
+	{
+		node* old_head = hazard_pointers::protect(head_);
+		bool done = old_head == nullptr ||
+					head_.compare_exchange_strong(old_head, old_head->next);
+		hazard_pointers::clear();
+		taken = done ? old_head : nullptr;
+		return done;
+	}
+
+	void push_node_(node* new_node) noexcept
+	{
+		while (!try_push_node_(new_node))
+		{
+		}
+	}
+
+	node* pop_node_()
+	{
+		node* taken = nullptr;
+		while (!try_pop_node_(taken))
+		{
+		}
+		return taken;
+	}
+
+	// забирает значение из снятого узла и отдаёт узел на освобождение
+	static optional<T> extract_(node* taken)
+	{
+		optional<T> result;
+		try
+		{
+			result.emplace(std::move(taken->value));
+		}
+		catch (...)
+		{
+			hazard_pointers::retire(taken);
+			throw;
+		}
+		hazard_pointers::retire(taken);
+		return result;
+	}
+
+	std::atomic<node*> head_{nullptr};
+};
+}  // namespace bmstu
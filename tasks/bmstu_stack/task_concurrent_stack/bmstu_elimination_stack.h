@@ -0,0 +1,221 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include "bmstu_concurrent_stack.h"
+#include "bmstu_optional.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace bmstu
+{
+// Стек Трайбера с массивом исключения (Hendler, Shavit, Yerushalmi, 2004).
+//
+// Если CAS на вершине проигран, операция не повторяет его сразу, а идёт в
+// случайную ячейку массива: push выкладывает туда свой узел и ждёт, pop
+// забирает выложенный узел. Встретившиеся push и pop взаимно уничтожаются,
+// не трогая общую вершину, поэтому при симметричной нагрузке пропускная
+// способность растёт с числом потоков, а не упирается в одну кэш-линию.
+//
+// Ширина используемой части массива подстраивается под нагрузку: занятая
+// ячейка или перехваченный узел расширяют её, ожидание без партнёра сужает.
+template <typename T, size_t Slots = 32>
+class elimination_stack
+{
+	static_assert(Slots > 0, "elimination array must not be empty");
+
+	using node = typename concurrent_stack<T>::node;
+
+   public:
+	// сколько раз операция проверяет ячейку, прежде чем вернуться к вершине
+	static constexpr size_t spin_limit = 64;
+
+	elimination_stack() = default;
+
+	elimination_stack(const elimination_stack&) = delete;
+	elimination_stack& operator=(const elimination_stack&) = delete;
+
+	template <typename... Args>
+	void emplace(Args&&... args)
+	{
+		push_node_(new node(std::forward<Args>(args)...));
+	}
+
+	// copy semantics (lvalue)
+	void push(const T& value) { emplace(value); }
+
+	// move semantics (rvalue)
+	void push(T&& value) { emplace(std::move(value)); }
+
+	// снимает вершину; пустой optional, если стек пуст
+	optional<T> try_pop()
+	{
+		node* taken = pop_node_();
+		if (taken == nullptr)
+		{
+			return {};
+		}
+		return concurrent_stack<T>::extract_(taken);
+	}
+
+	void pop()
+	{
+		node* taken = pop_node_();
+		if (taken == nullptr)
+			throw std::underflow_error("Stack is empty!");
+		hazard_pointers::retire(taken);
+	}
+
+	// снимок состояния: при конкурентном доступе может сразу устареть
+	bool empty() const noexcept { return stack_.empty(); }
+
+	// текущая ширина массива исключения, от 1 до Slots
+	size_t elimination_width() const noexcept
+	{
+		return width_.load(std::memory_order_relaxed);
+	}
+
+   private:
+	struct alignas(64) slot
+	{
+		// nullptr — свободна, узел — push ждёт партнёра, taken_ — узел забран
+		std::atomic<void*> offer{nullptr};
+	};
+
+	void push_node_(node* new_node)
+	{
+		while (!stack_.try_push_node_(new_node))
+		{
+			if (exchange_push_(new_node))
+			{
+				return;
+			}
+		}
+	}
+
+	node* pop_node_()
+	{
+		node* taken = nullptr;
+		while (!stack_.try_pop_node_(taken))
+		{
+			taken = exchange_pop_();
+			if (taken != nullptr)
+			{
+				return taken;
+			}
+		}
+		return taken;
+	}
+
+	// true, если узел забрал pop из массива
+	bool exchange_push_(node* offered)
+	{
+		slot& cell = slots_[pick_slot_()];
+		void* expected = nullptr;
+		if (!cell.offer.compare_exchange_strong(expected, offered))
+		{
+			grow_();
+			return false;
+		}
+
+		for (size_t i = 0; i < spin_limit; ++i)
+		{
+			if (cell.offer.load() == taken_())
+			{
+				cell.offer.store(nullptr);
+				return true;
+			}
+			cpu_relax_();
+		}
+
+		expected = offered;
+		if (cell.offer.compare_exchange_strong(expected, nullptr))
+		{
+			shrink_();
+			return false;
+		}
+		// pop успел забрать узел между последней проверкой и отзывом
+		cell.offer.store(nullptr);
+		return true;
+	}
+
+	// узел, выложенный push'ем, или nullptr, если партнёр не нашёлся.
+	// Узел до успешного CAS не разыменовывается, поэтому hazard pointer
+	// здесь не нужен
+	node* exchange_pop_()
+	{
+		slot& cell = slots_[pick_slot_()];
+		for (size_t i = 0; i < spin_limit; ++i)
+		{
+			void* offer = cell.offer.load();
+			if (offer != nullptr && offer != taken_())
+			{
+				if (cell.offer.compare_exchange_strong(offer, taken_()))
+				{
+					return static_cast<node*>(offer);
+				}
+				grow_();
+				return nullptr;
+			}
+			cpu_relax_();
+		}
+		shrink_();
+		return nullptr;
+	}
+
+	// Гонки между grow_ и shrink_ безвредны: ширина — лишь подсказка
+	void grow_() noexcept
+	{
+		size_t width = width_.load(std::memory_order_relaxed);
+		if (width < Slots)
+		{
+			width_.store(width * 2 < Slots ? width * 2 : Slots,
+						 std::memory_order_relaxed);
+		}
+	}
+
+	void shrink_() noexcept
+	{
+		size_t width = width_.load(std::memory_order_relaxed);
+		if (width > 1)
+		{
+			width_.store(width / 2, std::memory_order_relaxed);
+		}
+	}
+
+	size_t pick_slot_() const noexcept
+	{
+		// xorshift32: своё состояние у каждого потока, без общей памяти
+		static thread_local uint32_t state = static_cast<uint32_t>(
+			std::hash<std::thread::id>{}(std::this_thread::get_id()) | 1u);
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state % width_.load(std::memory_order_relaxed);
+	}
+
+	static void* taken_() noexcept
+	{
+		static char marker;
+		return &marker;
+	}
+
+	static void cpu_relax_() noexcept
+	{
+#if defined(__x86_64__) || defined(__i386__)
+		_mm_pause();
+#endif
+	}
+
+	concurrent_stack<T> stack_;
+	std::atomic<size_t> width_{1};
+	slot slots_[Slots];
+};
+}  // namespace bmstu
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+namespace bmstu
+{
+// Hazard pointers (M. Michael, 2004) для безопасного освобождения узлов
+// lock-free структур. Поток публикует в своей записи указатель, который
+// сейчас разыменовывает; удалённые узлы складываются в список retired и
+// освобождаются только тогда, когда ни одна запись на них не указывает.
+namespace hazard_pointers
+{
+inline constexpr size_t max_threads = 128;
+
+// с каждых reclaim_threshold удалённых узлов поток пробует освободить память
+inline constexpr size_t reclaim_threshold = 2 * max_threads;
+
+struct alignas(64) record
+{
+	std::atomic<bool> active{false};
+	std::atomic<const void*> pointer{nullptr};
+};
+
+struct retired_node
+{
+	void* ptr;
+	void (*deleter)(void*);
+};
+
+// общие для всех потоков записи и узлы, оставшиеся от завершившихся потоков
+struct domain
+{
+	record records[max_threads];
+	std::mutex orphans_mutex;
+	std::vector<retired_node> orphans;
+};
+
+inline domain& global_domain()
+{
+	static domain instance;
+	return instance;
+}
+
+inline bool is_hazardous(const void* ptr)
+{
+	for (const record& rec : global_domain().records)
+	{
+		if (rec.pointer.load() == ptr)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+// освобождает все узлы из retired, на которые нет hazard pointer'ов
+inline void reclaim(std::vector<retired_node>& retired)
+{
+	size_t kept = 0;
+	for (retired_node node : retired)
+	{
+		if (is_hazardous(node.ptr))
+		{
+			retired[kept++] = node;
+		}
+		else
+		{
+			node.deleter(node.ptr);
+		}
+	}
+	retired.resize(kept);
+}
+
+// состояние потока: занятая запись и его собственный список retired
+class thread_state
+{
+   public:
+	thread_state()
+	{
+		for (record& rec : global_domain().records)
+		{
+			bool expected = false;
+			if (rec.active.compare_exchange_strong(expected, true))
+			{
+				record_ = &rec;
+				return;
+			}
+		}
+		throw std::runtime_error("Too many threads use hazard pointers");
+	}
+
+	thread_state(const thread_state&) = delete;
+	thread_state& operator=(const thread_state&) = delete;
+
+	~thread_state()
+	{
+		record_->pointer.store(nullptr);
+		reclaim(retired_);
+		if (!retired_.empty())
+		{
+			// узлы ещё кем-то читаются: отдаём их домену
+			domain& dom = global_domain();
+			std::lock_guard lock(dom.orphans_mutex);
+			dom.orphans.insert(dom.orphans.end(), retired_.begin(),
+							   retired_.end());
+		}
+		record_->active.store(false);
+	}
+
+	record& hazard() noexcept { return *record_; }
+
+	void retire(void* ptr, void (*deleter)(void*))
+	{
+		retired_.push_back({ptr, deleter});
+		if (retired_.size() >= reclaim_threshold)
+		{
+			collect();
+		}
+	}
+
+	void collect()
+	{
+		reclaim(retired_);
+		domain& dom = global_domain();
+		std::unique_lock lock(dom.orphans_mutex, std::try_to_lock);
+		if (lock.owns_lock())
+		{
+			reclaim(dom.orphans);
+		}
+	}
+
+   private:
+	record* record_ = nullptr;
+	std::vector<retired_node> retired_;
+};
+
+inline thread_state& this_thread_state()
+{
+	static thread_local thread_state state;
+	return state;
+}
+
+// Читает src и публикует прочитанный указатель как hazard. Повторное чтение
+// гарантирует, что узел не был удалён между загрузкой и публикацией.
+template <typename Node>
+Node* protect(const std::atomic<Node*>& src)
+{
+	record& rec = this_thread_state().hazard();
+	Node* ptr = src.load();
+	while (true)
+	{
+		rec.pointer.store(ptr);
+		Node* again = src.load();
+		if (again == ptr)
+		{
+			return ptr;
+		}
+		ptr = again;
+	}
+}
+
+inline void clear() noexcept
+{
+	this_thread_state().hazard().pointer.store(nullptr);
+}
+
+template <typename Node>
+void retire(Node* node)
+{
+	this_thread_state().retire(
+		node, [](void* ptr) { delete static_cast<Node*>(ptr); });
+}
+
+// Принудительно освобождает всё, что уже можно освободить. Полезно после
+// остановки рабочих потоков, например в тестах на утечки.
+inline void collect() { this_thread_state().collect(); }
+}  // namespace hazard_pointers
+}  // namespace bmstu
@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "bmstu_elimination_stack.h"
+
+namespace
+{
+struct EliminationCounter
+{
+	EliminationCounter(int v) : value(v) { ++alive; }
+	EliminationCounter(const EliminationCounter& other) : value(other.value)
+	{
+		++alive;
+	}
+	EliminationCounter(EliminationCounter&& other) noexcept
+		: value(other.value)
+	{
+		++alive;
+	}
+	~EliminationCounter() { --alive; }
+
+	int value;
+	static std::atomic<int> alive;
+};
+
+std::atomic<int> EliminationCounter::alive = 0;
+}  // namespace
+
+TEST(EliminationStackTest, SingleThread)
+{
+	bmstu::elimination_stack<int> s;
+	ASSERT_TRUE(s.empty());
+	ASSERT_FALSE(s.try_pop().has_value());
+	ASSERT_EQ(s.elimination_width(), 1u);
+
+	s.push(1);
+	int two = 2;
+	s.push(two);
+	s.emplace(3);
+	ASSERT_FALSE(s.empty());
+
+	ASSERT_EQ(s.try_pop().value(), 3);
+	ASSERT_EQ(s.try_pop().value(), 2);
+	s.pop();
+	ASSERT_TRUE(s.empty());
+	ASSERT_THROW(s.pop(), std::underflow_error);
+}
+
+TEST(EliminationStackTest, MoveOnlyValues)
+{
+	bmstu::elimination_stack<std::unique_ptr<std::string>> s;
+	s.push(std::make_unique<std::string>("hello"));
+	auto popped = s.try_pop();
+	ASSERT_TRUE(popped.has_value());
+	ASSERT_EQ(**popped, "hello");
+}
+
+TEST(EliminationStackTest, StressEveryValuePoppedOnce)
+{
+	constexpr int kProducers = 8;
+	constexpr int kConsumers = 8;
+	constexpr int kPerProducer = 10000;
+	constexpr int kTotal = kProducers * kPerProducer;
+
+	bmstu::elimination_stack<int, 4> s;
+	std::vector<std::atomic<int>> seen(kTotal);
+	std::atomic<int> popped = 0;
+
+	std::vector<std::thread> threads;
+	for (int p = 0; p < kProducers; ++p)
+	{
+		threads.emplace_back(
+			[&s, p]
+			{
+				for (int i = 0; i < kPerProducer; ++i)
+				{
+					s.push(p * kPerProducer + i);
+				}
+			});
+	}
+	for (int c = 0; c < kConsumers; ++c)
+	{
+		threads.emplace_back(
+			[&]
+			{
+				while (popped.load() < kTotal)
+				{
+					auto value = s.try_pop();
+					if (value.has_value())
+					{
+						seen[*value].fetch_add(1);
+						popped.fetch_add(1);
+					}
+				}
+			});
+	}
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	ASSERT_TRUE(s.empty());
+	ASSERT_GE(s.elimination_width(), 1u);
+	ASSERT_LE(s.elimination_width(), 4u);
+	for (int i = 0; i < kTotal; ++i)
+	{
+		ASSERT_EQ(seen[i].load(), 1) << "value " << i;
+	}
+}
+
+TEST(EliminationStackTest, StressSymmetricLoadReclaimsNodes)
+{
+	constexpr int kThreads = 16;
+	constexpr int kOperations = 5000;
+
+	EliminationCounter::alive = 0;
+	{
+		bmstu::elimination_stack<EliminationCounter> s;
+		std::atomic<long long> pushed_sum = 0;
+		std::atomic<long long> popped_sum = 0;
+
+		std::vector<std::thread> threads;
+		for (int t = 0; t < kThreads; ++t)
+		{
+			threads.emplace_back(
+				[&, t]
+				{
+					for (int i = 0; i < kOperations; ++i)
+					{
+						int value = t * kOperations + i;
+						s.emplace(value);
+						pushed_sum.fetch_add(value);
+						if (auto popped = s.try_pop())
+						{
+							popped_sum.fetch_add(popped->value);
+						}
+					}
+				});
+		}
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+
+		while (auto popped = s.try_pop())
+		{
+			popped_sum.fetch_add(popped->value);
+		}
+		ASSERT_EQ(pushed_sum.load(), popped_sum.load());
+	}
+
+	bmstu::hazard_pointers::collect();
+	ASSERT_EQ(EliminationCounter::alive, 0);
+}
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace bmstu
+{
+// Стек на связном списке блоков по ChunkSize элементов.
+// В отличие от bmstu::stack, рост никогда не переносит уже лежащие элементы:
+// ссылки на них остаются валидными, а push в худшем случае выделяет один
+// блок фиксированного размера.
+template <typename T, size_t ChunkSize = 256>
+class segmented_stack
+{
+	static_assert(ChunkSize > 0, "chunk size must be positive");
+
+   public:
+	segmented_stack() = default;
+
+	segmented_stack(const segmented_stack&) = delete;
+	segmented_stack& operator=(const segmented_stack&) = delete;
+
+	segmented_stack(segmented_stack&& other) noexcept { steal_(other); }
+
+	segmented_stack& operator=(segmented_stack&& other) noexcept
+	{
+		if (this != &other)
+		{
+			release_();
+			steal_(other);
+		}
+		return *this;
+	}
+
+	~segmented_stack() { release_(); }
+
+	bool empty() const noexcept { return size_ == 0; }
+
+	size_t size() const noexcept { return size_; }
+
+	template <typename... Args>
+	void emplace(Args&&... args)
+	{
+		if (top_ != nullptr && top_count_ < ChunkSize)
+		{
+			new (top_->slot(top_count_)) T(std::forward<Args>(args)...);
+			++top_count_;
+			++size_;
+			return;
+		}
+
+		// текущий блок заполнен: берём запасной или выделяем новый.
+		// Старые элементы остаются на месте, поэтому args может ссылаться
+		// на вершину этого же стека
+		chunk* next = spare_ != nullptr ? spare_ : new chunk;
+		spare_ = nullptr;
+		try
+		{
+			new (next->slot(0)) T(std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			spare_ = next;
+			throw;
+		}
+
+		next->prev = top_;
+		top_ = next;
+		top_count_ = 1;
+		++size_;
+	}
+
+	// copy semantics (lvalue)
+	void push(const T& value) { emplace(value); }
+
+	// move semantics (rvalue)
+	void push(T&& value) { emplace(std::move(value)); }
+
+	void pop()
+	{
+		if (empty())
+			throw std::underflow_error("Stack is empty!");
+		--top_count_;
+		--size_;
+		top_->slot(top_count_)->~T();
+
+		if (top_count_ == 0 && top_->prev != nullptr)
+		{
+			// опустевший блок оставляем в запасе, чтобы push/pop на границе
+			// блоков не выделяли и не освобождали память каждый раз
+			delete spare_;
+			spare_ = top_;
+			top_ = top_->prev;
+			top_count_ = ChunkSize;
+		}
+	}
+
+	T& top()
+	{
+		if (empty())
+			throw std::underflow_error("Stack is empty!");
+		return *top_->slot(top_count_ - 1);
+	}
+
+	const T& top() const
+	{
+		if (empty())
+			throw std::underflow_error("Stack is empty!");
+		return *top_->slot(top_count_ - 1);
+	}
+
+	void clear() noexcept
+	{
+		while (top_ != nullptr)
+		{
+			for (size_t i = top_count_; i > 0; --i)
+			{
+				top_->slot(i - 1)->~T();
+			}
+			chunk* prev = top_->prev;
+			if (prev == nullptr)
+			{
+				// нижний блок оставляем под следующие push
+				top_count_ = 0;
+				break;
+			}
+			delete top_;
+			top_ = prev;
+			top_count_ = ChunkSize;
+		}
+		size_ = 0;
+	}
+
+   private:
+	struct chunk
+	{
+		T* slot(size_t index) noexcept
+		{
+			return std::launder(reinterpret_cast<T*>(storage)) + index;
+		}
+
+		const T* slot(size_t index) const noexcept
+		{
+			return std::launder(reinterpret_cast<const T*>(storage)) + index;
+		}
+
+		chunk* prev = nullptr;
+		alignas(T) unsigned char storage[sizeof(T) * ChunkSize];
+	};
+
+	void release_() noexcept
+	{
+		clear();
+		delete top_;
+		delete spare_;
+		top_ = nullptr;
+		spare_ = nullptr;
+	}
+
+	void steal_(segmented_stack& other) noexcept
+	{
+		top_ = std::exchange(other.top_, nullptr);
+		spare_ = std::exchange(other.spare_, nullptr);
+		top_count_ = std::exchange(other.top_count_, 0);
+		size_ = std::exchange(other.size_, 0);
+	}
+
+	chunk* top_ = nullptr;
+	chunk* spare_ = nullptr;
+	size_t top_count_ = 0;
+	size_t size_ = 0;
+};
+}  // namespace bmstu
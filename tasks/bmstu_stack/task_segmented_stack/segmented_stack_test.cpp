@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "bmstu_segmented_stack.h"
+
+namespace
+{
+struct LiveCounter
+{
+	LiveCounter(int v) : value(v) { ++alive; }
+	LiveCounter(const LiveCounter& other) : value(other.value) { ++alive; }
+	~LiveCounter() { --alive; }
+
+	int value;
+	static int alive;
+};
+
+int LiveCounter::alive = 0;
+
+struct ThrowOnConstruct
+{
+	ThrowOnConstruct(bool do_throw)
+	{
+		if (do_throw)
+		{
+			throw std::runtime_error("construct");
+		}
+	}
+};
+}  // namespace
+
+TEST(SegmentedStackTest, DefaultConstructor)
+{
+	bmstu::segmented_stack<int> s;
+	ASSERT_TRUE(s.empty());
+	ASSERT_EQ(s.size(), 0u);
+}
+
+TEST(SegmentedStackTest, PushPopAcrossChunks)
+{
+	bmstu::segmented_stack<int, 4> s;
+	for (int i = 0; i < 100; ++i)
+	{
+		s.push(i);
+		ASSERT_EQ(s.top(), i);
+	}
+	ASSERT_EQ(s.size(), 100u);
+
+	for (int i = 99; i >= 0; --i)
+	{
+		ASSERT_EQ(s.top(), i);
+		s.pop();
+	}
+	ASSERT_TRUE(s.empty());
+}
+
+TEST(SegmentedStackTest, ReferencesStayValid)
+{
+	bmstu::segmented_stack<std::string, 8> s;
+	s.push("bottom");
+	const std::string* bottom = &s.top();
+	std::vector<const std::string*> addresses;
+	for (int i = 0; i < 1000; ++i)
+	{
+		s.push(std::to_string(i));
+		addresses.push_back(&s.top());
+	}
+
+	ASSERT_EQ(*bottom, "bottom");
+	for (int i = 999; i >= 0; --i)
+	{
+		ASSERT_EQ(&s.top(), addresses[i]);
+		ASSERT_EQ(s.top(), std::to_string(i));
+		s.pop();
+	}
+	ASSERT_EQ(&s.top(), bottom);
+}
+
+TEST(SegmentedStackTest, ChunkBoundaryThrash)
+{
+	bmstu::segmented_stack<int, 2> s;
+	s.push(1);
+	s.push(2);
+	for (int i = 0; i < 100; ++i)
+	{
+		s.push(3);
+		ASSERT_EQ(s.size(), 3u);
+		s.pop();
+		ASSERT_EQ(s.top(), 2);
+	}
+}
+
+TEST(SegmentedStackTest, Emplace)
+{
+	bmstu::segmented_stack<std::pair<int, std::string>, 3> s;
+	s.emplace(1, "one");
+	s.emplace(2, "two");
+	ASSERT_EQ(s.top().first, 2);
+	ASSERT_EQ(s.top().second, "two");
+}
+
+TEST(SegmentedStackTest, PushOwnTop)
+{
+	bmstu::segmented_stack<std::string, 1> s;
+	s.push(std::string(64, 'a'));
+	for (int i = 0; i < 5; ++i)
+	{
+		s.push(s.top());
+	}
+	ASSERT_EQ(s.size(), 6u);
+	ASSERT_EQ(s.top(), std::string(64, 'a'));
+}
+
+TEST(SegmentedStackTest, DestroysAllElements)
+{
+	LiveCounter::alive = 0;
+	{
+		bmstu::segmented_stack<LiveCounter, 4> s;
+		for (int i = 0; i < 37; ++i)
+		{
+			s.emplace(i);
+		}
+		ASSERT_EQ(LiveCounter::alive, 37);
+		s.pop();
+		ASSERT_EQ(LiveCounter::alive, 36);
+		s.clear();
+		ASSERT_EQ(LiveCounter::alive, 0);
+		ASSERT_TRUE(s.empty());
+
+		for (int i = 0; i < 10; ++i)
+		{
+			s.emplace(i);
+		}
+		ASSERT_EQ(s.top().value, 9);
+	}
+	ASSERT_EQ(LiveCounter::alive, 0);
+}
+
+TEST(SegmentedStackTest, MoveConstructor)
+{
+	bmstu::segmented_stack<int, 4> s;
+	for (int i = 0; i < 10; ++i)
+	{
+		s.push(i);
+	}
+	const int* top = &s.top();
+
+	bmstu::segmented_stack<int, 4> moved(std::move(s));
+	ASSERT_TRUE(s.empty());
+	ASSERT_EQ(moved.size(), 10u);
+	ASSERT_EQ(&moved.top(), top);
+
+	s.push(42);
+	ASSERT_EQ(s.top(), 42);
+
+	s = std::move(moved);
+	ASSERT_EQ(s.size(), 10u);
+	ASSERT_EQ(s.top(), 9);
+}
+
+TEST(SegmentedStackTest, ExceptionKeepsStackIntact)
+{
+	bmstu::segmented_stack<ThrowOnConstruct, 2> s;
+	s.emplace(false);
+	s.emplace(false);
+	ASSERT_THROW(s.emplace(true), std::runtime_error);
+	ASSERT_EQ(s.size(), 2u);
+	s.emplace(false);
+	ASSERT_EQ(s.size(), 3u);
+}
+
+TEST(SegmentedStackTest, PopEmpty)
+{
+	bmstu::segmented_stack<int> s;
+	ASSERT_THROW(s.pop(), std::underflow_error);
+	ASSERT_THROW(s.top(), std::underflow_error);
+
+	const bmstu::segmented_stack<int>& const_ref = s;
+	ASSERT_THROW(const_ref.top(), std::underflow_error);
+}
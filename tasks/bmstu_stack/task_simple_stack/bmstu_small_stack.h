@@ -0,0 +1,344 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "bmstu_memory.h"
+#include "bmstu_stack.h"
+
+namespace bmstu
+{
+// Стек с буфером на N элементов внутри самого объекта, по аналогии с SSO в
+// bmstu::basic_string. Пока элементов не больше N, аллокатор не вызывается
+// вовсе; при переполнении элементы переносятся в динамический массив,
+// который растёт по политике Growth, как у bmstu::stack. Элементы и во
+// встроенном буфере, и в массиве создаются через Allocator.
+template <typename T,
+		  size_t N = 16,
+		  typename Growth = geometric_growth<>,
+		  typename Allocator = std::allocator<T>>
+class small_stack
+{
+	static_assert(N > 0, "inline capacity must be positive");
+
+	using alloc_traits = std::allocator_traits<Allocator>;
+
+   public:
+	using allocator_type = Allocator;
+
+	small_stack() noexcept(noexcept(Allocator())) : small_stack(Allocator())
+	{
+	}
+
+	explicit small_stack(const Allocator& alloc) noexcept
+		: alloc_(alloc), data_(inline_data_()), size_(0), capacity_(N)
+	{
+	}
+
+	small_stack(const small_stack& other)
+		: small_stack(other,
+					  alloc_traits::select_on_container_copy_construction(
+						  other.alloc_))
+	{
+	}
+
+	small_stack(const small_stack& other, const Allocator& alloc)
+		: small_stack(alloc)
+	{
+		reserve(other.size_);
+		for (size_t i = 0; i < other.size_; ++i)
+		{
+			alloc_traits::construct(alloc_, data_ + i, other.data_[i]);
+			++size_;
+		}
+	}
+
+	small_stack(small_stack&& other) noexcept(
+		is_trivially_relocatable_v<T> ||
+		std::is_nothrow_move_constructible_v<T>)
+		: small_stack(std::move(other.alloc_))
+	{
+		steal_(other);
+	}
+
+	small_stack& operator=(const small_stack& other)
+	{
+		if (this != &other)
+		{
+			constexpr bool propagate =
+				alloc_traits::propagate_on_container_copy_assignment::value;
+			small_stack copy(other, propagate ? other.alloc_ : alloc_);
+			clear();
+			if constexpr (propagate)
+			{
+				reset_to_inline_();
+				alloc_ = other.alloc_;
+			}
+			steal_(copy);
+		}
+		return *this;
+	}
+
+	small_stack& operator=(small_stack&& other) noexcept(
+		(alloc_traits::propagate_on_container_move_assignment::value ||
+		 alloc_traits::is_always_equal::value) &&
+		(is_trivially_relocatable_v<T> ||
+		 std::is_nothrow_move_constructible_v<T>))
+	{
+		if (this == &other)
+		{
+			return *this;
+		}
+		constexpr bool propagate =
+			alloc_traits::propagate_on_container_move_assignment::value;
+		clear();
+		if constexpr (propagate)
+		{
+			reset_to_inline_();
+			alloc_ = std::move(other.alloc_);
+			steal_(other);
+		}
+		else if (alloc_ == other.alloc_)
+		{
+			steal_(other);
+		}
+		else
+		{
+			// память other нельзя освободить нашим аллокатором: переносим
+			// элементы по одному
+			reserve(other.size_);
+			for (size_t i = 0; i < other.size_; ++i)
+			{
+				emplace(std::move(other.data_[i]));
+			}
+			other.clear();
+		}
+		return *this;
+	}
+
+	~small_stack()
+	{
+		clear();
+		release_heap_();
+	}
+
+	allocator_type get_allocator() const noexcept { return alloc_; }
+
+	bool empty() const noexcept { return size_ == 0; }
+
+	size_t size() const noexcept { return size_; }
+
+	size_t capacity() const noexcept { return capacity_; }
+
+	// true, пока элементы лежат во встроенном буфере
+	bool is_inline() const noexcept { return data_ == inline_data_(); }
+
+	template <typename... Args>
+	void emplace(Args&&... args)
+	{
+		if (size_ == capacity_)
+		{
+			emplace_with_growth_(std::forward<Args>(args)...);
+			return;
+		}
+
+		alloc_traits::construct(alloc_, data_ + size_,
+								std::forward<Args>(args)...);
+		++size_;
+	}
+
+	// copy semantics (lvalue)
+	void push(const T& value) { emplace(value); }
+
+	// move semantics (rvalue)
+	void push(T&& value) { emplace(std::move(value)); }
+
+	void reserve(size_t new_cap)
+	{
+		if (new_cap > capacity_)
+		{
+			relocate_to_heap_(new_cap);
+		}
+	}
+
+	// возвращает элементы во встроенный буфер, если они туда помещаются,
+	// иначе ужимает динамический массив до size
+	void shrink_to_fit()
+	{
+		if (is_inline() || capacity_ == size_)
+		{
+			return;
+		}
+		if (size_ <= N)
+		{
+			relocate_to_(inline_data_(), N);
+		}
+		else
+		{
+			relocate_to_heap_(size_);
+		}
+	}
+
+	void clear() noexcept
+	{
+		while (size_ > 0)
+		{
+			--size_;
+			alloc_traits::destroy(alloc_, data_ + size_);
+		}
+	}
+
+	void pop()
+	{
+		if (empty())
+			throw std::underflow_error("Stack is empty!");
+		--size_;
+		alloc_traits::destroy(alloc_, data_ + size_);
+	}
+
+	T& top()
+	{
+		if (empty())
+			throw std::underflow_error("Stack is empty!");
+		return data_[size_ - 1];
+	}
+
+	const T& top() const
+	{
+		if (empty())
+			throw std::underflow_error("Stack is empty!");
+		return data_[size_ - 1];
+	}
+
+   private:
+	template <typename... Args>
+	void emplace_with_growth_(Args&&... args)
+	{
+		size_t new_cap = Growth::next_capacity(capacity_, size_ + 1);
+		T* new_data = alloc_traits::allocate(alloc_, new_cap);
+
+		// args может ссылаться на элемент этого же стека, поэтому новый
+		// элемент создаётся до переноса старых
+		try
+		{
+			alloc_traits::construct(alloc_, new_data + size_,
+									std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			alloc_traits::deallocate(alloc_, new_data, new_cap);
+			throw;
+		}
+
+		try
+		{
+			relocate_to_(new_data, new_cap);
+		}
+		catch (...)
+		{
+			alloc_traits::destroy(alloc_, new_data + size_);
+			alloc_traits::deallocate(alloc_, new_data, new_cap);
+			throw;
+		}
+		++size_;
+	}
+
+	// переносит элементы в новый динамический массив на new_cap элементов
+	void relocate_to_heap_(size_t new_cap)
+	{
+		T* new_data = alloc_traits::allocate(alloc_, new_cap);
+		try
+		{
+			relocate_to_(new_data, new_cap);
+		}
+		catch (...)
+		{
+			alloc_traits::deallocate(alloc_, new_data, new_cap);
+			throw;
+		}
+	}
+
+	// переносит элементы в new_data и освобождает прежний массив, если он
+	// был в куче. Если перенос бросит, стек остаётся прежним, а new_data
+	// освобождает вызывающий
+	void relocate_to_(T* new_data, size_t new_cap)
+	{
+		uninitialized_relocate(alloc_, data_, size_, new_data);
+		release_heap_();
+		data_ = new_data;
+		capacity_ = new_cap;
+	}
+
+	void release_heap_() noexcept
+	{
+		if (!is_inline())
+		{
+			alloc_traits::deallocate(alloc_, data_, capacity_);
+		}
+	}
+
+	// пустой стек возвращается во встроенный буфер
+	void reset_to_inline_() noexcept
+	{
+		release_heap_();
+		data_ = inline_data_();
+		capacity_ = N;
+	}
+
+	// забирает элементы other; this должен быть пуст, аллокаторы к этому
+	// моменту должны совпадать. Динамический массив передаётся целиком,
+	// встроенный буфер приходится переносить поэлементно
+	void steal_(small_stack& other)
+	{
+		if (other.is_inline())
+		{
+			reset_to_inline_();
+			if constexpr (is_trivially_relocatable_v<T>)
+			{
+				uninitialized_relocate(alloc_, other.data_, other.size_, data_);
+				size_ = std::exchange(other.size_, 0);
+			}
+			else
+			{
+				// при исключении other остаётся нетронутым
+				for (size_t i = 0; i < other.size_; ++i)
+				{
+					T& source = other.data_[i];
+					alloc_traits::construct(alloc_, data_ + i,
+											std::move_if_noexcept(source));
+					++size_;
+				}
+				other.clear();
+			}
+			return;
+		}
+		release_heap_();
+		data_ = std::exchange(other.data_, other.inline_data_());
+		capacity_ = std::exchange(other.capacity_, N);
+		size_ = std::exchange(other.size_, 0);
+	}
+
+	T* inline_data_() noexcept { return reinterpret_cast<T*>(inline_); }
+
+	const T* inline_data_() const noexcept
+	{
+		return reinterpret_cast<const T*>(inline_);
+	}
+
+	[[no_unique_address]] Allocator alloc_;
+	T* data_;
+	size_t size_;
+	size_t capacity_;
+	alignas(T) unsigned char inline_[sizeof(T) * N];
+};
+
+namespace pmr
+{
+template <typename T, size_t N = 16, typename Growth = geometric_growth<>>
+using small_stack =
+	bmstu::small_stack<T, N, Growth, std::pmr::polymorphic_allocator<T>>;
+}  // namespace pmr
+}  // namespace bmstu
@@ -1,126 +1,156 @@
 #pragma once
 
+#include <cstddef>
 #include <exception>
 #include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
 #include <utility>
+#include "bmstu_memory.h"
 
 namespace bmstu
 {
-template <typename T>
+template <typename T,
+          typename Growth = geometric_growth<>,
+          typename Allocator = std::allocator<T>>
 class stack
 {
+  using alloc_traits = std::allocator_traits<Allocator>;
+
    public:
-  stack() : data_(nullptr), size_(0), capacity_(0) {}
+  using allocator_type = Allocator;
 
-  bool empty() const noexcept { return size_ == 0; }
+  stack() noexcept(noexcept(Allocator())) : stack(Allocator()) {}
 
-  size_t size() const noexcept { return size_; }
+  explicit stack(const Allocator& alloc) noexcept
+      : alloc_(alloc), data_(nullptr), size_(0), capacity_(0)
+  {
+  }
 
-  ~stack()
+  stack(const stack& other)
+      : stack(other,
+              alloc_traits::select_on_container_copy_construction(
+                  other.alloc_))
   {
-    clear();
-    ::operator delete(data_);
   }
 
-  template <typename... Args>
-  void emplace(Args&&... args)
+  stack(const stack& other, const Allocator& alloc) : stack(alloc)
   {
-    if (size_ == capacity_)
+    reserve(other.size_);
+    for (size_t i = 0; i < other.size_; ++i)
     {
-      // новая capacity
-      size_t new_cap = (capacity_ == 0) ? 1 : capacity_ + 1;
+      emplace(other.data_[i]);
+    }
+  }
 
-      // создание нового массива data
-      T* new_data = (T*)::operator new(new_cap * sizeof(T));
+  stack(stack&& other) noexcept
+      : alloc_(std::move(other.alloc_)),
+        data_(std::exchange(other.data_, nullptr)),
+        size_(std::exchange(other.size_, 0)),
+        capacity_(std::exchange(other.capacity_, 0))
+  {
+  }
 
-      // перемещение старых элементов
-      for (size_t i = 0; i < size_; ++i)
+  stack& operator=(const stack& other)
+  {
+    if (this != &other)
+    {
+      constexpr bool propagate =
+          alloc_traits::propagate_on_container_copy_assignment::value;
+      stack copy(other, propagate ? other.alloc_ : alloc_);
+      release_();
+      if constexpr (propagate)
       {
-        // копирование данных из старого объекта
-        new (new_data + i) T(std::move(data_[i]));
-
-        // вызываем деструктор класса T, чтобы удалить объект из старой
-        // data
-        (data_ + i)->~T();
+        alloc_ = other.alloc_;
       }
-
-      ::operator delete(data_);
-
-      data_ = new_data;
-      capacity_ = new_cap;
+      take_(copy);
     }
-
-    new (data_ + size_) T(std::forward<Args>(args)...);
-    ++size_;
+    return *this;
   }
 
-  // copy semantics (lvalue)
-  void push(const T& value)
+  stack& operator=(stack&& other) noexcept(
+      alloc_traits::propagate_on_container_move_assignment::value ||
+      alloc_traits::is_always_equal::value)
   {
-    if (size_ == capacity_)
+    if (this == &other)
     {
-      // новый capacity
-      size_t new_cap = (capacity_ == 0) ? 1 : capacity_ + 1;
-
-      // новый массив new_data
-      T* new_data = (T*)::operator new(new_cap * sizeof(T));
-
-      // перемещение старых элементов
-      for (size_t i = 0; i < size_; ++i)
+      return *this;
+    }
+    if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+    {
+      release_();
+      alloc_ = std::move(other.alloc_);
+      take_(other);
+    }
+    else if (alloc_ == other.alloc_)
+    {
+      release_();
+      take_(other);
+    }
+    else
+    {
+      // память other нельзя освободить нашим аллокатором: переносим
+      // элементы по одному
+      stack moved(alloc_);
+      moved.reserve(other.size_);
+      for (size_t i = 0; i < other.size_; ++i)
       {
-        // копирование данных из старого объекта
-        new (new_data + i) T(std::move(data_[i]));
-
-        // вызываем деструктор класса T, чтобы удалить объект из старой
-        // data
-        (data_ + i)->~T();
+        moved.emplace(std::move(other.data_[i]));
       }
+      other.clear();
+      release_();
+      take_(moved);
+    }
+    return *this;
+  }
 
-      // очистка старого массива глупым методом ogo
-      ::operator delete(data_);
+  allocator_type get_allocator() const noexcept { return alloc_; }
 
-      data_ = new_data;
-      capacity_ = new_cap;
-    }
+  bool empty() const noexcept { return size_ == 0; }
 
-    // с помощью конструктора для типа Т присваиваем сырой памяти value
-    // (copy)
-    new (data_ + size_) T(value);
-    ++size_;
-  }
+  size_t size() const noexcept { return size_; }
 
-  // move semantics (rvalue)
-  void push(T&& value)
+  size_t capacity() const noexcept { return capacity_; }
+
+  ~stack() { release_(); }
+
+  template <typename... Args>
+  void emplace(Args&&... args)
   {
     if (size_ == capacity_)
     {
-      // новый capacity
-      size_t new_cap = (capacity_ == 0) ? 1 : capacity_ + 1;
-
-      // новый массив new_data
-      T* new_data = (T*)::operator new(new_cap * sizeof(T));
+      emplace_with_growth_(std::forward<Args>(args)...);
+      return;
+    }
 
-      // перемещение старых элементов
-      for (size_t i = 0; i < size_; ++i)
-      {
-        // копирование данных из старого объекта
-        new (new_data + i) T(std::move(data_[i]));
+    alloc_traits::construct(alloc_, data_ + size_, std::forward<Args>(args)...);
+    ++size_;
+  }
 
-        // вызываем деструктор класса T, чтобы удалить объект из старой
-        // data
-        (data_ + i)->~T();
-      }
+  // copy semantics (lvalue)
+  void push(const T& value) { emplace(value); }
 
-      // очистка старого массива глупым методом
-      ::operator delete(data_);
+  // move semantics (rvalue)
+  void push(T&& value) { emplace(std::move(value)); }
 
-      data_ = new_data;
-      capacity_ = new_cap;
+  // заранее выделяет память минимум под new_cap элементов
+  void reserve(size_t new_cap)
+  {
+    if (new_cap > capacity_)
+    {
+      reallocate_(new_cap);
     }
+  }
 
-    // с помощью move записываем новым элементом value
-    new (data_ + size_) T(std::move(value));
-    ++size_;
+  // отдаёт неиспользуемую память, capacity становится равной size
+  void shrink_to_fit()
+  {
+    if (capacity_ > size_)
+    {
+      reallocate_(size_);
+    }
   }
 
   void clear() noexcept
@@ -128,7 +158,7 @@ class stack
     while (size_ > 0)
     {
       --size_;
-      (data_ + size_)->~T();
+      alloc_traits::destroy(alloc_, data_ + size_);
     }
   }
 
@@ -137,7 +167,7 @@ class stack
     if (empty())
       throw std::underflow_error("Stack is empty!");
     --size_;
-    (data_ + size_)->~T();
+    alloc_traits::destroy(alloc_, data_ + size_);
   }
 
   T& top()
@@ -155,8 +185,102 @@ class stack
   }
 
    private:
+  template <typename... Args>
+  void emplace_with_growth_(Args&&... args)
+  {
+    size_t new_cap = Growth::next_capacity(capacity_, size_ + 1);
+    T* new_data = alloc_traits::allocate(alloc_, new_cap);
+
+    // новый элемент создаём до переноса старых: args может ссылаться на
+    // элемент этого же стека (например, s.push(s.top()))
+    try
+    {
+      alloc_traits::construct(alloc_, new_data + size_,
+                              std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+      alloc_traits::deallocate(alloc_, new_data, new_cap);
+      throw;
+    }
+
+    try
+    {
+      move_to_(new_data, new_cap);
+    }
+    catch (...)
+    {
+      alloc_traits::destroy(alloc_, new_data + size_);
+      alloc_traits::deallocate(alloc_, new_data, new_cap);
+      throw;
+    }
+    ++size_;
+  }
+
+  void reallocate_(size_t new_cap)
+  {
+    T* new_data = nullptr;
+    if (new_cap > 0)
+    {
+      new_data = alloc_traits::allocate(alloc_, new_cap);
+    }
+    try
+    {
+      move_to_(new_data, new_cap);
+    }
+    catch (...)
+    {
+      if (new_data != nullptr)
+      {
+        alloc_traits::deallocate(alloc_, new_data, new_cap);
+      }
+      throw;
+    }
+  }
+
+  // перемещает элементы в new_data и освобождает старый массив;
+  // для тривиально переносимых T это один memcpy вместо цикла. Если
+  // перенос бросит, стек остаётся прежним, а new_data освобождает
+  // вызывающий
+  void move_to_(T* new_data, size_t new_cap)
+  {
+    uninitialized_relocate(alloc_, data_, size_, new_data);
+    if (data_ != nullptr)
+    {
+      alloc_traits::deallocate(alloc_, data_, capacity_);
+    }
+    data_ = new_data;
+    capacity_ = new_cap;
+  }
+
+  void release_() noexcept
+  {
+    clear();
+    if (data_ != nullptr)
+    {
+      alloc_traits::deallocate(alloc_, data_, capacity_);
+    }
+    data_ = nullptr;
+    capacity_ = 0;
+  }
+
+  // забирает массив other; аллокаторы к этому моменту должны совпадать
+  void take_(stack& other) noexcept
+  {
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    capacity_ = std::exchange(other.capacity_, 0);
+  }
+
+  [[no_unique_address]] Allocator alloc_;
   T* data_;
   size_t size_;
   size_t capacity_;
 };
-}  // namespace bmstu
\ No newline at end of file
+
+namespace pmr
+{
+template <typename T, typename Growth = geometric_growth<>>
+using stack = bmstu::stack<T, Growth, std::pmr::polymorphic_allocator<T>>;
+}  // namespace pmr
+}  // namespace bmstu
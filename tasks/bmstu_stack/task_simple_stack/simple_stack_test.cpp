@@ -1,4 +1,6 @@
 #include <gtest/gtest.h>
+#include <memory_resource>
+#include <stdexcept>
 #include <string>
 #include "bmstu_stack.h"
 
@@ -325,3 +327,265 @@ TEST(StackTest, CheckBraceSequence)
 	ASSERT_FALSE(checkBraceSequence("())"));
 	ASSERT_FALSE(checkBraceSequence(")("));
 }
+
+TEST(StackTest, CapacityGrowsGeometrically)
+{
+	bmstu::stack<int> s;
+	ASSERT_EQ(s.capacity(), 0u);
+
+	size_t reallocations = 0;
+	size_t last_capacity = s.capacity();
+	for (int i = 0; i < 100000; ++i)
+	{
+		s.push(i);
+		if (s.capacity() != last_capacity)
+		{
+			++reallocations;
+			last_capacity = s.capacity();
+		}
+		ASSERT_GE(s.capacity(), s.size());
+	}
+	ASSERT_EQ(s.top(), 99999);
+	// 1.5x рост: порядка log_{1.5}(100000) ~ 30 перевыделений, а не 100000
+	ASSERT_LT(reallocations, 40u);
+}
+
+TEST(StackTest, FixedChunkGrowth)
+{
+	bmstu::stack<int, bmstu::fixed_chunk_growth<8>> s;
+	s.push(1);
+	ASSERT_EQ(s.capacity(), 8u);
+	for (int i = 0; i < 8; ++i)
+	{
+		s.push(i);
+	}
+	ASSERT_EQ(s.size(), 9u);
+	ASSERT_EQ(s.capacity(), 16u);
+}
+
+TEST(StackTest, DoublingGrowth)
+{
+	bmstu::stack<int, bmstu::geometric_growth<2, 1>> s;
+	for (int i = 0; i < 5; ++i)
+	{
+		s.push(i);
+	}
+	ASSERT_EQ(s.capacity(), 8u);
+}
+
+TEST(StackTest, Reserve)
+{
+	bmstu::stack<int> s;
+	s.reserve(100);
+	ASSERT_EQ(s.capacity(), 100u);
+	ASSERT_TRUE(s.empty());
+
+	s.push(0);
+	const int* first = &s.top();
+	for (int i = 1; i < 100; ++i)
+	{
+		s.push(i);
+	}
+	ASSERT_EQ(s.capacity(), 100u);
+	ASSERT_EQ(&s.top() - 99, first);
+
+	s.reserve(10);
+	ASSERT_EQ(s.capacity(), 100u);
+}
+
+TEST(StackTest, ReserveMovesElements)
+{
+	bmstu::stack<CountCopyMoveDefault> s;
+	s.emplace();
+	s.emplace();
+	CountCopyMoveDefault::reset_counters();
+
+	s.reserve(10);
+	ASSERT_EQ(s.size(), 2u);
+	ASSERT_EQ(CountCopyMoveDefault::move_constructor_count, 2);
+	ASSERT_EQ(CountCopyMoveDefault::copy_constructor_count, 0);
+}
+
+TEST(StackTest, ShrinkToFit)
+{
+	bmstu::stack<std::string> s;
+	for (int i = 0; i < 20; ++i)
+	{
+		s.push(std::to_string(i));
+	}
+	s.pop();
+	s.shrink_to_fit();
+	ASSERT_EQ(s.capacity(), 19u);
+	ASSERT_EQ(s.top(), "18");
+
+	s.clear();
+	s.shrink_to_fit();
+	ASSERT_EQ(s.capacity(), 0u);
+	s.push("again");
+	ASSERT_EQ(s.top(), "again");
+}
+
+TEST(StackTest, PushOwnElement)
+{
+	bmstu::stack<std::string> s;
+	s.push(std::string(100, 'x'));
+	for (int i = 0; i < 10; ++i)
+	{
+		// при росте аргумент ссылается на старый буфер стека
+		s.push(s.top());
+	}
+	ASSERT_EQ(s.size(), 11u);
+	ASSERT_EQ(s.top(), std::string(100, 'x'));
+}
+
+struct RelocatableCounter
+{
+	RelocatableCounter(int v) : value(v) {}
+	RelocatableCounter(const RelocatableCounter& other) : value(other.value)
+	{
+		++copies;
+	}
+	RelocatableCounter(RelocatableCounter&& other) noexcept
+		: value(other.value)
+	{
+		++moves;
+	}
+
+	int value;
+	static int copies;
+	static int moves;
+};
+
+int RelocatableCounter::copies = 0;
+int RelocatableCounter::moves = 0;
+
+template <>
+struct bmstu::is_trivially_relocatable<RelocatableCounter> : std::true_type
+{
+};
+
+TEST(StackTest, TriviallyRelocatableGrowth)
+{
+	bmstu::stack<RelocatableCounter> s;
+	RelocatableCounter::copies = 0;
+	RelocatableCounter::moves = 0;
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		s.emplace(i);
+	}
+	s.shrink_to_fit();
+
+	// перевыделения переносят буфер memcpy, конструкторы не вызываются
+	ASSERT_EQ(RelocatableCounter::moves, 0);
+	ASSERT_EQ(RelocatableCounter::copies, 0);
+	ASSERT_EQ(s.top().value, 999);
+	for (int i = 999; i >= 0; --i)
+	{
+		ASSERT_EQ(s.top().value, i);
+		s.pop();
+	}
+}
+
+TEST(StackTest, PmrMonotonicBuffer)
+{
+	// вышестоящий ресурс запрещает выделения: всё должно уместиться в буфер
+	std::byte buffer[16 * 1024];
+	std::pmr::monotonic_buffer_resource arena(
+		buffer, sizeof(buffer), std::pmr::null_memory_resource());
+
+	bmstu::pmr::stack<std::pmr::string> s(&arena);
+	for (int i = 0; i < 20; ++i)
+	{
+		s.push(std::pmr::string(40, static_cast<char>('a' + i)));
+	}
+	ASSERT_EQ(s.get_allocator().resource(), &arena);
+	// элементы получают ресурс контейнера через uses-allocator
+	ASSERT_EQ(s.top().get_allocator().resource(), &arena);
+	ASSERT_EQ(s.top(), std::pmr::string(40, 'a' + 19));
+
+	bmstu::pmr::stack<std::pmr::string> copy(s, &arena);
+	ASSERT_EQ(copy.size(), 20u);
+	s.clear();
+	ASSERT_EQ(copy.top(), std::pmr::string(40, 'a' + 19));
+}
+
+// тип без перемещающего конструктора: при переносе копируется, и копия
+// с номером fail_at бросает исключение
+struct ThrowingCopy
+{
+	ThrowingCopy(int v) : value(v) { ++alive; }
+	ThrowingCopy(const ThrowingCopy& other) : value(other.value)
+	{
+		if (++copies == fail_at)
+		{
+			throw std::runtime_error("copy failed");
+		}
+		++alive;
+	}
+	~ThrowingCopy() { --alive; }
+
+	int value;
+	static int copies;
+	static int fail_at;
+	static int alive;
+};
+
+int ThrowingCopy::copies = 0;
+int ThrowingCopy::fail_at = 0;
+int ThrowingCopy::alive = 0;
+
+TEST(StackTest, ThrowingRelocationKeepsElements)
+{
+	ThrowingCopy::alive = 0;
+	{
+		bmstu::stack<ThrowingCopy> s;
+		s.reserve(3);
+		for (int i = 0; i < 3; ++i)
+		{
+			s.emplace(i);
+		}
+		ThrowingCopy::copies = 0;
+		ThrowingCopy::fail_at = 3;
+		// рост и reserve бросают на третьей копии: стек не меняется
+		ASSERT_THROW(s.emplace(3), std::runtime_error);
+		ThrowingCopy::copies = 0;
+		ASSERT_THROW(s.reserve(10), std::runtime_error);
+		ASSERT_EQ(s.size(), 3u);
+		ASSERT_EQ(s.capacity(), 3u);
+		ASSERT_EQ(ThrowingCopy::alive, 3);
+
+		ThrowingCopy::fail_at = 0;
+		s.emplace(3);
+		for (int i = 3; i >= 0; --i)
+		{
+			ASSERT_EQ(s.top().value, i);
+			s.pop();
+		}
+	}
+	ASSERT_EQ(ThrowingCopy::alive, 0);
+}
+
+TEST(StackTest, CopyAndMove)
+{
+	bmstu::stack<std::string> s;
+	s.push("one");
+	s.push("two");
+
+	bmstu::stack<std::string> copy(s);
+	ASSERT_EQ(copy.size(), 2u);
+	ASSERT_EQ(copy.top(), "two");
+
+	bmstu::stack<std::string> moved(std::move(s));
+	ASSERT_TRUE(s.empty());
+	ASSERT_EQ(moved.top(), "two");
+
+	s = copy;
+	ASSERT_EQ(s.size(), 2u);
+	copy.pop();
+	ASSERT_EQ(s.top(), "two");
+
+	s = std::move(copy);
+	ASSERT_EQ(s.size(), 1u);
+	ASSERT_EQ(s.top(), "one");
+}
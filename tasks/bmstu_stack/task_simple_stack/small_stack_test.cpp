@@ -0,0 +1,284 @@
+#include <gtest/gtest.h>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include "bmstu_small_stack.h"
+
+namespace
+{
+// Считает выделения и передаёт их new_delete_resource: так проверяется, что
+// небольшой стек вообще не обращается к аллокатору.
+class counting_resource : public std::pmr::memory_resource
+{
+   public:
+	size_t allocations = 0;
+
+   private:
+	void* do_allocate(size_t bytes, size_t alignment) override
+	{
+		++allocations;
+		return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+	}
+
+	void do_deallocate(void* ptr, size_t bytes, size_t alignment) override
+	{
+		std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+	}
+
+	bool do_is_equal(const memory_resource& other) const noexcept override
+	{
+		return this == &other;
+	}
+};
+
+struct SmallCounter
+{
+	SmallCounter(int v) : value(v) { ++alive; }
+	SmallCounter(const SmallCounter& other) : value(other.value) { ++alive; }
+	SmallCounter(SmallCounter&& other) noexcept : value(other.value)
+	{
+		++alive;
+	}
+	~SmallCounter() { --alive; }
+
+	int value;
+	static int alive;
+};
+
+int SmallCounter::alive = 0;
+
+// без перемещающего конструктора: переносится копированием, копия с
+// номером fail_at бросает исключение
+struct ThrowingCopy
+{
+	ThrowingCopy(int v) : value(v) { ++alive; }
+	ThrowingCopy(const ThrowingCopy& other) : value(other.value)
+	{
+		if (++copies == fail_at)
+		{
+			throw std::runtime_error("copy failed");
+		}
+		++alive;
+	}
+	~ThrowingCopy() { --alive; }
+
+	int value;
+	static int copies;
+	static int fail_at;
+	static int alive;
+};
+
+int ThrowingCopy::copies = 0;
+int ThrowingCopy::fail_at = 0;
+int ThrowingCopy::alive = 0;
+}  // namespace
+
+TEST(SmallStackTest, DefaultConstructor)
+{
+	bmstu::small_stack<int, 8> s;
+	ASSERT_TRUE(s.empty());
+	ASSERT_EQ(s.size(), 0u);
+	ASSERT_EQ(s.capacity(), 8u);
+	ASSERT_TRUE(s.is_inline());
+}
+
+TEST(SmallStackTest, NoHeapAllocationsWithinInlineCapacity)
+{
+	counting_resource resource;
+	{
+		bmstu::pmr::small_stack<int, 16> s(&resource);
+		for (int i = 0; i < 16; ++i)
+		{
+			s.push(i);
+		}
+		while (!s.empty())
+		{
+			s.pop();
+		}
+	}
+	ASSERT_EQ(resource.allocations, 0u);
+
+	bmstu::pmr::small_stack<int, 16> s(&resource);
+	for (int i = 0; i < 17; ++i)
+	{
+		s.push(i);
+	}
+	ASSERT_EQ(resource.allocations, 1u);
+}
+
+TEST(SmallStackTest, PmrElementsShareResource)
+{
+	counting_resource resource;
+	bmstu::pmr::small_stack<std::pmr::string, 2> s(&resource);
+	for (int i = 0; i < 3; ++i)
+	{
+		s.push(std::pmr::string(40, static_cast<char>('a' + i)));
+	}
+	ASSERT_FALSE(s.is_inline());
+	// элементы получают ресурс контейнера через uses-allocator
+	ASSERT_EQ(s.top().get_allocator().resource(), &resource);
+
+	// ресурсы разные: элементы переносятся по одному в ресурс приёмника
+	std::pmr::monotonic_buffer_resource arena;
+	bmstu::pmr::small_stack<std::pmr::string, 2> other(&arena);
+	other = std::move(s);
+	ASSERT_TRUE(s.empty());
+	ASSERT_EQ(other.size(), 3u);
+	ASSERT_EQ(other.top(), std::pmr::string(40, 'c'));
+	ASSERT_EQ(other.top().get_allocator().resource(), &arena);
+}
+
+TEST(SmallStackTest, SpillsToHeapAndBack)
+{
+	bmstu::small_stack<std::string, 4> s;
+	for (int i = 0; i < 4; ++i)
+	{
+		s.push(std::to_string(i));
+	}
+	ASSERT_TRUE(s.is_inline());
+
+	s.push("4");
+	ASSERT_FALSE(s.is_inline());
+	ASSERT_EQ(s.capacity(), 6u);
+	ASSERT_EQ(s.size(), 5u);
+
+	s.pop();
+	s.pop();
+	s.shrink_to_fit();
+	ASSERT_TRUE(s.is_inline());
+	ASSERT_EQ(s.capacity(), 4u);
+	for (int i = 2; i >= 0; --i)
+	{
+		ASSERT_EQ(s.top(), std::to_string(i));
+		s.pop();
+	}
+	ASSERT_TRUE(s.empty());
+}
+
+TEST(SmallStackTest, PushOwnTopOnSpill)
+{
+	bmstu::small_stack<std::string, 2> s;
+	s.push(std::string(64, 'a'));
+	for (int i = 0; i < 5; ++i)
+	{
+		s.push(s.top());
+	}
+	ASSERT_EQ(s.size(), 6u);
+	ASSERT_EQ(s.top(), std::string(64, 'a'));
+}
+
+TEST(SmallStackTest, Reserve)
+{
+	bmstu::small_stack<int, 4> s;
+	s.reserve(3);
+	ASSERT_TRUE(s.is_inline());
+	s.push(1);
+	s.reserve(100);
+	ASSERT_FALSE(s.is_inline());
+	ASSERT_EQ(s.capacity(), 100u);
+	ASSERT_EQ(s.top(), 1);
+}
+
+TEST(SmallStackTest, CopyAndMoveInline)
+{
+	bmstu::small_stack<std::string, 4> s;
+	s.push("a");
+	s.push("b");
+
+	bmstu::small_stack<std::string, 4> copy(s);
+	ASSERT_EQ(copy.size(), 2u);
+	ASSERT_EQ(copy.top(), "b");
+	ASSERT_TRUE(copy.is_inline());
+
+	bmstu::small_stack<std::string, 4> moved(std::move(s));
+	ASSERT_TRUE(s.empty());
+	ASSERT_EQ(moved.size(), 2u);
+	ASSERT_EQ(moved.top(), "b");
+	moved.pop();
+	ASSERT_EQ(moved.top(), "a");
+}
+
+TEST(SmallStackTest, MoveStealsHeapBuffer)
+{
+	bmstu::small_stack<int, 2> s;
+	for (int i = 0; i < 10; ++i)
+	{
+		s.push(i);
+	}
+	const int* top = &s.top();
+
+	bmstu::small_stack<int, 2> moved(std::move(s));
+	ASSERT_EQ(&moved.top(), top);
+	ASSERT_TRUE(s.empty());
+	ASSERT_TRUE(s.is_inline());
+
+	s.push(42);
+	ASSERT_EQ(s.top(), 42);
+
+	s = std::move(moved);
+	ASSERT_EQ(s.size(), 10u);
+	ASSERT_EQ(&s.top(), top);
+
+	bmstu::small_stack<int, 2> inline_stack;
+	inline_stack.push(7);
+	s = inline_stack;
+	ASSERT_TRUE(s.is_inline());
+	ASSERT_EQ(s.size(), 1u);
+	ASSERT_EQ(s.top(), 7);
+}
+
+TEST(SmallStackTest, DestroysAllElements)
+{
+	SmallCounter::alive = 0;
+	{
+		bmstu::small_stack<SmallCounter, 3> s;
+		for (int i = 0; i < 10; ++i)
+		{
+			s.emplace(i);
+		}
+		ASSERT_EQ(SmallCounter::alive, 10);
+		bmstu::small_stack<SmallCounter, 3> copy = s;
+		ASSERT_EQ(SmallCounter::alive, 20);
+		copy.clear();
+		ASSERT_EQ(SmallCounter::alive, 10);
+	}
+	ASSERT_EQ(SmallCounter::alive, 0);
+}
+
+TEST(SmallStackTest, ThrowingRelocationKeepsElements)
+{
+	ThrowingCopy::alive = 0;
+	{
+		bmstu::small_stack<ThrowingCopy, 3> s;
+		for (int i = 0; i < 3; ++i)
+		{
+			s.emplace(i);
+		}
+		ThrowingCopy::copies = 0;
+		ThrowingCopy::fail_at = 3;
+		// выход из встроенного буфера бросает на третьей копии
+		ASSERT_THROW(s.emplace(3), std::runtime_error);
+		ThrowingCopy::copies = 0;
+		ASSERT_THROW(s.reserve(10), std::runtime_error);
+		ASSERT_TRUE(s.is_inline());
+		ASSERT_EQ(s.size(), 3u);
+		ASSERT_EQ(ThrowingCopy::alive, 3);
+
+		ThrowingCopy::fail_at = 0;
+		s.emplace(3);
+		ASSERT_FALSE(s.is_inline());
+		for (int i = 3; i >= 0; --i)
+		{
+			ASSERT_EQ(s.top().value, i);
+			s.pop();
+		}
+	}
+	ASSERT_EQ(ThrowingCopy::alive, 0);
+}
+
+TEST(SmallStackTest, PopEmpty)
+{
+	bmstu::small_stack<int> s;
+	ASSERT_THROW(s.pop(), std::underflow_error);
+	ASSERT_THROW(s.top(), std::underflow_error);
+}
@@ -1,11 +1,21 @@
 #pragma once
 
+#include <algorithm>
+#include <cstring>
 #include <exception>
+#include <initializer_list>
 #include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "bmstu_memory.h"
 
 namespace bmstu
 {
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class basic_string;
 
 using string = basic_string<char>;
@@ -13,10 +23,12 @@ using wstring = basic_string<wchar_t>;
 using u16string = basic_string<char16_t>;
 using u32string = basic_string<char32_t>;
 
-template <typename T>
+template <typename T, typename Allocator>
 class basic_string
 {
    private:
+	using alloc_traits = std::allocator_traits<Allocator>;
+
 	static constexpr size_t SSO_CAPACITY =
 		(sizeof(T*) + sizeof(size_t) + sizeof(size_t)) / sizeof(T) - 1;
 
@@ -41,81 +53,345 @@ class basic_string
 
 	Data data_;
 	bool is_long_;
+	[[no_unique_address]] Allocator alloc_;
 
-	bool is_long() const { return false; }
+	bool is_long() const { return is_long_; }
 
-	T* get_ptr() { return nullptr; }
+	T* get_ptr()
+	{
+		return is_long_ ? data_.long_str.ptr : data_.short_str.buffer;
+	}
 
-	const T* get_ptr() const { return nullptr; }
+	const T* get_ptr() const
+	{
+		return is_long_ ? data_.long_str.ptr : data_.short_str.buffer;
+	}
 
-	size_t get_size() const { return 0; }
+	size_t get_size() const
+	{
+		return is_long_ ? data_.long_str.size : data_.short_str.size;
+	}
 
-	size_t get_capacity() const { return 0; }
+	size_t get_capacity() const
+	{
+		return is_long_ ? data_.long_str.capacity : SSO_CAPACITY;
+	}
 
    public:
-	basic_string() {}
+	using allocator_type = Allocator;
+
+	basic_string() noexcept(noexcept(Allocator())) : basic_string(Allocator())
+	{
+	}
+
+	explicit basic_string(const Allocator& alloc) noexcept : alloc_(alloc)
+	{
+		set_empty_();
+	}
+
+	basic_string(size_t size, const Allocator& alloc = Allocator())
+		: basic_string(alloc)
+	{
+		reserve_(size);
+		for (size_t i = 0; i < size; ++i)
+		{
+			get_ptr()[i] = ' ';
+		}
+		set_size_(size);
+	}
 
-	basic_string(size_t size) {}
+	basic_string(std::initializer_list<T> il,
+				 const Allocator& alloc = Allocator())
+		: basic_string(alloc)
+	{
+		assign_(il.begin(), il.size());
+	}
 
-	basic_string(std::initializer_list<T> il) {}
+	basic_string(const T* c_str, const Allocator& alloc = Allocator())
+		: basic_string(alloc)
+	{
+		if (c_str != nullptr)
+		{
+			assign_(c_str, strlen_(c_str));
+		}
+	}
 
-	basic_string(const T* c_str) {}
+	basic_string(const basic_string& other)
+		: basic_string(other,
+					   alloc_traits::select_on_container_copy_construction(
+						   other.alloc_))
+	{
+	}
 
-	basic_string(const basic_string& other) {}
+	basic_string(const basic_string& other, const Allocator& alloc)
+		: basic_string(alloc)
+	{
+		assign_(other.get_ptr(), other.get_size());
+	}
 
-	basic_string(basic_string&& dying) noexcept {}
+	basic_string(basic_string&& dying) noexcept
+		: data_(dying.data_),
+		  is_long_(dying.is_long_),
+		  alloc_(std::move(dying.alloc_))
+	{
+		dying.set_empty_();
+	}
 
-	~basic_string() {}
+	~basic_string() { clean_(); }
 
-	const T* c_str() const { return nullptr; }
+	allocator_type get_allocator() const noexcept { return alloc_; }
 
-	size_t size() const { return 0; }
+	const T* c_str() const { return get_ptr(); }
 
-	bool is_using_sso() const { return false; }
+	size_t size() const { return get_size(); }
 
-	size_t capacity() const { return 0; }
+	bool is_using_sso() const { return !is_long_; }
 
-	basic_string& operator=(basic_string&& other) noexcept { return *this; }
+	size_t capacity() const { return get_capacity(); }
 
-	basic_string& operator=(const T* c_str) { return *this; }
+	basic_string& operator=(basic_string&& other) noexcept(
+		alloc_traits::propagate_on_container_move_assignment::value ||
+		alloc_traits::is_always_equal::value)
+	{
+		if (this == &other)
+		{
+			return *this;
+		}
+		constexpr bool propagate =
+			alloc_traits::propagate_on_container_move_assignment::value;
+		if (!other.is_long_ || propagate || alloc_ == other.alloc_)
+		{
+			clean_();
+			if constexpr (propagate)
+			{
+				alloc_ = std::move(other.alloc_);
+			}
+			data_ = other.data_;
+			is_long_ = other.is_long_;
+		}
+		else
+		{
+			// буфер other нельзя освободить нашим аллокатором
+			assign_(other.get_ptr(), other.get_size());
+			other.clean_();
+		}
+		other.set_empty_();
+		return *this;
+	}
 
-	basic_string& operator=(const basic_string& other) { return *this; }
+	basic_string& operator=(const T* c_str)
+	{
+		set_size_(0);
+		if (c_str != nullptr)
+		{
+			assign_(c_str, strlen_(c_str));
+		}
+		return *this;
+	}
 
-	friend basic_string<T> operator+(const basic_string<T>& left,
-									 const basic_string<T>& right)
+	basic_string& operator=(const basic_string& other)
 	{
-		return {};
+		if (this == &other)
+		{
+			return *this;
+		}
+		constexpr bool propagate =
+			alloc_traits::propagate_on_container_copy_assignment::value;
+		if constexpr (propagate)
+		{
+			if (alloc_ != other.alloc_)
+			{
+				clean_();
+				set_empty_();
+			}
+			alloc_ = other.alloc_;
+		}
+		assign_(other.get_ptr(), other.get_size());
+		return *this;
+	}
+
+	friend basic_string<T, Allocator> operator+(
+		const basic_string<T, Allocator>& left,
+		const basic_string<T, Allocator>& right)
+	{
+		basic_string result(
+			alloc_traits::select_on_container_copy_construction(left.alloc_));
+		result.reserve_(left.size() + right.size());
+		result.append_(left.get_ptr(), left.size());
+		result.append_(right.get_ptr(), right.size());
+		return result;
 	}
 
 	template <typename S>
 	friend S& operator<<(S& os, const basic_string& obj)
 	{
+		os << obj.c_str();
 		return os;
 	}
 
+	// читает поток до конца, включая пробелы и переводы строк
 	template <typename S>
 	friend S& operator>>(S& is, basic_string& obj)
 	{
+		obj.set_size_(0);
+		T symbol;
+		while (is.get(symbol))
+		{
+			obj += symbol;
+		}
 		return is;
 	}
 
-	basic_string& operator+=(const basic_string& other) { return *this; }
+	basic_string& operator+=(const basic_string& other)
+	{
+		append_(other.get_ptr(), other.size());
+		return *this;
+	}
+
+	basic_string& operator+=(const T* c_str)
+	{
+		append_(c_str, strlen_(c_str));
+		return *this;
+	}
+
+	basic_string& operator+=(T symbol)
+	{
+		append_(&symbol, 1);
+		return *this;
+	}
 
-	basic_string& operator+=(T symbol) { return *this; }
+	T& operator[](size_t index) noexcept { return get_ptr()[index]; }
 
-	T& operator[](size_t index) noexcept
+	const T& operator[](size_t index) const noexcept
 	{
-		static T dummy;
-		return dummy;
+		return get_ptr()[index];
 	}
 
-	T& at(size_t index) { throw std::out_of_range("Wrong index"); }
+	T& at(size_t index)
+	{
+		if (index >= size())
+		{
+			throw std::out_of_range("Wrong index");
+		}
+		return get_ptr()[index];
+	}
 
-	T* data() { return nullptr; }
+	T* data() { return get_ptr(); }
 
    private:
-	static size_t strlen_(const T* str) { return 0; }
+	static size_t strlen_(const T* str)
+	{
+		size_t length = 0;
+		while (str[length] != T{})
+		{
+			++length;
+		}
+		return length;
+	}
 
-	void clean_() {}
+	void set_empty_() noexcept
+	{
+		is_long_ = false;
+		data_.short_str.buffer[0] = T{};
+		data_.short_str.size = 0;
+	}
+
+	void set_size_(size_t size) noexcept
+	{
+		if (is_long_)
+		{
+			data_.long_str.size = size;
+		}
+		else
+		{
+			data_.short_str.size = static_cast<unsigned char>(size);
+		}
+		get_ptr()[size] = T{};
+	}
+
+	// гарантирует место под capacity символов и завершающий ноль
+	void reserve_(size_t capacity)
+	{
+		if (capacity <= get_capacity())
+		{
+			return;
+		}
+		T* ptr = alloc_traits::allocate(alloc_, capacity + 1);
+		size_t size = get_size();
+		std::memcpy(ptr, get_ptr(), (size + 1) * sizeof(T));
+		clean_();
+		is_long_ = true;
+		data_.long_str = {ptr, size, capacity};
+	}
+
+	// src может указывать внутрь этой же строки: старый буфер освобождается
+	// только после копирования
+	void append_(const T* src, size_t count)
+	{
+		size_t size = get_size();
+		if (size + count <= get_capacity())
+		{
+			std::memmove(get_ptr() + size, src, count * sizeof(T));
+			set_size_(size + count);
+			return;
+		}
+
+		size_t capacity = std::max(size + count, get_capacity() * 2);
+		T* ptr = alloc_traits::allocate(alloc_, capacity + 1);
+		std::memcpy(ptr, get_ptr(), size * sizeof(T));
+		std::memcpy(ptr + size, src, count * sizeof(T));
+		clean_();
+		is_long_ = true;
+		data_.long_str = {ptr, size, capacity};
+		set_size_(size + count);
+	}
+
+	// src может указывать внутрь этой же строки, как и в append_
+	void assign_(const T* src, size_t count)
+	{
+		if (count <= get_capacity())
+		{
+			std::char_traits<T>::move(get_ptr(), src, count);
+			set_size_(count);
+			return;
+		}
+		T* ptr = alloc_traits::allocate(alloc_, count + 1);
+		std::char_traits<T>::copy(ptr, src, count);
+		clean_();
+		is_long_ = true;
+		data_.long_str = {ptr, count, count};
+		set_size_(count);
+	}
+
+	// освобождает длинный буфер; после вызова строку нужно переинициализировать
+	void clean_()
+	{
+		if (is_long_)
+		{
+			alloc_traits::deallocate(alloc_, data_.long_str.ptr,
+									 data_.long_str.capacity + 1);
+			is_long_ = false;
+		}
+	}
 };
-}  // namespace bmstu
\ No newline at end of file
+
+// Короткая строка хранится в самом объекте, но адресуется через is_long_,
+// а не через указатель на собственный буфер, поэтому basic_string можно
+// переносить побайтовым копированием, если это позволяет аллокатор.
+template <typename T, typename Allocator>
+struct is_trivially_relocatable<basic_string<T, Allocator>>
+	: std::bool_constant<std::is_empty_v<Allocator> ||
+						 is_trivially_relocatable_v<Allocator>>
+{
+};
+
+namespace pmr
+{
+template <typename T>
+using basic_string =
+	bmstu::basic_string<T, std::pmr::polymorphic_allocator<T>>;
+
+using string = basic_string<char>;
+using wstring = basic_string<wchar_t>;
+}  // namespace pmr
+}  // namespace bmstu
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <memory_resource>
 
 #include <sstream>
 #include "bmstu_sso_string.h"
@@ -376,3 +377,38 @@ TEST(SSOStringTest, SSOCapacity)
 	ASSERT_FALSE(long_str.is_using_sso());
 	ASSERT_GE(long_str.capacity(), long_str.size());
 }
+
+TEST(SSOStringTest, TriviallyRelocatable)
+{
+	ASSERT_TRUE(bmstu::is_trivially_relocatable_v<bmstu::string>);
+	ASSERT_TRUE(bmstu::is_trivially_relocatable_v<bmstu::wstring>);
+}
+
+TEST(SSOStringTest, PmrMonotonicBuffer)
+{
+	// вышестоящий ресурс запрещает выделения: всё должно уместиться в буфер
+	std::byte buffer[4 * 1024];
+	std::pmr::monotonic_buffer_resource arena(
+		buffer, sizeof(buffer), std::pmr::null_memory_resource());
+
+	bmstu::pmr::string str("short", &arena);
+	ASSERT_TRUE(str.is_using_sso());
+	str += " string that becomes very long";
+	ASSERT_FALSE(str.is_using_sso());
+	ASSERT_EQ(str.get_allocator().resource(), &arena);
+	ASSERT_STREQ(str.c_str(), "short string that becomes very long");
+
+	bmstu::pmr::string sum = str + str;
+	ASSERT_EQ(sum.get_allocator().resource(),
+			  std::pmr::get_default_resource());
+	ASSERT_EQ(sum.size(), 2 * str.size());
+}
+
+TEST(SSOStringTest, AppendSelf)
+{
+	bmstu::string str("0123456789");
+	str += str;
+	str += str;
+	ASSERT_STREQ(str.c_str(), "0123456789012345678901234567890123456789");
+	ASSERT_THROW(str.at(40), std::out_of_range);
+}